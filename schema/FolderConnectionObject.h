@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#pragma once
+
+#ifndef FOLDERCONNECTIONOBJECT_H
+#define FOLDERCONNECTIONOBJECT_H
+
+#include "MAPISchema.h"
+
+namespace graphql::mapi::object {
+namespace methods::FolderConnectionHas {
+
+template <class TImpl>
+concept getEdgesWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<FolderEdge>>> { impl.getEdges(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getEdges = requires (TImpl impl)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<FolderEdge>>> { impl.getEdges() } };
+};
+
+template <class TImpl>
+concept getPageInfoWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableObject<std::shared_ptr<PageInfo>> { impl.getPageInfo(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getPageInfo = requires (TImpl impl)
+{
+	{ service::AwaitableObject<std::shared_ptr<PageInfo>> { impl.getPageInfo() } };
+};
+
+template <class TImpl>
+concept getTotalCountWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<int> { impl.getTotalCount(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getTotalCount = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<int> { impl.getTotalCount() } };
+};
+
+template <class TImpl>
+concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.beginSelectionSet(params) };
+};
+
+template <class TImpl>
+concept endSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.endSelectionSet(params) };
+};
+
+} // namespace methods::FolderConnectionHas
+
+class [[nodiscard("unnecessary construction")]] FolderConnection final
+	: public service::Object
+{
+private:
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveEdges(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolvePageInfo(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveTotalCount(service::ResolverParams&& params) const;
+
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
+
+	struct [[nodiscard("unnecessary construction")]] Concept
+	{
+		virtual ~Concept() = default;
+
+		virtual void beginSelectionSet(const service::SelectionSetParams& params) const = 0;
+		virtual void endSelectionSet(const service::SelectionSetParams& params) const = 0;
+
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<FolderEdge>>> getEdges(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<PageInfo>> getPageInfo(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<int> getTotalCount(service::FieldParams&& params) const = 0;
+	};
+
+	template <class T>
+	struct [[nodiscard("unnecessary construction")]] Model final
+		: Concept
+	{
+		explicit Model(std::shared_ptr<T> pimpl) noexcept
+			: _pimpl { std::move(pimpl) }
+		{
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<FolderEdge>>> getEdges(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::FolderConnectionHas::getEdgesWithParams<T>)
+			{
+				return { _pimpl->getEdges(std::move(params)) };
+			}
+			else if constexpr (methods::FolderConnectionHas::getEdges<T>)
+			{
+				return { _pimpl->getEdges() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(FolderConnection::getEdges)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<PageInfo>> getPageInfo(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::FolderConnectionHas::getPageInfoWithParams<T>)
+			{
+				return { _pimpl->getPageInfo(std::move(params)) };
+			}
+			else if constexpr (methods::FolderConnectionHas::getPageInfo<T>)
+			{
+				return { _pimpl->getPageInfo() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(FolderConnection::getPageInfo)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<int> getTotalCount(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::FolderConnectionHas::getTotalCountWithParams<T>)
+			{
+				return { _pimpl->getTotalCount(std::move(params)) };
+			}
+			else if constexpr (methods::FolderConnectionHas::getTotalCount<T>)
+			{
+				return { _pimpl->getTotalCount() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(FolderConnection::getTotalCount)ex");
+			}
+		}
+
+		void beginSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::FolderConnectionHas::beginSelectionSet<T>)
+			{
+				_pimpl->beginSelectionSet(params);
+			}
+		}
+
+		void endSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::FolderConnectionHas::endSelectionSet<T>)
+			{
+				_pimpl->endSelectionSet(params);
+			}
+		}
+
+	private:
+		const std::shared_ptr<T> _pimpl;
+	};
+
+	explicit FolderConnection(std::unique_ptr<const Concept> pimpl) noexcept;
+
+	[[nodiscard("unnecessary call")]] service::TypeNames getTypeNames() const noexcept;
+	[[nodiscard("unnecessary call")]] service::ResolverMap getResolvers() const noexcept;
+
+	void beginSelectionSet(const service::SelectionSetParams& params) const override;
+	void endSelectionSet(const service::SelectionSetParams& params) const override;
+
+	const std::unique_ptr<const Concept> _pimpl;
+
+public:
+	template <class T>
+	explicit FolderConnection(std::shared_ptr<T> pimpl) noexcept
+		: FolderConnection { std::unique_ptr<const Concept> { std::make_unique<Model<T>>(std::move(pimpl)) } }
+	{
+	}
+
+	[[nodiscard("unnecessary call")]] static constexpr std::string_view getObjectType() noexcept
+	{
+		return { R"gql(FolderConnection)gql" };
+	}
+};
+
+} // namespace graphql::mapi::object
+
+#endif // FOLDERCONNECTIONOBJECT_H
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#include "FolderEdgeObject.h"
+#include "FolderObject.h"
+
+#include "graphqlservice/internal/Schema.h"
+
+#include "graphqlservice/introspection/IntrospectionSchema.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std::literals;
+
+namespace graphql::mapi {
+namespace object {
+
+FolderEdge::FolderEdge(std::unique_ptr<const Concept> pimpl) noexcept
+	: service::Object{ getTypeNames(), getResolvers() }
+	, _pimpl { std::move(pimpl) }
+{
+}
+
+service::TypeNames FolderEdge::getTypeNames() const noexcept
+{
+	return {
+		R"gql(FolderEdge)gql"sv
+	};
+}
+
+service::ResolverMap FolderEdge::getResolvers() const noexcept
+{
+	return {
+		{ R"gql(node)gql"sv, [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
+		{ R"gql(cursor)gql"sv, [this](service::ResolverParams&& params) { return resolveCursor(std::move(params)); } },
+		{ R"gql(__typename)gql"sv, [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } }
+	};
+}
+
+void FolderEdge::beginSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->beginSelectionSet(params);
+}
+
+void FolderEdge::endSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->endSelectionSet(params);
+}
+
+service::AwaitableResolver FolderEdge::resolveCursor(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getCursor(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<response::IdType>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver FolderEdge::resolveNode(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getNode(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<Folder>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver FolderEdge::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::Result<std::string>::convert(std::string{ R"gql(FolderEdge)gql" }, std::move(params));
+}
+
+} // namespace object
+
+void AddFolderEdgeDetails(const std::shared_ptr<schema::ObjectType>& typeFolderEdge, const std::shared_ptr<schema::Schema>& schema)
+{
+	typeFolderEdge->AddFields({
+		schema::Field::Make(R"gql(cursor)gql"sv, R"md(Opaque cursor which can be passed as `after` to continue after this element)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))),
+		schema::Field::Make(R"gql(node)gql"sv, R"md(Folder at this position in the page)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Folder)gql"sv)))
+	});
+}
+
+} // namespace graphql::mapi
@@ -7,8 +7,11 @@
 #include "FolderObject.h"
 #include "StoreObject.h"
 #include "PropertyObject.h"
+#include "FolderConnectionObject.h"
 #include "ConversationObject.h"
 #include "ItemObject.h"
+#include "ItemConnectionObject.h"
+#include "ItemGroupObject.h"
 
 #include "graphqlservice/internal/Schema.h"
 
@@ -49,10 +52,13 @@ service::ResolverMap Folder::getResolvers() const noexcept
 		{ R"gql(unread)gql"sv, [this](service::ResolverParams&& params) { return resolveUnread(std::move(params)); } },
 		{ R"gql(columns)gql"sv, [this](service::ResolverParams&& params) { return resolveColumns(std::move(params)); } },
 		{ R"gql(__typename)gql"sv, [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } },
+		{ R"gql(itemGroups)gql"sv, [this](service::ResolverParams&& params) { return resolveItemGroups(std::move(params)); } },
 		{ R"gql(subFolders)gql"sv, [this](service::ResolverParams&& params) { return resolveSubFolders(std::move(params)); } },
 		{ R"gql(parentFolder)gql"sv, [this](service::ResolverParams&& params) { return resolveParentFolder(std::move(params)); } },
 		{ R"gql(conversations)gql"sv, [this](service::ResolverParams&& params) { return resolveConversations(std::move(params)); } },
-		{ R"gql(specialFolder)gql"sv, [this](service::ResolverParams&& params) { return resolveSpecialFolder(std::move(params)); } }
+		{ R"gql(specialFolder)gql"sv, [this](service::ResolverParams&& params) { return resolveSpecialFolder(std::move(params)); } },
+		{ R"gql(itemsConnection)gql"sv, [this](service::ResolverParams&& params) { return resolveItemsConnection(std::move(params)); } },
+		{ R"gql(subFoldersConnection)gql"sv, [this](service::ResolverParams&& params) { return resolveSubFoldersConnection(std::move(params)); } }
 	};
 }
 
@@ -166,6 +172,18 @@ service::AwaitableResolver Folder::resolveSubFolders(service::ResolverParams&& p
 	return service::ModifiedResult<Folder>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
+service::AwaitableResolver Folder::resolveSubFoldersConnection(service::ResolverParams&& params) const
+{
+	auto argAfter = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getSubFoldersConnection(service::FieldParams { std::move(selectionSetParams), std::move(directives) }, std::move(argAfter));
+	resolverLock.unlock();
+
+	return service::ModifiedResult<FolderConnection>::convert(std::move(result), std::move(params));
+}
+
 service::AwaitableResolver Folder::resolveConversations(service::ResolverParams&& params) const
 {
 	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::Nullable, service::TypeModifier::List>("ids", params.arguments);
@@ -190,6 +208,30 @@ service::AwaitableResolver Folder::resolveItems(service::ResolverParams&& params
 	return service::ModifiedResult<Item>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
+service::AwaitableResolver Folder::resolveItemsConnection(service::ResolverParams&& params) const
+{
+	auto argAfter = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getItemsConnection(service::FieldParams { std::move(selectionSetParams), std::move(directives) }, std::move(argAfter));
+	resolverLock.unlock();
+
+	return service::ModifiedResult<ItemConnection>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver Folder::resolveItemGroups(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::Nullable, service::TypeModifier::List>("ids", params.arguments);
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getItemGroups(service::FieldParams { std::move(selectionSetParams), std::move(directives) }, std::move(argIds));
+	resolverLock.unlock();
+
+	return service::ModifiedResult<ItemGroup>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
+}
+
 service::AwaitableResolver Folder::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::Result<std::string>::convert(std::string{ R"gql(Folder)gql" }, std::move(params));
@@ -211,11 +253,20 @@ void AddFolderDetails(const std::shared_ptr<schema::ObjectType>& typeFolder, con
 		schema::Field::Make(R"gql(subFolders)gql"sv, R"md(List of sub-folders under this folder in the hierarchy)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Folder)gql"sv)))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of sub-folder IDs, return all immdediate sub-folders if `null`)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
 		}),
+		schema::Field::Make(R"gql(subFoldersConnection)gql"sv, R"md(Page through the sub-folders under this folder, use `@take` to set the page size)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(FolderConnection)gql"sv)), {
+			schema::InputValue::Make(R"gql(after)gql"sv, R"md(Cursor from `PageInfo.endCursor` on the previous page, start at the beginning if `null`)md"sv, schema->LookupType(R"gql(ID)gql"sv), R"gql(null)gql"sv)
+		}),
 		schema::Field::Make(R"gql(conversations)gql"sv, R"md(List of items grouped into conversations in this folder)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Conversation)gql"sv)))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of conversation IDs, return all conversation if `null`)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
 		}),
 		schema::Field::Make(R"gql(items)gql"sv, R"md(List of items in this folder)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Item)gql"sv)))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of item IDs, return all items if `null`)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
+		}),
+		schema::Field::Make(R"gql(itemsConnection)gql"sv, R"md(Page through the items in this folder, use `@take` to set the page size)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ItemConnection)gql"sv)), {
+			schema::InputValue::Make(R"gql(after)gql"sv, R"md(Cursor from `PageInfo.endCursor` on the previous page, start at the beginning if `null`)md"sv, schema->LookupType(R"gql(ID)gql"sv), R"gql(null)gql"sv)
+		}),
+		schema::Field::Make(R"gql(itemGroups)gql"sv, R"md(Category headings for the items in this folder, this requires `@groupBy`)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ItemGroup)gql"sv)))), {
+			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of category heading IDs from an earlier query with the same `@groupBy`, only return the headings in the `@offset` and `@take` window which match these IDs)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
 		})
 	});
 }
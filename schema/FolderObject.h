@@ -121,6 +121,18 @@ concept getSubFolders = requires (TImpl impl, std::optional<std::vector<response
 	{ service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> { impl.getSubFolders(std::move(idsArg)) } };
 };
 
+template <class TImpl>
+concept getSubFoldersConnectionWithParams = requires (TImpl impl, service::FieldParams params, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<FolderConnection>> { impl.getSubFoldersConnection(std::move(params), std::move(afterArg)) } };
+};
+
+template <class TImpl>
+concept getSubFoldersConnection = requires (TImpl impl, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<FolderConnection>> { impl.getSubFoldersConnection(std::move(afterArg)) } };
+};
+
 template <class TImpl>
 concept getConversationsWithParams = requires (TImpl impl, service::FieldParams params, std::optional<std::vector<response::IdType>> idsArg)
 {
@@ -145,6 +157,30 @@ concept getItems = requires (TImpl impl, std::optional<std::vector<response::IdT
 	{ service::AwaitableObject<std::vector<std::shared_ptr<Item>>> { impl.getItems(std::move(idsArg)) } };
 };
 
+template <class TImpl>
+concept getItemsConnectionWithParams = requires (TImpl impl, service::FieldParams params, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<ItemConnection>> { impl.getItemsConnection(std::move(params), std::move(afterArg)) } };
+};
+
+template <class TImpl>
+concept getItemsConnection = requires (TImpl impl, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<ItemConnection>> { impl.getItemsConnection(std::move(afterArg)) } };
+};
+
+template <class TImpl>
+concept getItemGroupsWithParams = requires (TImpl impl, service::FieldParams params, std::optional<std::vector<response::IdType>> idsArg)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<ItemGroup>>> { impl.getItemGroups(std::move(params), std::move(idsArg)) } };
+};
+
+template <class TImpl>
+concept getItemGroups = requires (TImpl impl, std::optional<std::vector<response::IdType>> idsArg)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<ItemGroup>>> { impl.getItemGroups(std::move(idsArg)) } };
+};
+
 template <class TImpl>
 concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
 {
@@ -172,8 +208,11 @@ private:
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveSpecialFolder(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveColumns(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveSubFolders(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveSubFoldersConnection(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveConversations(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItems(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItemsConnection(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItemGroups(service::ResolverParams&& params) const;
 
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
 
@@ -193,8 +232,11 @@ private:
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<std::optional<SpecialFolder>> getSpecialFolder(service::FieldParams&& params) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Property>>> getColumns(service::FieldParams&& params) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> getSubFolders(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<FolderConnection>> getSubFoldersConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Conversation>>> getConversations(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Item>>> getItems(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<ItemConnection>> getItemsConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<ItemGroup>>> getItemGroups(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
 	};
 
 	template <class T>
@@ -350,6 +392,22 @@ private:
 			}
 		}
 
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<FolderConnection>> getSubFoldersConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const override
+		{
+			if constexpr (methods::FolderHas::getSubFoldersConnectionWithParams<T>)
+			{
+				return { _pimpl->getSubFoldersConnection(std::move(params), std::move(afterArg)) };
+			}
+			else if constexpr (methods::FolderHas::getSubFoldersConnection<T>)
+			{
+				return { _pimpl->getSubFoldersConnection(std::move(afterArg)) };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(Folder::getSubFoldersConnection)ex");
+			}
+		}
+
 		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<Conversation>>> getConversations(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const override
 		{
 			if constexpr (methods::FolderHas::getConversationsWithParams<T>)
@@ -382,6 +440,38 @@ private:
 			}
 		}
 
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<ItemConnection>> getItemsConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const override
+		{
+			if constexpr (methods::FolderHas::getItemsConnectionWithParams<T>)
+			{
+				return { _pimpl->getItemsConnection(std::move(params), std::move(afterArg)) };
+			}
+			else if constexpr (methods::FolderHas::getItemsConnection<T>)
+			{
+				return { _pimpl->getItemsConnection(std::move(afterArg)) };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(Folder::getItemsConnection)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<ItemGroup>>> getItemGroups(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const override
+		{
+			if constexpr (methods::FolderHas::getItemGroupsWithParams<T>)
+			{
+				return { _pimpl->getItemGroups(std::move(params), std::move(idsArg)) };
+			}
+			else if constexpr (methods::FolderHas::getItemGroups<T>)
+			{
+				return { _pimpl->getItemGroups(std::move(idsArg)) };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(Folder::getItemGroups)ex");
+			}
+		}
+
 		void beginSelectionSet(const service::SelectionSetParams& params) const override
 		{
 			if constexpr (methods::FolderHas::beginSelectionSet<T>)
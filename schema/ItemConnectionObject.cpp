@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#include "ItemConnectionObject.h"
+#include "ItemEdgeObject.h"
+#include "PageInfoObject.h"
+
+#include "graphqlservice/internal/Schema.h"
+
+#include "graphqlservice/introspection/IntrospectionSchema.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std::literals;
+
+namespace graphql::mapi {
+namespace object {
+
+ItemConnection::ItemConnection(std::unique_ptr<const Concept> pimpl) noexcept
+	: service::Object{ getTypeNames(), getResolvers() }
+	, _pimpl { std::move(pimpl) }
+{
+}
+
+service::TypeNames ItemConnection::getTypeNames() const noexcept
+{
+	return {
+		R"gql(ItemConnection)gql"sv
+	};
+}
+
+service::ResolverMap ItemConnection::getResolvers() const noexcept
+{
+	return {
+		{ R"gql(edges)gql"sv, [this](service::ResolverParams&& params) { return resolveEdges(std::move(params)); } },
+		{ R"gql(pageInfo)gql"sv, [this](service::ResolverParams&& params) { return resolvePageInfo(std::move(params)); } },
+		{ R"gql(__typename)gql"sv, [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } },
+		{ R"gql(totalCount)gql"sv, [this](service::ResolverParams&& params) { return resolveTotalCount(std::move(params)); } }
+	};
+}
+
+void ItemConnection::beginSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->beginSelectionSet(params);
+}
+
+void ItemConnection::endSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->endSelectionSet(params);
+}
+
+service::AwaitableResolver ItemConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getEdges(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<ItemEdge>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver ItemConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getPageInfo(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver ItemConnection::resolveTotalCount(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getTotalCount(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<int>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver ItemConnection::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::Result<std::string>::convert(std::string{ R"gql(ItemConnection)gql" }, std::move(params));
+}
+
+} // namespace object
+
+void AddItemConnectionDetails(const std::shared_ptr<schema::ObjectType>& typeItemConnection, const std::shared_ptr<schema::Schema>& schema)
+{
+	typeItemConnection->AddFields({
+		schema::Field::Make(R"gql(edges)gql"sv, R"md(Items in this page)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ItemEdge)gql"sv))))),
+		schema::Field::Make(R"gql(pageInfo)gql"sv, R"md(Pagination state for requesting the next page)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PageInfo)gql"sv))),
+		schema::Field::Make(R"gql(totalCount)gql"sv, R"md(Total number of items which match any `@where` restriction, without reading any rows)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Int)gql"sv)))
+	});
+}
+
+} // namespace graphql::mapi
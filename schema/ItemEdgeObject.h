@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#pragma once
+
+#ifndef ITEMEDGEOBJECT_H
+#define ITEMEDGEOBJECT_H
+
+#include "MAPISchema.h"
+
+namespace graphql::mapi::object {
+namespace methods::ItemEdgeHas {
+
+template <class TImpl>
+concept getCursorWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<response::IdType> { impl.getCursor(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getCursor = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<response::IdType> { impl.getCursor() } };
+};
+
+template <class TImpl>
+concept getNodeWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableObject<std::shared_ptr<Item>> { impl.getNode(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getNode = requires (TImpl impl)
+{
+	{ service::AwaitableObject<std::shared_ptr<Item>> { impl.getNode() } };
+};
+
+template <class TImpl>
+concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.beginSelectionSet(params) };
+};
+
+template <class TImpl>
+concept endSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.endSelectionSet(params) };
+};
+
+} // namespace methods::ItemEdgeHas
+
+class [[nodiscard("unnecessary construction")]] ItemEdge final
+	: public service::Object
+{
+private:
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveCursor(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveNode(service::ResolverParams&& params) const;
+
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
+
+	struct [[nodiscard("unnecessary construction")]] Concept
+	{
+		virtual ~Concept() = default;
+
+		virtual void beginSelectionSet(const service::SelectionSetParams& params) const = 0;
+		virtual void endSelectionSet(const service::SelectionSetParams& params) const = 0;
+
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<response::IdType> getCursor(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<Item>> getNode(service::FieldParams&& params) const = 0;
+	};
+
+	template <class T>
+	struct [[nodiscard("unnecessary construction")]] Model final
+		: Concept
+	{
+		explicit Model(std::shared_ptr<T> pimpl) noexcept
+			: _pimpl { std::move(pimpl) }
+		{
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<response::IdType> getCursor(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemEdgeHas::getCursorWithParams<T>)
+			{
+				return { _pimpl->getCursor(std::move(params)) };
+			}
+			else if constexpr (methods::ItemEdgeHas::getCursor<T>)
+			{
+				return { _pimpl->getCursor() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemEdge::getCursor)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<Item>> getNode(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemEdgeHas::getNodeWithParams<T>)
+			{
+				return { _pimpl->getNode(std::move(params)) };
+			}
+			else if constexpr (methods::ItemEdgeHas::getNode<T>)
+			{
+				return { _pimpl->getNode() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemEdge::getNode)ex");
+			}
+		}
+
+		void beginSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::ItemEdgeHas::beginSelectionSet<T>)
+			{
+				_pimpl->beginSelectionSet(params);
+			}
+		}
+
+		void endSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::ItemEdgeHas::endSelectionSet<T>)
+			{
+				_pimpl->endSelectionSet(params);
+			}
+		}
+
+	private:
+		const std::shared_ptr<T> _pimpl;
+	};
+
+	explicit ItemEdge(std::unique_ptr<const Concept> pimpl) noexcept;
+
+	[[nodiscard("unnecessary call")]] service::TypeNames getTypeNames() const noexcept;
+	[[nodiscard("unnecessary call")]] service::ResolverMap getResolvers() const noexcept;
+
+	void beginSelectionSet(const service::SelectionSetParams& params) const override;
+	void endSelectionSet(const service::SelectionSetParams& params) const override;
+
+	const std::unique_ptr<const Concept> _pimpl;
+
+public:
+	template <class T>
+	explicit ItemEdge(std::shared_ptr<T> pimpl) noexcept
+		: ItemEdge { std::unique_ptr<const Concept> { std::make_unique<Model<T>>(std::move(pimpl)) } }
+	{
+	}
+
+	[[nodiscard("unnecessary call")]] static constexpr std::string_view getObjectType() noexcept
+	{
+		return { R"gql(ItemEdge)gql" };
+	}
+};
+
+} // namespace graphql::mapi::object
+
+#endif // ITEMEDGEOBJECT_H
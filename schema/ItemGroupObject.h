@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#pragma once
+
+#ifndef ITEMGROUPOBJECT_H
+#define ITEMGROUPOBJECT_H
+
+#include "MAPISchema.h"
+
+namespace graphql::mapi::object {
+namespace methods::ItemGroupHas {
+
+template <class TImpl>
+concept getIdWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<response::IdType> { impl.getId(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getId = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<response::IdType> { impl.getId() } };
+};
+
+template <class TImpl>
+concept getValueWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableObject<std::shared_ptr<Property>> { impl.getValue(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getValue = requires (TImpl impl)
+{
+	{ service::AwaitableObject<std::shared_ptr<Property>> { impl.getValue() } };
+};
+
+template <class TImpl>
+concept getCountWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<int> { impl.getCount(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getCount = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<int> { impl.getCount() } };
+};
+
+template <class TImpl>
+concept getUnreadWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<int> { impl.getUnread(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getUnread = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<int> { impl.getUnread() } };
+};
+
+template <class TImpl>
+concept getItemsWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<Item>>> { impl.getItems(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getItems = requires (TImpl impl)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<Item>>> { impl.getItems() } };
+};
+
+template <class TImpl>
+concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.beginSelectionSet(params) };
+};
+
+template <class TImpl>
+concept endSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.endSelectionSet(params) };
+};
+
+} // namespace methods::ItemGroupHas
+
+class [[nodiscard("unnecessary construction")]] ItemGroup final
+	: public service::Object
+{
+private:
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveId(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveValue(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveCount(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveUnread(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItems(service::ResolverParams&& params) const;
+
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
+
+	struct [[nodiscard("unnecessary construction")]] Concept
+	{
+		virtual ~Concept() = default;
+
+		virtual void beginSelectionSet(const service::SelectionSetParams& params) const = 0;
+		virtual void endSelectionSet(const service::SelectionSetParams& params) const = 0;
+
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<response::IdType> getId(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<Property>> getValue(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<int> getCount(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<int> getUnread(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Item>>> getItems(service::FieldParams&& params) const = 0;
+	};
+
+	template <class T>
+	struct [[nodiscard("unnecessary construction")]] Model final
+		: Concept
+	{
+		explicit Model(std::shared_ptr<T> pimpl) noexcept
+			: _pimpl { std::move(pimpl) }
+		{
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<response::IdType> getId(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::getIdWithParams<T>)
+			{
+				return { _pimpl->getId(std::move(params)) };
+			}
+			else if constexpr (methods::ItemGroupHas::getId<T>)
+			{
+				return { _pimpl->getId() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemGroup::getId)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<Property>> getValue(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::getValueWithParams<T>)
+			{
+				return { _pimpl->getValue(std::move(params)) };
+			}
+			else if constexpr (methods::ItemGroupHas::getValue<T>)
+			{
+				return { _pimpl->getValue() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemGroup::getValue)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<int> getCount(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::getCountWithParams<T>)
+			{
+				return { _pimpl->getCount(std::move(params)) };
+			}
+			else if constexpr (methods::ItemGroupHas::getCount<T>)
+			{
+				return { _pimpl->getCount() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemGroup::getCount)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<int> getUnread(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::getUnreadWithParams<T>)
+			{
+				return { _pimpl->getUnread(std::move(params)) };
+			}
+			else if constexpr (methods::ItemGroupHas::getUnread<T>)
+			{
+				return { _pimpl->getUnread() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemGroup::getUnread)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<Item>>> getItems(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::getItemsWithParams<T>)
+			{
+				return { _pimpl->getItems(std::move(params)) };
+			}
+			else if constexpr (methods::ItemGroupHas::getItems<T>)
+			{
+				return { _pimpl->getItems() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(ItemGroup::getItems)ex");
+			}
+		}
+
+		void beginSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::beginSelectionSet<T>)
+			{
+				_pimpl->beginSelectionSet(params);
+			}
+		}
+
+		void endSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::ItemGroupHas::endSelectionSet<T>)
+			{
+				_pimpl->endSelectionSet(params);
+			}
+		}
+
+	private:
+		const std::shared_ptr<T> _pimpl;
+	};
+
+	explicit ItemGroup(std::unique_ptr<const Concept> pimpl) noexcept;
+
+	[[nodiscard("unnecessary call")]] service::TypeNames getTypeNames() const noexcept;
+	[[nodiscard("unnecessary call")]] service::ResolverMap getResolvers() const noexcept;
+
+	void beginSelectionSet(const service::SelectionSetParams& params) const override;
+	void endSelectionSet(const service::SelectionSetParams& params) const override;
+
+	const std::unique_ptr<const Concept> _pimpl;
+
+public:
+	template <class T>
+	explicit ItemGroup(std::shared_ptr<T> pimpl) noexcept
+		: ItemGroup { std::unique_ptr<const Concept> { std::make_unique<Model<T>>(std::move(pimpl)) } }
+	{
+	}
+
+	[[nodiscard("unnecessary call")]] static constexpr std::string_view getObjectType() noexcept
+	{
+		return { R"gql(ItemGroup)gql" };
+	}
+};
+
+} // namespace graphql::mapi::object
+
+#endif // ITEMGROUPOBJECT_H
@@ -137,6 +137,62 @@ void Result<mapi::PropType>::validateScalar(const response::Value& value)
 	}
 }
 
+static const auto s_namesRelop = mapi::getRelopNames();
+static const auto s_valuesRelop = mapi::getRelopValues();
+
+template <>
+mapi::Relop Argument<mapi::Relop>::convert(const response::Value& value)
+{
+	if (!value.maybe_enum())
+	{
+		throw service::schema_exception { { R"ex(not a valid Relop value)ex" } };
+	}
+
+	const auto result = internal::sorted_map_lookup<internal::shorter_or_less>(
+		s_valuesRelop,
+		std::string_view { value.get<std::string>() });
+
+	if (!result)
+	{
+		throw service::schema_exception { { R"ex(not a valid Relop value)ex" } };
+	}
+
+	return *result;
+}
+
+template <>
+service::AwaitableResolver Result<mapi::Relop>::convert(service::AwaitableScalar<mapi::Relop> result, ResolverParams&& params)
+{
+	return ModifiedResult<mapi::Relop>::resolve(std::move(result), std::move(params),
+		[](mapi::Relop value, const ResolverParams&)
+		{
+			response::Value resolvedResult(response::Type::EnumValue);
+
+			resolvedResult.set<std::string>(std::string { s_namesRelop[static_cast<size_t>(value)] });
+
+			return resolvedResult;
+		});
+}
+
+template <>
+void Result<mapi::Relop>::validateScalar(const response::Value& value)
+{
+	if (!value.maybe_enum())
+	{
+		throw service::schema_exception { { R"ex(not a valid Relop value)ex" } };
+	}
+
+	const auto [itr, itrEnd] = internal::sorted_map_equal_range<internal::shorter_or_less>(
+		s_valuesRelop.begin(),
+		s_valuesRelop.end(),
+		std::string_view { value.get<std::string>() });
+
+	if (itr == itrEnd)
+	{
+		throw service::schema_exception { { R"ex(not a valid Relop value)ex" } };
+	}
+}
+
 template <>
 mapi::ObjectId Argument<mapi::ObjectId>::convert(const response::Value& value)
 {
@@ -345,6 +401,75 @@ mapi::Column Argument<mapi::Column>::convert(const response::Value& value)
 	};
 }
 
+template <>
+mapi::PropertyComparison Argument<mapi::PropertyComparison>::convert(const response::Value& value)
+{
+	auto valueProperty = service::ModifiedArgument<mapi::PropIdInput>::require("property", value);
+	auto valueRelop = service::ModifiedArgument<mapi::Relop>::require("relop", value);
+	auto valueValue = service::ModifiedArgument<mapi::PropValueInput>::require("value", value);
+
+	return mapi::PropertyComparison {
+		std::move(valueProperty),
+		std::move(valueRelop),
+		std::move(valueValue)
+	};
+}
+
+template <>
+mapi::ContentFilter Argument<mapi::ContentFilter>::convert(const response::Value& value)
+{
+	const auto defaultValue = []()
+	{
+		response::Value values(response::Type::Map);
+		response::Value entry;
+
+		entry = response::Value(false);
+		values.emplace_back("prefix", std::move(entry));
+		entry = response::Value(true);
+		values.emplace_back("ignoreCase", std::move(entry));
+
+		return values;
+	}();
+
+	auto valueProperty = service::ModifiedArgument<mapi::PropIdInput>::require("property", value);
+	auto valueValue = service::ModifiedArgument<std::string>::require("value", value);
+	auto pairPrefix = service::ModifiedArgument<bool>::find("prefix", value);
+	auto valuePrefix = (pairPrefix.second
+		? pairPrefix.first
+		: service::ModifiedArgument<bool>::require("prefix", defaultValue));
+	auto pairIgnoreCase = service::ModifiedArgument<bool>::find("ignoreCase", value);
+	auto valueIgnoreCase = (pairIgnoreCase.second
+		? pairIgnoreCase.first
+		: service::ModifiedArgument<bool>::require("ignoreCase", defaultValue));
+
+	return mapi::ContentFilter {
+		std::move(valueProperty),
+		std::move(valueValue),
+		valuePrefix,
+		valueIgnoreCase
+	};
+}
+
+template <>
+mapi::Restriction Argument<mapi::Restriction>::convert(const response::Value& value)
+{
+	auto valueAll = service::ModifiedArgument<mapi::Restriction>::require<service::TypeModifier::Nullable, service::TypeModifier::List>("all", value);
+	auto valueAny = service::ModifiedArgument<mapi::Restriction>::require<service::TypeModifier::Nullable, service::TypeModifier::List>("any", value);
+	auto valueNegate = service::ModifiedArgument<mapi::Restriction>::require<service::TypeModifier::Nullable>("negate", value);
+	auto valueCompare = service::ModifiedArgument<mapi::PropertyComparison>::require<service::TypeModifier::Nullable>("compare", value);
+	auto valueContains = service::ModifiedArgument<mapi::ContentFilter>::require<service::TypeModifier::Nullable>("contains", value);
+	auto valueExists = service::ModifiedArgument<mapi::PropIdInput>::require<service::TypeModifier::Nullable>("exists", value);
+
+	return mapi::Restriction {
+		std::move(valueAll),
+		std::move(valueAny),
+		std::move(valueNegate),
+		std::move(valueCompare),
+		std::move(valueContains),
+		std::move(valueExists)
+	};
+}
+
 } // namespace service
 
 namespace mapi {
@@ -1003,6 +1128,182 @@ Column& Column::operator=(Column&& other) noexcept
 	return *this;
 }
 
+PropertyComparison::PropertyComparison() noexcept
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+PropertyComparison::PropertyComparison(
+		PropIdInput propertyArg,
+		Relop relopArg,
+		PropValueInput valueArg) noexcept
+	: property { std::move(propertyArg) }
+	, relop { std::move(relopArg) }
+	, value { std::move(valueArg) }
+{
+}
+
+PropertyComparison::PropertyComparison(const PropertyComparison& other)
+	: property { service::ModifiedArgument<PropIdInput>::duplicate(other.property) }
+	, relop { service::ModifiedArgument<Relop>::duplicate(other.relop) }
+	, value { service::ModifiedArgument<PropValueInput>::duplicate(other.value) }
+{
+}
+
+PropertyComparison::PropertyComparison(PropertyComparison&& other) noexcept
+	: property { std::move(other.property) }
+	, relop { std::move(other.relop) }
+	, value { std::move(other.value) }
+{
+}
+
+PropertyComparison::~PropertyComparison()
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+PropertyComparison& PropertyComparison::operator=(const PropertyComparison& other)
+{
+	PropertyComparison value { other };
+
+	std::swap(*this, value);
+
+	return *this;
+}
+
+PropertyComparison& PropertyComparison::operator=(PropertyComparison&& other) noexcept
+{
+	property = std::move(other.property);
+	relop = std::move(other.relop);
+	value = std::move(other.value);
+
+	return *this;
+}
+
+ContentFilter::ContentFilter() noexcept
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+ContentFilter::ContentFilter(
+		PropIdInput propertyArg,
+		std::string valueArg,
+		bool prefixArg,
+		bool ignoreCaseArg) noexcept
+	: property { std::move(propertyArg) }
+	, value { std::move(valueArg) }
+	, prefix { std::move(prefixArg) }
+	, ignoreCase { std::move(ignoreCaseArg) }
+{
+}
+
+ContentFilter::ContentFilter(const ContentFilter& other)
+	: property { service::ModifiedArgument<PropIdInput>::duplicate(other.property) }
+	, value { service::ModifiedArgument<std::string>::duplicate(other.value) }
+	, prefix { service::ModifiedArgument<bool>::duplicate(other.prefix) }
+	, ignoreCase { service::ModifiedArgument<bool>::duplicate(other.ignoreCase) }
+{
+}
+
+ContentFilter::ContentFilter(ContentFilter&& other) noexcept
+	: property { std::move(other.property) }
+	, value { std::move(other.value) }
+	, prefix { std::move(other.prefix) }
+	, ignoreCase { std::move(other.ignoreCase) }
+{
+}
+
+ContentFilter::~ContentFilter()
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+ContentFilter& ContentFilter::operator=(const ContentFilter& other)
+{
+	ContentFilter value { other };
+
+	std::swap(*this, value);
+
+	return *this;
+}
+
+ContentFilter& ContentFilter::operator=(ContentFilter&& other) noexcept
+{
+	property = std::move(other.property);
+	value = std::move(other.value);
+	prefix = std::move(other.prefix);
+	ignoreCase = std::move(other.ignoreCase);
+
+	return *this;
+}
+
+Restriction::Restriction() noexcept
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+Restriction::Restriction(
+		std::optional<std::vector<Restriction>> allArg,
+		std::optional<std::vector<Restriction>> anyArg,
+		std::unique_ptr<Restriction> negateArg,
+		std::unique_ptr<PropertyComparison> compareArg,
+		std::unique_ptr<ContentFilter> containsArg,
+		std::unique_ptr<PropIdInput> existsArg) noexcept
+	: all { std::move(allArg) }
+	, any { std::move(anyArg) }
+	, negate { std::move(negateArg) }
+	, compare { std::move(compareArg) }
+	, contains { std::move(containsArg) }
+	, exists { std::move(existsArg) }
+{
+}
+
+Restriction::Restriction(const Restriction& other)
+	: all { service::ModifiedArgument<Restriction>::duplicate<service::TypeModifier::Nullable, service::TypeModifier::List>(other.all) }
+	, any { service::ModifiedArgument<Restriction>::duplicate<service::TypeModifier::Nullable, service::TypeModifier::List>(other.any) }
+	, negate { service::ModifiedArgument<Restriction>::duplicate<service::TypeModifier::Nullable>(other.negate) }
+	, compare { service::ModifiedArgument<PropertyComparison>::duplicate<service::TypeModifier::Nullable>(other.compare) }
+	, contains { service::ModifiedArgument<ContentFilter>::duplicate<service::TypeModifier::Nullable>(other.contains) }
+	, exists { service::ModifiedArgument<PropIdInput>::duplicate<service::TypeModifier::Nullable>(other.exists) }
+{
+}
+
+Restriction::Restriction(Restriction&& other) noexcept
+	: all { std::move(other.all) }
+	, any { std::move(other.any) }
+	, negate { std::move(other.negate) }
+	, compare { std::move(other.compare) }
+	, contains { std::move(other.contains) }
+	, exists { std::move(other.exists) }
+{
+}
+
+Restriction::~Restriction()
+{
+	// Explicit definition to prevent ODR violations when LTO is enabled.
+}
+
+Restriction& Restriction::operator=(const Restriction& other)
+{
+	Restriction value { other };
+
+	std::swap(*this, value);
+
+	return *this;
+}
+
+Restriction& Restriction::operator=(Restriction&& other) noexcept
+{
+	all = std::move(other.all);
+	any = std::move(other.any);
+	negate = std::move(other.negate);
+	compare = std::move(other.compare);
+	contains = std::move(other.contains);
+	exists = std::move(other.exists);
+
+	return *this;
+}
+
 Operations::Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription)
 	: service::Request({
 		{ service::strQuery, query },
@@ -1024,6 +1325,8 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 	schema->AddType(R"gql(SpecialFolder)gql"sv, typeSpecialFolder);
 	auto typePropType = schema::EnumType::Make(R"gql(PropType)gql"sv, R"md(When sorting by a property ID you need to include the expected property type.)md"sv);
 	schema->AddType(R"gql(PropType)gql"sv, typePropType);
+	auto typeRelop = schema::EnumType::Make(R"gql(Relop)gql"sv, R"md(Relational operators which can be used to compare a property value with a constant.)md"sv);
+	schema->AddType(R"gql(Relop)gql"sv, typeRelop);
 	auto typeObjectId = schema::InputObjectType::Make(R"gql(ObjectId)gql"sv, R"md(Pair of IDs which uniquely identify a folder or item across all stores)md"sv);
 	schema->AddType(R"gql(ObjectId)gql"sv, typeObjectId);
 	auto typeNamedPropInput = schema::InputObjectType::Make(R"gql(NamedPropInput)gql"sv, R"md(Named property ID description)md"sv);
@@ -1048,6 +1351,12 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 	schema->AddType(R"gql(Order)gql"sv, typeOrder);
 	auto typeColumn = schema::InputObjectType::Make(R"gql(Column)gql"sv, R"md(Add a column to the columns property on an object collection.)md"sv);
 	schema->AddType(R"gql(Column)gql"sv, typeColumn);
+	auto typePropertyComparison = schema::InputObjectType::Make(R"gql(PropertyComparison)gql"sv, R"md(Compare a single property value with a constant.)md"sv);
+	schema->AddType(R"gql(PropertyComparison)gql"sv, typePropertyComparison);
+	auto typeContentFilter = schema::InputObjectType::Make(R"gql(ContentFilter)gql"sv, R"md(Match a sub-string or prefix of a string property.)md"sv);
+	schema->AddType(R"gql(ContentFilter)gql"sv, typeContentFilter);
+	auto typeRestriction = schema::InputObjectType::Make(R"gql(Restriction)gql"sv, R"md(Filter the elements of an object collection. Exactly one of these fields must be set.)md"sv);
+	schema->AddType(R"gql(Restriction)gql"sv, typeRestriction);
 	auto typeAttachment = schema::UnionType::Make(R"gql(Attachment)gql"sv, R"md(Attachments can be either a file or another item.)md"sv);
 	schema->AddType(R"gql(Attachment)gql"sv, typeAttachment);
 	auto typeNamedPropId = schema::UnionType::Make(R"gql(NamedPropId)gql"sv, R"md()md"sv);
@@ -1076,6 +1385,18 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 	schema->AddType(R"gql(FileAttachment)gql"sv, typeFileAttachment);
 	auto typeConversation = schema::ObjectType::Make(R"gql(Conversation)gql"sv, R"md(Items may be grouped into conversations which roll-up properties from the items.)md"sv);
 	schema->AddType(R"gql(Conversation)gql"sv, typeConversation);
+	auto typePageInfo = schema::ObjectType::Make(R"gql(PageInfo)gql"sv, R"md(Pagination state for a page of folders or items)md"sv);
+	schema->AddType(R"gql(PageInfo)gql"sv, typePageInfo);
+	auto typeItemEdge = schema::ObjectType::Make(R"gql(ItemEdge)gql"sv, R"md(Single item in a page of items)md"sv);
+	schema->AddType(R"gql(ItemEdge)gql"sv, typeItemEdge);
+	auto typeItemConnection = schema::ObjectType::Make(R"gql(ItemConnection)gql"sv, R"md(Page of items with cursors to continue reading the folder contents)md"sv);
+	schema->AddType(R"gql(ItemConnection)gql"sv, typeItemConnection);
+	auto typeFolderEdge = schema::ObjectType::Make(R"gql(FolderEdge)gql"sv, R"md(Single folder in a page of folders)md"sv);
+	schema->AddType(R"gql(FolderEdge)gql"sv, typeFolderEdge);
+	auto typeFolderConnection = schema::ObjectType::Make(R"gql(FolderConnection)gql"sv, R"md(Page of folders with cursors to continue reading the folder hierarchy)md"sv);
+	schema->AddType(R"gql(FolderConnection)gql"sv, typeFolderConnection);
+	auto typeItemGroup = schema::ObjectType::Make(R"gql(ItemGroup)gql"sv, R"md(Category heading for the items which share the same value of the `@groupBy` property)md"sv);
+	schema->AddType(R"gql(ItemGroup)gql"sv, typeItemGroup);
 	auto typeIntId = schema::ObjectType::Make(R"gql(IntId)gql"sv, R"md(This type represents a built-in or named property integer ID in a union.)md"sv);
 	schema->AddType(R"gql(IntId)gql"sv, typeIntId);
 	auto typeStringId = schema::ObjectType::Make(R"gql(StringId)gql"sv, R"md(This type represents a named property string name in a union.)md"sv);
@@ -1136,6 +1457,14 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 		{ service::s_namesPropType[static_cast<size_t>(mapi::PropType::BINARY)], R"md(This property expects a `BinaryValue`)md"sv, std::nullopt },
 		{ service::s_namesPropType[static_cast<size_t>(mapi::PropType::STREAM)], R"md(This property expects a `StreamValue`)md"sv, std::make_optional(R"md(You can't sort on a `StreamValue`)md"sv) }
 	});
+	typeRelop->AddEnumValues({
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::LT)], R"md(Property value is less than the constant)md"sv, std::nullopt },
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::LE)], R"md(Property value is less than or equal to the constant)md"sv, std::nullopt },
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::GT)], R"md(Property value is greater than the constant)md"sv, std::nullopt },
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::GE)], R"md(Property value is greater than or equal to the constant)md"sv, std::nullopt },
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::EQ)], R"md(Property value is equal to the constant)md"sv, std::nullopt },
+		{ service::s_namesRelop[static_cast<size_t>(mapi::Relop::NE)], R"md(Property value is not equal to the constant)md"sv, std::nullopt }
+	});
 
 	typeObjectId->AddInputValues({
 		schema::InputValue::Make(R"gql(storeId)gql"sv, R"md(ID of the store containing the object)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv)), R"gql()gql"sv),
@@ -1203,6 +1532,25 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 		schema::InputValue::Make(R"gql(property)gql"sv, R"md(Property ID of the sorted value)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PropIdInput)gql"sv)), R"gql()gql"sv),
 		schema::InputValue::Make(R"gql(type)gql"sv, R"md(Expected type of the sorted value)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PropType)gql"sv)), R"gql()gql"sv)
 	});
+	typePropertyComparison->AddInputValues({
+		schema::InputValue::Make(R"gql(property)gql"sv, R"md(Property ID of the compared value)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PropIdInput)gql"sv)), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(relop)gql"sv, R"md(Relational operator, e.g. `EQ` for equality)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Relop)gql"sv)), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(value)gql"sv, R"md(Constant value, which also determines the expected type of the property)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PropValueInput)gql"sv)), R"gql()gql"sv)
+	});
+	typeContentFilter->AddInputValues({
+		schema::InputValue::Make(R"gql(property)gql"sv, R"md(Property ID of the string value)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(PropIdInput)gql"sv)), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(value)gql"sv, R"md(Sub-string or prefix to match)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(String)gql"sv)), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(prefix)gql"sv, R"md(True if `value` must match the beginning of the string, false if it can match anywhere (default))md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Boolean)gql"sv)), R"gql(false)gql"sv),
+		schema::InputValue::Make(R"gql(ignoreCase)gql"sv, R"md(True if the match should ignore case (default), false if it should be case-sensitive)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Boolean)gql"sv)), R"gql(true)gql"sv)
+	});
+	typeRestriction->AddInputValues({
+		schema::InputValue::Make(R"gql(all)gql"sv, R"md(Match elements which match all of these restrictions)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Restriction)gql"sv))), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(any)gql"sv, R"md(Match elements which match any of these restrictions)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Restriction)gql"sv))), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(negate)gql"sv, R"md(Match elements which do not match this restriction)md"sv, schema->LookupType(R"gql(Restriction)gql"sv), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(compare)gql"sv, R"md(Match elements where the property value compares with a constant)md"sv, schema->LookupType(R"gql(PropertyComparison)gql"sv), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(contains)gql"sv, R"md(Match elements where a string property contains a sub-string or prefix)md"sv, schema->LookupType(R"gql(ContentFilter)gql"sv), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(exists)gql"sv, R"md(Match elements which have a value for this property)md"sv, schema->LookupType(R"gql(PropIdInput)gql"sv), R"gql()gql"sv)
+	});
 
 	AddAttachmentDetails(typeAttachment, schema);
 	AddNamedPropIdDetails(typeNamedPropId, schema);
@@ -1219,6 +1567,12 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 	AddItemDetails(typeItem, schema);
 	AddFileAttachmentDetails(typeFileAttachment, schema);
 	AddConversationDetails(typeConversation, schema);
+	AddPageInfoDetails(typePageInfo, schema);
+	AddItemEdgeDetails(typeItemEdge, schema);
+	AddItemConnectionDetails(typeItemConnection, schema);
+	AddFolderEdgeDetails(typeFolderEdge, schema);
+	AddFolderConnectionDetails(typeFolderConnection, schema);
+	AddItemGroupDetails(typeItemGroup, schema);
 	AddIntIdDetails(typeIntId, schema);
 	AddStringIdDetails(typeStringId, schema);
 	AddNamedIdDetails(typeNamedId, schema);
@@ -1264,6 +1618,32 @@ void AddTypesToSchema(const std::shared_ptr<schema::Schema>& schema)
 	}, {
 		schema::InputValue::Make(R"gql(count)gql"sv, R"md()md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Int)gql"sv)), R"gql()gql"sv)
 	}, false));
+	schema->AddDirective(schema::Directive::Make(R"gql(select)gql"sv, R"md(Only read the default columns needed to resolve these fields in any object collection. Fields which are not listed will resolve to empty or `null` values.)md"sv, {
+		introspection::DirectiveLocation::FIELD
+	}, {
+		schema::InputValue::Make(R"gql(fields)gql"sv, R"md(Field names on the `Folder` or `Item` type)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(String)gql"sv)))), R"gql()gql"sv)
+	}, false));
+	schema->AddDirective(schema::Directive::Make(R"gql(chunked)gql"sv, R"md(Read every element after `@seek` and `@offset` in chunks of `size` elements instead of a single window. A positive `@take` limits the total number of elements, without the usual cap of 50, and a negative `@take` is an error. The elements are not cached between queries.)md"sv, {
+		introspection::DirectiveLocation::FIELD
+	}, {
+		schema::InputValue::Make(R"gql(size)gql"sv, R"md()md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Int)gql"sv)), R"gql()gql"sv)
+	}, false));
+	schema->AddDirective(schema::Directive::Make(R"gql(where)gql"sv, R"md(Filter the results of any object collection in the store before applying `@seek`, `@offset`, and `@take`.)md"sv, {
+		introspection::DirectiveLocation::FIELD
+	}, {
+		schema::InputValue::Make(R"gql(filter)gql"sv, R"md(Filter which elements must match)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Restriction)gql"sv)), R"gql()gql"sv)
+	}, false));
+	schema->AddDirective(schema::Directive::Make(R"gql(readAhead)gql"sv, R"md(Read the next `pages` windows of `@take` elements along with this one, and keep them on the open folder table until a query with the following `@offset` or connection cursor asks for them.)md"sv, {
+		introspection::DirectiveLocation::FIELD
+	}, {
+		schema::InputValue::Make(R"gql(pages)gql"sv, R"md(Number of windows or pages to read ahead, up to 10)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Int)gql"sv)), R"gql()gql"sv),
+		schema::InputValue::Make(R"gql(budget)gql"sv, R"md(Maximum number of bytes to keep for the windows which were read ahead on each table, defaults to 1 MB)md"sv, schema->LookupType(R"gql(Int)gql"sv), R"gql(null)gql"sv)
+	}, false));
+	schema->AddDirective(schema::Directive::Make(R"gql(groupBy)gql"sv, R"md(Group the items by the values of a property, and read one heading with the item counts for each category instead of the items.)md"sv, {
+		introspection::DirectiveLocation::FIELD
+	}, {
+		schema::InputValue::Make(R"gql(sort)gql"sv, R"md(Category property and sort order)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Order)gql"sv)), R"gql()gql"sv)
+	}, false));
 
 	schema->AddQueryType(typeQuery);
 	schema->AddMutationType(typeMutation);
@@ -113,6 +113,44 @@ enum class [[nodiscard("unnecessary conversion")]] PropType
 	};
 }
 
+enum class [[nodiscard("unnecessary conversion")]] Relop
+{
+	LT,
+	LE,
+	GT,
+	GE,
+	EQ,
+	NE
+};
+
+[[nodiscard("unnecessary call")]] constexpr auto getRelopNames() noexcept
+{
+	using namespace std::literals;
+
+	return std::array<std::string_view, 6> {
+		R"gql(LT)gql"sv,
+		R"gql(LE)gql"sv,
+		R"gql(GT)gql"sv,
+		R"gql(GE)gql"sv,
+		R"gql(EQ)gql"sv,
+		R"gql(NE)gql"sv
+	};
+}
+
+[[nodiscard("unnecessary call")]] constexpr auto getRelopValues() noexcept
+{
+	using namespace std::literals;
+
+	return std::array<std::pair<std::string_view, Relop>, 6> {
+		std::make_pair(R"gql(EQ)gql"sv, Relop::EQ),
+		std::make_pair(R"gql(GE)gql"sv, Relop::GE),
+		std::make_pair(R"gql(GT)gql"sv, Relop::GT),
+		std::make_pair(R"gql(LE)gql"sv, Relop::LE),
+		std::make_pair(R"gql(LT)gql"sv, Relop::LT),
+		std::make_pair(R"gql(NE)gql"sv, Relop::NE)
+	};
+}
+
 struct [[nodiscard("unnecessary construction")]] ObjectId
 {
 	explicit ObjectId() noexcept;
@@ -355,6 +393,71 @@ struct [[nodiscard("unnecessary construction")]] Column
 	PropType type {};
 };
 
+struct [[nodiscard("unnecessary construction")]] PropertyComparison
+{
+	explicit PropertyComparison() noexcept;
+	explicit PropertyComparison(
+		PropIdInput propertyArg,
+		Relop relopArg,
+		PropValueInput valueArg) noexcept;
+	PropertyComparison(const PropertyComparison& other);
+	PropertyComparison(PropertyComparison&& other) noexcept;
+	~PropertyComparison();
+
+	PropertyComparison& operator=(const PropertyComparison& other);
+	PropertyComparison& operator=(PropertyComparison&& other) noexcept;
+
+	PropIdInput property {};
+	Relop relop {};
+	PropValueInput value {};
+};
+
+struct [[nodiscard("unnecessary construction")]] ContentFilter
+{
+	explicit ContentFilter() noexcept;
+	explicit ContentFilter(
+		PropIdInput propertyArg,
+		std::string valueArg,
+		bool prefixArg,
+		bool ignoreCaseArg) noexcept;
+	ContentFilter(const ContentFilter& other);
+	ContentFilter(ContentFilter&& other) noexcept;
+	~ContentFilter();
+
+	ContentFilter& operator=(const ContentFilter& other);
+	ContentFilter& operator=(ContentFilter&& other) noexcept;
+
+	PropIdInput property {};
+	std::string value {};
+	bool prefix {};
+	bool ignoreCase {};
+};
+
+struct [[nodiscard("unnecessary construction")]] Restriction
+{
+	explicit Restriction() noexcept;
+	explicit Restriction(
+		std::optional<std::vector<Restriction>> allArg,
+		std::optional<std::vector<Restriction>> anyArg,
+		std::unique_ptr<Restriction> negateArg,
+		std::unique_ptr<PropertyComparison> compareArg,
+		std::unique_ptr<ContentFilter> containsArg,
+		std::unique_ptr<PropIdInput> existsArg) noexcept;
+	Restriction(const Restriction& other);
+	Restriction(Restriction&& other) noexcept;
+	~Restriction();
+
+	Restriction& operator=(const Restriction& other);
+	Restriction& operator=(Restriction&& other) noexcept;
+
+	std::optional<std::vector<Restriction>> all {};
+	std::optional<std::vector<Restriction>> any {};
+	std::unique_ptr<Restriction> negate {};
+	std::unique_ptr<PropertyComparison> compare {};
+	std::unique_ptr<ContentFilter> contains {};
+	std::unique_ptr<PropIdInput> exists {};
+};
+
 namespace object {
 
 class Attachment;
@@ -372,6 +475,12 @@ class Folder;
 class Item;
 class FileAttachment;
 class Conversation;
+class PageInfo;
+class ItemEdge;
+class ItemConnection;
+class FolderEdge;
+class FolderConnection;
+class ItemGroup;
 class IntId;
 class StringId;
 class NamedId;
@@ -431,6 +540,12 @@ void AddFolderDetails(const std::shared_ptr<schema::ObjectType>& typeFolder, con
 void AddItemDetails(const std::shared_ptr<schema::ObjectType>& typeItem, const std::shared_ptr<schema::Schema>& schema);
 void AddFileAttachmentDetails(const std::shared_ptr<schema::ObjectType>& typeFileAttachment, const std::shared_ptr<schema::Schema>& schema);
 void AddConversationDetails(const std::shared_ptr<schema::ObjectType>& typeConversation, const std::shared_ptr<schema::Schema>& schema);
+void AddPageInfoDetails(const std::shared_ptr<schema::ObjectType>& typePageInfo, const std::shared_ptr<schema::Schema>& schema);
+void AddItemEdgeDetails(const std::shared_ptr<schema::ObjectType>& typeItemEdge, const std::shared_ptr<schema::Schema>& schema);
+void AddItemConnectionDetails(const std::shared_ptr<schema::ObjectType>& typeItemConnection, const std::shared_ptr<schema::Schema>& schema);
+void AddFolderEdgeDetails(const std::shared_ptr<schema::ObjectType>& typeFolderEdge, const std::shared_ptr<schema::Schema>& schema);
+void AddFolderConnectionDetails(const std::shared_ptr<schema::ObjectType>& typeFolderConnection, const std::shared_ptr<schema::Schema>& schema);
+void AddItemGroupDetails(const std::shared_ptr<schema::ObjectType>& typeItemGroup, const std::shared_ptr<schema::Schema>& schema);
 void AddIntIdDetails(const std::shared_ptr<schema::ObjectType>& typeIntId, const std::shared_ptr<schema::Schema>& schema);
 void AddStringIdDetails(const std::shared_ptr<schema::ObjectType>& typeStringId, const std::shared_ptr<schema::Schema>& schema);
 void AddNamedIdDetails(const std::shared_ptr<schema::ObjectType>& typeNamedId, const std::shared_ptr<schema::Schema>& schema);
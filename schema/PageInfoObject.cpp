@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#include "PageInfoObject.h"
+
+#include "graphqlservice/internal/Schema.h"
+
+#include "graphqlservice/introspection/IntrospectionSchema.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std::literals;
+
+namespace graphql::mapi {
+namespace object {
+
+PageInfo::PageInfo(std::unique_ptr<const Concept> pimpl) noexcept
+	: service::Object{ getTypeNames(), getResolvers() }
+	, _pimpl { std::move(pimpl) }
+{
+}
+
+service::TypeNames PageInfo::getTypeNames() const noexcept
+{
+	return {
+		R"gql(PageInfo)gql"sv
+	};
+}
+
+service::ResolverMap PageInfo::getResolvers() const noexcept
+{
+	return {
+		{ R"gql(endCursor)gql"sv, [this](service::ResolverParams&& params) { return resolveEndCursor(std::move(params)); } },
+		{ R"gql(__typename)gql"sv, [this](service::ResolverParams&& params) { return resolve_typename(std::move(params)); } },
+		{ R"gql(hasNextPage)gql"sv, [this](service::ResolverParams&& params) { return resolveHasNextPage(std::move(params)); } }
+	};
+}
+
+void PageInfo::beginSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->beginSelectionSet(params);
+}
+
+void PageInfo::endSelectionSet(const service::SelectionSetParams& params) const
+{
+	_pimpl->endSelectionSet(params);
+}
+
+service::AwaitableResolver PageInfo::resolveHasNextPage(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getHasNextPage(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver PageInfo::resolveEndCursor(service::ResolverParams&& params) const
+{
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getEndCursor(service::FieldParams { std::move(selectionSetParams), std::move(directives) });
+	resolverLock.unlock();
+
+	return service::ModifiedResult<response::IdType>::convert<service::TypeModifier::Nullable>(std::move(result), std::move(params));
+}
+
+service::AwaitableResolver PageInfo::resolve_typename(service::ResolverParams&& params) const
+{
+	return service::Result<std::string>::convert(std::string{ R"gql(PageInfo)gql" }, std::move(params));
+}
+
+} // namespace object
+
+void AddPageInfoDetails(const std::shared_ptr<schema::ObjectType>& typePageInfo, const std::shared_ptr<schema::Schema>& schema)
+{
+	typePageInfo->AddFields({
+		schema::Field::Make(R"gql(hasNextPage)gql"sv, R"md(True if there are more elements after `endCursor`)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Boolean)gql"sv))),
+		schema::Field::Make(R"gql(endCursor)gql"sv, R"md(Cursor of the last element in this page, pass it as `after` to read the next page)md"sv, std::nullopt, schema->LookupType(R"gql(ID)gql"sv))
+	});
+}
+
+} // namespace graphql::mapi
@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// WARNING! Do not edit this file manually, your changes will be overwritten.
+
+#pragma once
+
+#ifndef PAGEINFOOBJECT_H
+#define PAGEINFOOBJECT_H
+
+#include "MAPISchema.h"
+
+namespace graphql::mapi::object {
+namespace methods::PageInfoHas {
+
+template <class TImpl>
+concept getHasNextPageWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<bool> { impl.getHasNextPage(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getHasNextPage = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<bool> { impl.getHasNextPage() } };
+};
+
+template <class TImpl>
+concept getEndCursorWithParams = requires (TImpl impl, service::FieldParams params)
+{
+	{ service::AwaitableScalar<std::optional<response::IdType>> { impl.getEndCursor(std::move(params)) } };
+};
+
+template <class TImpl>
+concept getEndCursor = requires (TImpl impl)
+{
+	{ service::AwaitableScalar<std::optional<response::IdType>> { impl.getEndCursor() } };
+};
+
+template <class TImpl>
+concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.beginSelectionSet(params) };
+};
+
+template <class TImpl>
+concept endSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
+{
+	{ impl.endSelectionSet(params) };
+};
+
+} // namespace methods::PageInfoHas
+
+class [[nodiscard("unnecessary construction")]] PageInfo final
+	: public service::Object
+{
+private:
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveHasNextPage(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveEndCursor(service::ResolverParams&& params) const;
+
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
+
+	struct [[nodiscard("unnecessary construction")]] Concept
+	{
+		virtual ~Concept() = default;
+
+		virtual void beginSelectionSet(const service::SelectionSetParams& params) const = 0;
+		virtual void endSelectionSet(const service::SelectionSetParams& params) const = 0;
+
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<bool> getHasNextPage(service::FieldParams&& params) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<std::optional<response::IdType>> getEndCursor(service::FieldParams&& params) const = 0;
+	};
+
+	template <class T>
+	struct [[nodiscard("unnecessary construction")]] Model final
+		: Concept
+	{
+		explicit Model(std::shared_ptr<T> pimpl) noexcept
+			: _pimpl { std::move(pimpl) }
+		{
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<bool> getHasNextPage(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::PageInfoHas::getHasNextPageWithParams<T>)
+			{
+				return { _pimpl->getHasNextPage(std::move(params)) };
+			}
+			else if constexpr (methods::PageInfoHas::getHasNextPage<T>)
+			{
+				return { _pimpl->getHasNextPage() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(PageInfo::getHasNextPage)ex");
+			}
+		}
+
+		[[nodiscard("unnecessary call")]] service::AwaitableScalar<std::optional<response::IdType>> getEndCursor(service::FieldParams&& params) const override
+		{
+			if constexpr (methods::PageInfoHas::getEndCursorWithParams<T>)
+			{
+				return { _pimpl->getEndCursor(std::move(params)) };
+			}
+			else if constexpr (methods::PageInfoHas::getEndCursor<T>)
+			{
+				return { _pimpl->getEndCursor() };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(PageInfo::getEndCursor)ex");
+			}
+		}
+
+		void beginSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::PageInfoHas::beginSelectionSet<T>)
+			{
+				_pimpl->beginSelectionSet(params);
+			}
+		}
+
+		void endSelectionSet(const service::SelectionSetParams& params) const override
+		{
+			if constexpr (methods::PageInfoHas::endSelectionSet<T>)
+			{
+				_pimpl->endSelectionSet(params);
+			}
+		}
+
+	private:
+		const std::shared_ptr<T> _pimpl;
+	};
+
+	explicit PageInfo(std::unique_ptr<const Concept> pimpl) noexcept;
+
+	[[nodiscard("unnecessary call")]] service::TypeNames getTypeNames() const noexcept;
+	[[nodiscard("unnecessary call")]] service::ResolverMap getResolvers() const noexcept;
+
+	void beginSelectionSet(const service::SelectionSetParams& params) const override;
+	void endSelectionSet(const service::SelectionSetParams& params) const override;
+
+	const std::unique_ptr<const Concept> _pimpl;
+
+public:
+	template <class T>
+	explicit PageInfo(std::shared_ptr<T> pimpl) noexcept
+		: PageInfo { std::unique_ptr<const Concept> { std::make_unique<Model<T>>(std::move(pimpl)) } }
+	{
+	}
+
+	[[nodiscard("unnecessary call")]] static constexpr std::string_view getObjectType() noexcept
+	{
+		return { R"gql(PageInfo)gql" };
+	}
+};
+
+} // namespace graphql::mapi::object
+
+#endif // PAGEINFOOBJECT_H
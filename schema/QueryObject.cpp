@@ -5,6 +5,7 @@
 
 #include "QueryObject.h"
 #include "StoreObject.h"
+#include "ItemObject.h"
 
 #include "graphqlservice/internal/Introspection.h"
 
@@ -39,6 +40,7 @@ service::TypeNames Query::getTypeNames() const noexcept
 service::ResolverMap Query::getResolvers() const noexcept
 {
 	return {
+		{ R"gql(items)gql"sv, [this](service::ResolverParams&& params) { return resolveItems(std::move(params)); } },
 		{ R"gql(__type)gql"sv, [this](service::ResolverParams&& params) { return resolve_type(std::move(params)); } },
 		{ R"gql(stores)gql"sv, [this](service::ResolverParams&& params) { return resolveStores(std::move(params)); } },
 		{ R"gql(__schema)gql"sv, [this](service::ResolverParams&& params) { return resolve_schema(std::move(params)); } },
@@ -68,6 +70,18 @@ service::AwaitableResolver Query::resolveStores(service::ResolverParams&& params
 	return service::ModifiedResult<Store>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
+service::AwaitableResolver Query::resolveItems(service::ResolverParams&& params) const
+{
+	auto argFolderIds = service::ModifiedArgument<mapi::ObjectId>::require<service::TypeModifier::List>("folderIds", params.arguments);
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getItems(service::FieldParams { std::move(selectionSetParams), std::move(directives) }, std::move(argFolderIds));
+	resolverLock.unlock();
+
+	return service::ModifiedResult<Item>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
+}
+
 service::AwaitableResolver Query::resolve_typename(service::ResolverParams&& params) const
 {
 	return service::Result<std::string>::convert(std::string{ R"gql(Query)gql" }, std::move(params));
@@ -94,6 +108,9 @@ void AddQueryDetails(const std::shared_ptr<schema::ObjectType>& typeQuery, const
 	typeQuery->AddFields({
 		schema::Field::Make(R"gql(stores)gql"sv, R"md(List of stores, which may include stores that are not associated with any account.)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Store)gql"sv)))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of store IDs, return all stores if `null`)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
+		}),
+		schema::Field::Make(R"gql(items)gql"sv, R"md(Items from several folders, e.g. the Inbox in every store, merged into a single sorted list.)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Item)gql"sv)))), {
+			schema::InputValue::Make(R"gql(folderIds)gql"sv, R"md(IDs of the folders to merge)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ObjectId)gql"sv)))), R"gql()gql"sv)
 		})
 	});
 }
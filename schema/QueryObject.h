@@ -25,6 +25,18 @@ concept getStores = requires (TImpl impl, std::optional<std::vector<response::Id
 	{ service::AwaitableObject<std::vector<std::shared_ptr<Store>>> { impl.getStores(std::move(idsArg)) } };
 };
 
+template <class TImpl>
+concept getItemsWithParams = requires (TImpl impl, service::FieldParams params, std::vector<ObjectId> folderIdsArg)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<Item>>> { impl.getItems(std::move(params), std::move(folderIdsArg)) } };
+};
+
+template <class TImpl>
+concept getItems = requires (TImpl impl, std::vector<ObjectId> folderIdsArg)
+{
+	{ service::AwaitableObject<std::vector<std::shared_ptr<Item>>> { impl.getItems(std::move(folderIdsArg)) } };
+};
+
 template <class TImpl>
 concept beginSelectionSet = requires (TImpl impl, const service::SelectionSetParams params)
 {
@@ -44,6 +56,7 @@ class [[nodiscard("unnecessary construction")]] Query final
 {
 private:
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveStores(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItems(service::ResolverParams&& params) const;
 
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_typename(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolve_schema(service::ResolverParams&& params) const;
@@ -59,6 +72,7 @@ private:
 		virtual void endSelectionSet(const service::SelectionSetParams& params) const = 0;
 
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Store>>> getStores(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Item>>> getItems(service::FieldParams&& params, std::vector<ObjectId>&& folderIdsArg) const = 0;
 	};
 
 	template <class T>
@@ -86,6 +100,22 @@ private:
 			}
 		}
 
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<Item>>> getItems(service::FieldParams&& params, std::vector<ObjectId>&& folderIdsArg) const override
+		{
+			if constexpr (methods::QueryHas::getItemsWithParams<T>)
+			{
+				return { _pimpl->getItems(std::move(params), std::move(folderIdsArg)) };
+			}
+			else if constexpr (methods::QueryHas::getItems<T>)
+			{
+				return { _pimpl->getItems(std::move(folderIdsArg)) };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(Query::getItems)ex");
+			}
+		}
+
 		void beginSelectionSet(const service::SelectionSetParams& params) const override
 		{
 			if constexpr (methods::QueryHas::beginSelectionSet<T>)
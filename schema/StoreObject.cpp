@@ -6,6 +6,7 @@
 #include "StoreObject.h"
 #include "PropertyObject.h"
 #include "FolderObject.h"
+#include "FolderConnectionObject.h"
 
 #include "graphqlservice/internal/Schema.h"
 
@@ -45,7 +46,8 @@ service::ResolverMap Store::getResolvers() const noexcept
 		{ R"gql(rootFolders)gql"sv, [this](service::ResolverParams&& params) { return resolveRootFolders(std::move(params)); } },
 		{ R"gql(itemProperties)gql"sv, [this](service::ResolverParams&& params) { return resolveItemProperties(std::move(params)); } },
 		{ R"gql(specialFolders)gql"sv, [this](service::ResolverParams&& params) { return resolveSpecialFolders(std::move(params)); } },
-		{ R"gql(folderProperties)gql"sv, [this](service::ResolverParams&& params) { return resolveFolderProperties(std::move(params)); } }
+		{ R"gql(folderProperties)gql"sv, [this](service::ResolverParams&& params) { return resolveFolderProperties(std::move(params)); } },
+		{ R"gql(rootFoldersConnection)gql"sv, [this](service::ResolverParams&& params) { return resolveRootFoldersConnection(std::move(params)); } }
 	};
 }
 
@@ -104,6 +106,18 @@ service::AwaitableResolver Store::resolveRootFolders(service::ResolverParams&& p
 	return service::ModifiedResult<Folder>::convert<service::TypeModifier::List>(std::move(result), std::move(params));
 }
 
+service::AwaitableResolver Store::resolveRootFoldersConnection(service::ResolverParams&& params) const
+{
+	auto argAfter = service::ModifiedArgument<response::IdType>::require<service::TypeModifier::Nullable>("after", params.arguments);
+	std::unique_lock resolverLock(_resolverMutex);
+	service::SelectionSetParams selectionSetParams { static_cast<const service::SelectionSetParams&>(params) };
+	auto directives = std::move(params.fieldDirectives);
+	auto result = _pimpl->getRootFoldersConnection(service::FieldParams { std::move(selectionSetParams), std::move(directives) }, std::move(argAfter));
+	resolverLock.unlock();
+
+	return service::ModifiedResult<FolderConnection>::convert(std::move(result), std::move(params));
+}
+
 service::AwaitableResolver Store::resolveSpecialFolders(service::ResolverParams&& params) const
 {
 	auto argIds = service::ModifiedArgument<mapi::SpecialFolder>::require<service::TypeModifier::List>("ids", params.arguments);
@@ -158,6 +172,9 @@ void AddStoreDetails(const std::shared_ptr<schema::ObjectType>& typeStore, const
 		schema::Field::Make(R"gql(rootFolders)gql"sv, R"md(List of root folders in the store)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(Folder)gql"sv)))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(Optional list of root folder IDs, return all root folders if `null`)md"sv, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(ID)gql"sv))), R"gql(null)gql"sv)
 		}),
+		schema::Field::Make(R"gql(rootFoldersConnection)gql"sv, R"md(Page through the root folders in the store, use `@take` to set the page size)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(FolderConnection)gql"sv)), {
+			schema::InputValue::Make(R"gql(after)gql"sv, R"md(Cursor from `PageInfo.endCursor` on the previous page, start at the beginning if `null`)md"sv, schema->LookupType(R"gql(ID)gql"sv), R"gql(null)gql"sv)
+		}),
 		schema::Field::Make(R"gql(specialFolders)gql"sv, R"md(List of special folders in the store, some of which may not exist)md"sv, std::nullopt, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->LookupType(R"gql(Folder)gql"sv))), {
 			schema::InputValue::Make(R"gql(ids)gql"sv, R"md(List of special folder IDs)md"sv, schema->WrapType(introspection::TypeKind::NON_NULL, schema->WrapType(introspection::TypeKind::LIST, schema->WrapType(introspection::TypeKind::NON_NULL, schema->LookupType(R"gql(SpecialFolder)gql"sv)))), R"gql()gql"sv)
 		}),
@@ -61,6 +61,18 @@ concept getRootFolders = requires (TImpl impl, std::optional<std::vector<respons
 	{ service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> { impl.getRootFolders(std::move(idsArg)) } };
 };
 
+template <class TImpl>
+concept getRootFoldersConnectionWithParams = requires (TImpl impl, service::FieldParams params, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<FolderConnection>> { impl.getRootFoldersConnection(std::move(params), std::move(afterArg)) } };
+};
+
+template <class TImpl>
+concept getRootFoldersConnection = requires (TImpl impl, std::optional<response::IdType> afterArg)
+{
+	{ service::AwaitableObject<std::shared_ptr<FolderConnection>> { impl.getRootFoldersConnection(std::move(afterArg)) } };
+};
+
 template <class TImpl>
 concept getSpecialFoldersWithParams = requires (TImpl impl, service::FieldParams params, std::vector<SpecialFolder> idsArg)
 {
@@ -119,6 +131,7 @@ private:
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveName(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveColumns(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveRootFolders(service::ResolverParams&& params) const;
+	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveRootFoldersConnection(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveSpecialFolders(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveFolderProperties(service::ResolverParams&& params) const;
 	[[nodiscard("unnecessary call")]] service::AwaitableResolver resolveItemProperties(service::ResolverParams&& params) const;
@@ -136,6 +149,7 @@ private:
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableScalar<std::string> getName(service::FieldParams&& params) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Property>>> getColumns(service::FieldParams&& params) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> getRootFolders(service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const = 0;
+		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::shared_ptr<FolderConnection>> getRootFoldersConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> getSpecialFolders(service::FieldParams&& params, std::vector<SpecialFolder>&& idsArg) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Property>>> getFolderProperties(service::FieldParams&& params, response::IdType&& folderIdArg, std::optional<std::vector<Column>>&& idsArg) const = 0;
 		[[nodiscard("unnecessary call")]] virtual service::AwaitableObject<std::vector<std::shared_ptr<Property>>> getItemProperties(service::FieldParams&& params, response::IdType&& itemIdArg, std::optional<std::vector<Column>>&& idsArg) const = 0;
@@ -214,6 +228,22 @@ private:
 			}
 		}
 
+		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::shared_ptr<FolderConnection>> getRootFoldersConnection(service::FieldParams&& params, std::optional<response::IdType>&& afterArg) const override
+		{
+			if constexpr (methods::StoreHas::getRootFoldersConnectionWithParams<T>)
+			{
+				return { _pimpl->getRootFoldersConnection(std::move(params), std::move(afterArg)) };
+			}
+			else if constexpr (methods::StoreHas::getRootFoldersConnection<T>)
+			{
+				return { _pimpl->getRootFoldersConnection(std::move(afterArg)) };
+			}
+			else
+			{
+				throw service::unimplemented_method(R"ex(Store::getRootFoldersConnection)ex");
+			}
+		}
+
 		[[nodiscard("unnecessary call")]] service::AwaitableObject<std::vector<std::shared_ptr<Folder>>> getSpecialFolders(service::FieldParams&& params, std::vector<SpecialFolder>&& idsArg) const override
 		{
 			if constexpr (methods::StoreHas::getSpecialFoldersWithParams<T>)
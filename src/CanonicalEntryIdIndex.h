@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "EntryIdIndex.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace graphql::mapi {
+
+// Index of a few entry IDs by their canonical form, which is a long-term entry ID without the flag
+// bytes at the beginning. The same object may still have several long-term entry IDs which differ
+// in more than the flags, so a canonical match is only a fast path to a positive answer. Any other
+// entry ID is compared with every entry using the store provider's CompareEntryIDs.
+template <class Value>
+class CanonicalEntryIdIndex
+{
+public:
+	// Size of ENTRYID::abFlags.
+	static constexpr size_t c_flagsSize = 4;
+
+	// Size of the MAPIUID which follows the flags in every entry ID.
+	static constexpr size_t c_providerSize = 16;
+
+	// Returns std::nullopt for short-term entry IDs, which are only valid in this session and may
+	// not follow the same format, or for malformed entry IDs.
+	static std::optional<response::IdType> canonicalize(const response::IdType& entryId)
+	{
+		if (entryId.size() <= c_flagsSize + c_providerSize)
+		{
+			return std::nullopt;
+		}
+
+		const auto idBegin = entryId.data();
+
+		if (std::any_of(idBegin, idBegin + c_flagsSize, [](std::uint8_t flag) noexcept {
+				return flag != 0;
+			}))
+		{
+			return std::nullopt;
+		}
+
+		return std::make_optional<response::IdType>(idBegin + c_flagsSize, idBegin + entryId.size());
+	}
+
+	void insert(const response::IdType& entryId, Value value)
+	{
+		if (const auto canonicalId = canonicalize(entryId))
+		{
+			m_canonicalIds.insert(*canonicalId, value);
+		}
+
+		m_entries.emplace_back(entryId, std::move(value));
+	}
+
+	// Compare must be callable as bool(const response::IdType&, const response::IdType&), and
+	// return true if both entry IDs refer to the same object.
+	template <class Compare>
+	std::optional<Value> find(const response::IdType& entryId, Compare&& compare) const
+	{
+		if (const auto canonicalId = canonicalize(entryId))
+		{
+			if (const auto value = m_canonicalIds.find(*canonicalId))
+			{
+				return std::make_optional(*value);
+			}
+		}
+
+		for (const auto& entry : m_entries)
+		{
+			if (compare(entryId, entry.first))
+			{
+				return std::make_optional(entry.second);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void clear() noexcept
+	{
+		m_canonicalIds.clear();
+		m_entries.clear();
+	}
+
+	size_t size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+private:
+	EntryIdIndex<Value> m_canonicalIds;
+	std::vector<std::pair<response::IdType, Value>> m_entries;
+};
+
+} // namespace graphql::mapi
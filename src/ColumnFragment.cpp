@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include <cstring>
+#include <cwchar>
+
+namespace graphql::mapi {
+
+ColumnFragment::ColumnFragment(response::IdType&& key, size_t bytes,
+	std::vector<std::shared_ptr<object::Property>>&& columns) noexcept
+	: m_key { std::move(key) }
+	, m_bytes { bytes }
+	, m_columns { std::move(columns) }
+{
+}
+
+std::optional<response::IdType> ColumnFragment::MakeKey(
+	const response::IdType& id, size_t columnCount, const SPropValue* columns, size_t offset)
+{
+	const SPropValue* changeKey = nullptr;
+	const SPropValue* modified = nullptr;
+
+	for (size_t i = 0; i < columnCount; ++i)
+	{
+		switch (columns[i].ulPropTag)
+		{
+			case PR_CHANGE_KEY:
+				changeKey = &columns[i];
+				break;
+
+			case PR_LAST_MODIFICATION_TIME:
+				modified = &columns[i];
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	if (!changeKey && !modified)
+	{
+		return std::nullopt;
+	}
+
+	response::IdType key;
+	const auto append = [&key](const void* source, size_t size) {
+		const auto bytes = reinterpret_cast<const std::uint8_t*>(source);
+
+		key.insert(key.end(), bytes, bytes + size);
+	};
+	const auto idSize = static_cast<std::uint32_t>(id.size());
+
+	// Prefix the entry ID with its size, so the parts of different keys can't line up differently.
+	append(&idSize, sizeof(idSize));
+	append(id.data(), id.size());
+
+	if (changeKey)
+	{
+		append(&changeKey->ulPropTag, sizeof(changeKey->ulPropTag));
+		append(&changeKey->Value.bin.cb, sizeof(changeKey->Value.bin.cb));
+		append(changeKey->Value.bin.lpb, static_cast<size_t>(changeKey->Value.bin.cb));
+	}
+	else
+	{
+		append(&modified->ulPropTag, sizeof(modified->ulPropTag));
+		append(&modified->Value.ft, sizeof(modified->Value.ft));
+	}
+
+	// The tags are short enough to use directly, instead of a hash which might collide.
+	for (size_t i = offset; i < columnCount; ++i)
+	{
+		append(&columns[i].ulPropTag, sizeof(columns[i].ulPropTag));
+	}
+
+	// Some columns change without a new change stamp, e.g. the read flag in PR_MESSAGE_FLAGS or
+	// the PR_CONTENT_COUNT and PR_CONTENT_UNREAD of a folder, so the key also includes a hash of
+	// every value which Property can resolve. The values may be much larger than the tags, so
+	// they are hashed in place instead of copying them into a buffer first.
+	using Hasher = EntryIdIndex<ULONG>;
+
+	auto valuesHash = Hasher::c_hashBasis;
+	const auto appendValue = [&valuesHash](const void* source, size_t size) noexcept {
+		const auto valueSize = static_cast<std::uint32_t>(size);
+
+		valuesHash = Hasher::hash(reinterpret_cast<const std::uint8_t*>(&valueSize),
+			sizeof(valueSize),
+			valuesHash);
+		valuesHash =
+			Hasher::hash(reinterpret_cast<const std::uint8_t*>(source), size, valuesHash);
+	};
+
+	for (size_t i = offset; i < columnCount; ++i)
+	{
+		const auto& value = columns[i].Value;
+
+		switch (PROP_TYPE(columns[i].ulPropTag))
+		{
+			case PT_I2:
+				appendValue(&value.i, sizeof(value.i));
+				break;
+
+			case PT_LONG:
+				appendValue(&value.l, sizeof(value.l));
+				break;
+
+			case PT_I8:
+				appendValue(&value.li, sizeof(value.li));
+				break;
+
+			case PT_BOOLEAN:
+				appendValue(&value.b, sizeof(value.b));
+				break;
+
+			case PT_STRING8:
+				appendValue(value.lpszA, std::strlen(value.lpszA));
+				break;
+
+			case PT_UNICODE:
+				appendValue(value.lpszW, std::wcslen(value.lpszW) * sizeof(wchar_t));
+				break;
+
+			case PT_CLSID:
+				appendValue(value.lpguid, sizeof(*value.lpguid));
+				break;
+
+			case PT_SYSTIME:
+				appendValue(&value.ft, sizeof(value.ft));
+				break;
+
+			case PT_BINARY:
+				appendValue(value.bin.lpb, static_cast<size_t>(value.bin.cb));
+				break;
+
+			default:
+				// Any other type resolves to a null value.
+				break;
+		}
+	}
+
+	append(&valuesHash, sizeof(valuesHash));
+
+	return std::make_optional(std::move(key));
+}
+
+const response::IdType& ColumnFragment::id() const noexcept
+{
+	return m_key;
+}
+
+size_t ColumnFragment::bytes() const noexcept
+{
+	return m_bytes;
+}
+
+const std::vector<std::shared_ptr<object::Property>>& ColumnFragment::columns() const noexcept
+{
+	return m_columns;
+}
+
+} // namespace graphql::mapi
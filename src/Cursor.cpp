@@ -0,0 +1,281 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Cursor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace convert::cursor {
+
+namespace {
+
+constexpr std::uint8_t c_version = 2;
+
+constexpr size_t GetFixedSize(ULONG propType) noexcept
+{
+	switch (propType)
+	{
+		case PT_I2:
+		case PT_BOOLEAN:
+			return 2;
+
+		case PT_LONG:
+		case PT_R4:
+			return 4;
+
+		case PT_DOUBLE:
+		case PT_APPTIME:
+		case PT_CURRENCY:
+		case PT_I8:
+		case PT_SYSTIME:
+			return 8;
+
+		default:
+			return 0;
+	}
+}
+
+bool IsSupported(const SPropValue& prop) noexcept
+{
+	switch (PROP_TYPE(prop.ulPropTag))
+	{
+		case PT_CLSID:
+		case PT_UNICODE:
+		case PT_STRING8:
+		case PT_BINARY:
+		case PT_ERROR:
+			return true;
+
+		default:
+			return GetFixedSize(PROP_TYPE(prop.ulPropTag)) != 0;
+	}
+}
+
+void AppendBytes(std::vector<std::uint8_t>& cursor, const void* data, size_t size)
+{
+	const auto begin = reinterpret_cast<const std::uint8_t*>(data);
+
+	cursor.insert(cursor.end(), begin, begin + size);
+}
+
+void AppendSize(std::vector<std::uint8_t>& cursor, size_t size)
+{
+	const auto value = static_cast<std::uint32_t>(size);
+
+	AppendBytes(cursor, &value, sizeof(value));
+}
+
+class CursorReader
+{
+public:
+	explicit CursorReader(const std::vector<std::uint8_t>& cursor) noexcept
+		: m_cursor { cursor }
+	{
+	}
+
+	void read(void* data, size_t size)
+	{
+		if (size > m_cursor.size() - m_offset)
+		{
+			throw std::invalid_argument("truncated cursor");
+		}
+
+		std::memcpy(data, m_cursor.data() + m_offset, size);
+		m_offset += size;
+	}
+
+	// Read a count of elements, and make sure there is enough data left for all of them before
+	// the caller allocates anything.
+	size_t readCount(size_t elementSize)
+	{
+		std::uint32_t count = 0;
+
+		read(&count, sizeof(count));
+
+		if (static_cast<size_t>(count) > (m_cursor.size() - m_offset) / elementSize)
+		{
+			throw std::invalid_argument("truncated cursor");
+		}
+
+		return static_cast<size_t>(count);
+	}
+
+	bool done() const noexcept
+	{
+		return m_offset == m_cursor.size();
+	}
+
+private:
+	const std::vector<std::uint8_t>& m_cursor;
+	size_t m_offset = 0;
+};
+
+} // namespace
+
+std::vector<std::uint8_t> to_cursor(
+	const SBinary& instanceKey, const SPropValue* sortBegin, const SPropValue* sortEnd)
+{
+	std::vector<std::uint8_t> result;
+	const bool complete = std::all_of(sortBegin, sortEnd, IsSupported);
+
+	result.push_back(c_version);
+	AppendSize(result, static_cast<size_t>(instanceKey.cb));
+	AppendBytes(result, instanceKey.lpb, static_cast<size_t>(instanceKey.cb));
+	AppendSize(result, complete ? static_cast<size_t>(sortEnd - sortBegin) : 0);
+
+	if (!complete)
+	{
+		return result;
+	}
+
+	for (auto prop = sortBegin; prop != sortEnd; ++prop)
+	{
+		const auto propType = PROP_TYPE(prop->ulPropTag);
+
+		AppendBytes(result, &prop->ulPropTag, sizeof(prop->ulPropTag));
+
+		switch (propType)
+		{
+			case PT_CLSID:
+				AppendBytes(result, prop->Value.lpguid, sizeof(*prop->Value.lpguid));
+				break;
+
+			case PT_UNICODE:
+			{
+				const size_t length = wcslen(prop->Value.lpszW);
+
+				AppendSize(result, length);
+				AppendBytes(result, prop->Value.lpszW, length * sizeof(*prop->Value.lpszW));
+				break;
+			}
+
+			case PT_STRING8:
+			{
+				const size_t length = strlen(prop->Value.lpszA);
+
+				AppendSize(result, length);
+				AppendBytes(result, prop->Value.lpszA, length);
+				break;
+			}
+
+			case PT_BINARY:
+				AppendSize(result, static_cast<size_t>(prop->Value.bin.cb));
+				AppendBytes(result, prop->Value.bin.lpb, static_cast<size_t>(prop->Value.bin.cb));
+				break;
+
+			case PT_ERROR:
+				// The row is missing this sort value, the tag is enough to restrict on it.
+				break;
+
+			default:
+				// All of the fixed size types are at the beginning of the union.
+				AppendBytes(result, &prop->Value, GetFixedSize(propType));
+				break;
+		}
+	}
+
+	return result;
+}
+
+Boundary from_cursor(const std::vector<std::uint8_t>& cursor)
+{
+	Boundary result;
+	CursorReader reader { cursor };
+	std::uint8_t version = 0;
+
+	reader.read(&version, sizeof(version));
+
+	if (version != c_version)
+	{
+		throw std::invalid_argument("unsupported cursor version");
+	}
+
+	result.instanceKey.resize(reader.readCount(1));
+	reader.read(result.instanceKey.data(), result.instanceKey.size());
+	result.sortValues.resize(reader.readCount(sizeof(ULONG)));
+
+	for (auto& prop : result.sortValues)
+	{
+		reader.read(&prop.ulPropTag, sizeof(prop.ulPropTag));
+		prop.dwAlignPad = 0;
+
+		const auto propType = PROP_TYPE(prop.ulPropTag);
+
+		switch (propType)
+		{
+			case PT_CLSID:
+			{
+				auto buffer = std::make_unique<std::uint8_t[]>(sizeof(GUID));
+
+				reader.read(buffer.get(), sizeof(GUID));
+				prop.Value.lpguid = reinterpret_cast<LPGUID>(buffer.get());
+				result.buffers.push_back(std::move(buffer));
+				break;
+			}
+
+			case PT_UNICODE:
+			{
+				const size_t length = reader.readCount(sizeof(WCHAR));
+				auto buffer = std::make_unique<std::uint8_t[]>((length + 1) * sizeof(WCHAR));
+
+				reader.read(buffer.get(), length * sizeof(WCHAR));
+				prop.Value.lpszW = reinterpret_cast<LPWSTR>(buffer.get());
+				prop.Value.lpszW[length] = L'\0';
+				result.buffers.push_back(std::move(buffer));
+				break;
+			}
+
+			case PT_STRING8:
+			{
+				const size_t length = reader.readCount(1);
+				auto buffer = std::make_unique<std::uint8_t[]>(length + 1);
+
+				reader.read(buffer.get(), length);
+				prop.Value.lpszA = reinterpret_cast<LPSTR>(buffer.get());
+				prop.Value.lpszA[length] = '\0';
+				result.buffers.push_back(std::move(buffer));
+				break;
+			}
+
+			case PT_BINARY:
+			{
+				const size_t length = reader.readCount(1);
+				auto buffer = std::make_unique<std::uint8_t[]>(std::max<size_t>(1, length));
+
+				reader.read(buffer.get(), length);
+				prop.Value.bin.cb = static_cast<ULONG>(length);
+				prop.Value.bin.lpb = buffer.get();
+				result.buffers.push_back(std::move(buffer));
+				break;
+			}
+
+			case PT_ERROR:
+				prop.Value.err = MAPI_E_NOT_FOUND;
+				break;
+
+			default:
+			{
+				const size_t size = GetFixedSize(propType);
+
+				if (size == 0)
+				{
+					throw std::invalid_argument("unsupported property type in cursor");
+				}
+
+				reader.read(&prop.Value, size);
+				break;
+			}
+		}
+	}
+
+	if (!reader.done())
+	{
+		throw std::invalid_argument("trailing data in cursor");
+	}
+
+	return result;
+}
+
+} // namespace convert::cursor
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <windows.h>
+
+#include <mapidefs.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace convert::cursor {
+
+// The decoded boundary row of a page. The SPropValue pointers refer to the buffers, so this can be
+// moved but not copied.
+struct Boundary
+{
+	std::vector<std::uint8_t> instanceKey;
+	std::vector<SPropValue> sortValues;
+	std::vector<std::unique_ptr<std::uint8_t[]>> buffers;
+};
+
+// Encode PR_INSTANCE_KEY and the sort key values of a row. Missing sort key values are kept as
+// PT_ERROR tags. If any of them have an unsupported type, the cursor only holds the instance key.
+std::vector<std::uint8_t> to_cursor(
+	const SBinary& instanceKey, const SPropValue* sortBegin, const SPropValue* sortEnd);
+
+// Throws std::invalid_argument if the cursor was not created with to_cursor.
+Boundary from_cursor(const std::vector<std::uint8_t>& cursor);
+
+} // namespace convert::cursor
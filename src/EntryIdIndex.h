@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "graphqlservice/GraphQLResponse.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace graphql::mapi {
+
+// Open addressing hash table keyed by entry IDs or instance keys. The bytes of each ID are only
+// hashed once, and the hash is kept next to the ID in its slot, so probing only compares the bytes
+// of IDs with the same hash. Entry IDs from the same store share a long prefix, which makes the
+// lexicographic comparisons in a std::map much more expensive than comparing the hashes.
+template <class Value>
+class EntryIdIndex
+{
+public:
+	static constexpr std::uint64_t c_hashBasis = 14695981039346656037ULL;
+
+	// 64-bit FNV-1a hash of the ID bytes. Pass the result of a previous call as the basis to keep
+	// hashing more bytes, as if they were appended to the first ones.
+	static std::uint64_t hash(
+		const std::uint8_t* bytes, size_t size, std::uint64_t basis = c_hashBasis) noexcept
+	{
+		std::uint64_t result = basis;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			result ^= static_cast<std::uint64_t>(bytes[i]);
+			result *= 1099511628211ULL;
+		}
+
+		return result;
+	}
+
+	static std::uint64_t hash(const response::IdType& id)
+	{
+		return hash(id.data(), id.size());
+	}
+
+	void reserve(size_t count)
+	{
+		size_t capacity = c_minCapacity;
+
+		while (count > capacity / 4 * 3)
+		{
+			capacity *= 2;
+		}
+
+		if (capacity > m_slots.size())
+		{
+			rehash(capacity);
+		}
+	}
+
+	Value* find(const response::IdType& id)
+	{
+		const auto index = findSlot(id, hash(id));
+
+		return index == c_notFound ? nullptr : &m_slots[index].value;
+	}
+
+	const Value* find(const response::IdType& id) const
+	{
+		const auto index = findSlot(id, hash(id));
+
+		return index == c_notFound ? nullptr : &m_slots[index].value;
+	}
+
+	// Like std::map::insert, this returns false and leaves the value alone if the ID is already in
+	// the index.
+	bool insert(const response::IdType& id, Value value)
+	{
+		const auto idHash = hash(id);
+
+		if (findSlot(id, idHash) != c_notFound)
+		{
+			return false;
+		}
+
+		reserve(m_size + 1);
+
+		auto& slot = m_slots[emptySlot(idHash)];
+
+		slot.used = true;
+		slot.hash = idHash;
+		slot.id = id;
+		slot.value = std::move(value);
+		++m_size;
+		m_idBytes += id.size();
+
+		return true;
+	}
+
+	bool erase(const response::IdType& id)
+	{
+		auto index = findSlot(id, hash(id));
+
+		if (index == c_notFound)
+		{
+			return false;
+		}
+
+		// Shift any following entries in the same probe sequence back into the gap, so lookups
+		// never need tombstones to skip over erased slots.
+		const size_t mask = m_slots.size() - 1;
+
+		for (size_t next = (index + 1) & mask; m_slots[next].used; next = (next + 1) & mask)
+		{
+			const size_t ideal = static_cast<size_t>(m_slots[next].hash) & mask;
+			const bool wrapped = next < index;
+			const bool canMove = wrapped ? (ideal <= index && ideal > next)
+										 : (ideal <= index || ideal > next);
+
+			if (canMove)
+			{
+				m_slots[index] = std::move(m_slots[next]);
+				index = next;
+			}
+		}
+
+		m_idBytes -= m_slots[index].id.size();
+		m_slots[index] = Slot {};
+		--m_size;
+
+		return true;
+	}
+
+	void clear() noexcept
+	{
+		m_slots.clear();
+		m_size = 0;
+		m_idBytes = 0;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	// Estimate how much memory the index holds, including the copies of the IDs.
+	size_t bytes() const noexcept
+	{
+		return m_slots.capacity() * sizeof(Slot) + m_idBytes;
+	}
+
+private:
+	struct Slot
+	{
+		bool used = false;
+		std::uint64_t hash = 0;
+		response::IdType id;
+		Value value {};
+	};
+
+	static constexpr size_t c_minCapacity = 16;
+	static constexpr size_t c_notFound = static_cast<size_t>(-1);
+
+	size_t findSlot(const response::IdType& id, std::uint64_t idHash) const
+	{
+		if (m_slots.empty())
+		{
+			return c_notFound;
+		}
+
+		const size_t mask = m_slots.size() - 1;
+
+		for (size_t index = static_cast<size_t>(idHash) & mask; m_slots[index].used;
+			 index = (index + 1) & mask)
+		{
+			if (m_slots[index].hash == idHash && m_slots[index].id == id)
+			{
+				return index;
+			}
+		}
+
+		return c_notFound;
+	}
+
+	size_t emptySlot(std::uint64_t idHash) const noexcept
+	{
+		const size_t mask = m_slots.size() - 1;
+		size_t index = static_cast<size_t>(idHash) & mask;
+
+		while (m_slots[index].used)
+		{
+			index = (index + 1) & mask;
+		}
+
+		return index;
+	}
+
+	// Move every entry to a larger table, reusing the hashes which are already in each slot.
+	void rehash(size_t capacity)
+	{
+		auto slots = std::move(m_slots);
+
+		m_slots = std::vector<Slot>(capacity);
+
+		for (auto& slot : slots)
+		{
+			if (slot.used)
+			{
+				m_slots[emptySlot(slot.hash)] = std::move(slot);
+			}
+		}
+	}
+
+	std::vector<Slot> m_slots;
+	size_t m_size = 0;
+	size_t m_idBytes = 0;
+};
+
+} // namespace graphql::mapi
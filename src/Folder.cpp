@@ -2,58 +2,52 @@
 // Licensed under the MIT License.
 
 #include "Guid.h"
+#include "TableNotifications.h"
 #include "Types.h"
 
+#include "FolderConnectionObject.h"
 #include "FolderObject.h"
+#include "ItemConnectionObject.h"
+#include "ItemGroupObject.h"
 #include "ItemObject.h"
 #include "StoreObject.h"
 
 namespace graphql::mapi {
 
-constexpr ULONG GetColumnPropType(Folder::DefaultColumn column)
+constexpr Folder::Schema c_folderSchema {
+	{
+		PR_INSTANCE_KEY,
+		PR_ENTRYID,
+		PR_PARENT_ENTRYID,
+		PR_DISPLAY_NAME_W,
+		PR_CONTENT_COUNT,
+		PR_CONTENT_UNREAD,
+	},
+	{
+		SSortOrder { PR_DISPLAY_NAME_W, TABLE_SORT_ASCEND },
+	},
+	{
+		std::make_pair(std::string_view { "name" }, Folder::DefaultColumn::Name),
+		std::make_pair(std::string_view { "count" }, Folder::DefaultColumn::Total),
+		std::make_pair(std::string_view { "unread" }, Folder::DefaultColumn::Unread),
+	},
+};
+
+const Folder::Schema& Folder::GetFolderSchema() noexcept
 {
-	return PROP_TYPE(Folder::GetFolderColumns()[static_cast<size_t>(column)]);
+	return c_folderSchema;
 }
 
-static_assert(GetColumnPropType(Folder::DefaultColumn::InstanceKey) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Folder::DefaultColumn::Id) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Folder::DefaultColumn::ParentId) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Folder::DefaultColumn::Name) == PT_UNICODE, "type mismatch");
-static_assert(GetColumnPropType(Folder::DefaultColumn::Total) == PT_LONG, "type mismatch");
-static_assert(GetColumnPropType(Folder::DefaultColumn::Unread) == PT_LONG, "type mismatch");
-
 Folder::Folder(const std::shared_ptr<Store>& store, IMAPIFolder* pFolder, size_t columnCount,
 	mapi_ptr<SPropValue>&& columns)
 	: m_store { store }
 	, m_columnCount { columnCount }
 	, m_columns { std::move(columns) }
-	, m_instanceKey { GetIdColumn(DefaultColumn::InstanceKey) }
-	, m_id { GetIdColumn(DefaultColumn::Id) }
-	, m_parentId { GetIdColumn(DefaultColumn::ParentId) }
-	, m_name { GetStringColumn(DefaultColumn::Name) }
-	, m_count { GetIntColumn(DefaultColumn::Total) }
-	, m_unread { GetIntColumn(DefaultColumn::Unread) }
-	, m_specialFolder { [this]() {
-		// Check if this folder matches a special folder, and re-use the special folder if it does.
-		auto spStore = m_store.lock();
-		const auto& specialFolders = spStore->specialFolders();
-		auto itr = std::find_if(specialFolders.begin(),
-			specialFolders.end(),
-			[this, &spStore](const auto& entry) noexcept {
-				ULONG result = 0;
-
-				return SUCCEEDED(spStore->store()->CompareEntryIDs(static_cast<ULONG>(id().size()),
-						   reinterpret_cast<LPENTRYID>(const_cast<response::IdType&>(id()).data()),
-						   static_cast<ULONG>(entry.second.size()),
-						   reinterpret_cast<LPENTRYID>(
-							   const_cast<response::IdType&>(entry.second).data()),
-						   0,
-						   &result))
-					&& result != 0;
-			});
-
-		return itr == specialFolders.end() ? std::nullopt : std::make_optional(itr->first);
-	}() }
+	, m_instanceKey { GetIdColumn<DefaultColumn::InstanceKey>() }
+	, m_id { GetIdColumn<DefaultColumn::Id>() }
+	, m_parentId { GetIdColumn<DefaultColumn::ParentId>() }
+	, m_count { GetIntColumn<DefaultColumn::Total>() }
+	, m_unread { GetIntColumn<DefaultColumn::Unread>() }
 	, m_folder { pFolder }
 {
 }
@@ -82,9 +76,14 @@ const response::IdType& Folder::id() const
 	return m_id;
 }
 
+const response::IdType& Folder::parentId() const
+{
+	return m_parentId;
+}
+
 const std::string& Folder::name() const
 {
-	return m_name;
+	return *GetStringColumn<DefaultColumn::Name>(m_nameOnce, m_name);
 }
 
 int Folder::count() const
@@ -97,6 +96,76 @@ int Folder::unread() const
 	return m_unread;
 }
 
+size_t Folder::bytes() const noexcept
+{
+	// The cached windows keep their rows alive even after the store evicts them, so count the rows
+	// again here, along with the wrappers they get once they're served and any pages which are
+	// parked on the tables. Sub-folders only count their own columns, they're measured separately.
+	size_t result = columnBytes();
+
+	if (m_subFolders)
+	{
+		result += m_subFolders->capacity() * sizeof(std::shared_ptr<Folder>)
+			+ m_subFolderKeys.bytes() + (m_subFolderIds ? m_subFolderIds->bytes() : 0);
+
+		for (const auto& folder : *m_subFolders)
+		{
+			result += folder->columnBytes() + sizeof(object::Folder);
+		}
+	}
+
+	if (m_items)
+	{
+		result += m_items->capacity() * sizeof(std::shared_ptr<Item>) + m_itemKeys.bytes()
+			+ (m_itemIds ? m_itemIds->bytes() : 0);
+
+		for (const auto& item : *m_items)
+		{
+			result += item->bytes() + sizeof(object::Item);
+		}
+	}
+
+	result += m_subFolderObjects.capacity() * sizeof(std::shared_ptr<object::Folder>)
+		+ m_itemObjects.capacity() * sizeof(std::shared_ptr<object::Item>);
+
+	if (m_subFolderTable)
+	{
+		result += sizeof(TableHandle) + m_subFolderTable->pageBytes();
+	}
+
+	if (m_itemTable)
+	{
+		result += sizeof(TableHandle) + m_itemTable->pageBytes();
+	}
+
+	for (const auto& entry : m_groupTables)
+	{
+		result += sizeof(entry) + sizeof(TableHandle) + entry.second->pageBytes();
+	}
+
+	return result;
+}
+
+size_t Folder::columnBytes() const noexcept
+{
+	// If the name was already decoded, it's a copy of the column value, so count both of them.
+	return sizeof(*this) + GetRowBytes(static_cast<ULONG>(m_columnCount), m_columns.get())
+		+ m_instanceKey.size() + m_id.size() + m_parentId.size() + m_decodedBytes;
+}
+
+void Folder::UpdateCachedBytes() const
+{
+	if (const auto store = m_store.lock())
+	{
+		store->UpdateCachedFolder(*this);
+	}
+}
+
+std::shared_ptr<object::Folder> Folder::object()
+{
+	return m_object.get(shared_from_this());
+}
+
 const CComPtr<IMAPIFolder>& Folder::folder()
 {
 	OpenFolder();
@@ -111,21 +180,28 @@ const std::vector<std::shared_ptr<Folder>>& Folder::subFolders()
 
 std::shared_ptr<Folder> Folder::parentFolder() const
 {
-	return m_parentId == m_id ? nullptr : m_store.lock()->OpenFolder(m_parentId);
+	if (m_parentId == m_id)
+	{
+		return nullptr;
+	}
+
+	// OpenFolder already uses the hierarchy snapshot if it's loaded, but it's not worth reading the
+	// whole hierarchy just to find one parent.
+	return m_store.lock()->OpenFolder(m_parentId);
 }
 
 std::shared_ptr<Folder> Folder::lookupSubFolder(const response::IdType& id)
 {
 	LoadSubFolders({});
 
-	auto itr = m_subFolderIds->find(id);
+	const auto index = m_subFolderIds->find(id);
 
-	if (itr == m_subFolderIds->cend())
+	if (!index)
 	{
 		return nullptr;
 	}
 
-	return m_subFolders->at(itr->second);
+	return m_subFolders->at(*index);
 }
 
 const std::vector<std::shared_ptr<Item>>& Folder::items()
@@ -138,14 +214,14 @@ std::shared_ptr<Item> Folder::lookupItem(const response::IdType& id)
 {
 	LoadItems({});
 
-	auto itr = m_itemIds->find(id);
+	const auto index = m_itemIds->find(id);
 
-	if (itr == m_itemIds->cend())
+	if (!index)
 	{
 		return nullptr;
 	}
 
-	return m_items->at(itr->second);
+	return m_items->at(*index);
 }
 
 const SPropValue& Folder::GetColumnProp(DefaultColumn column) const
@@ -157,9 +233,12 @@ const SPropValue& Folder::GetColumnProp(DefaultColumn column) const
 	return m_columns.get()[index];
 }
 
-response::IdType Folder::GetIdColumn(DefaultColumn column) const
+template <Folder::DefaultColumn Column>
+response::IdType Folder::GetIdColumn() const
 {
-	const auto& idProp = GetColumnProp(column);
+	static_assert(c_folderSchema.propType(Column) == PT_BINARY, "type mismatch");
+
+	const auto& idProp = GetColumnProp(Column);
 
 	if (PROP_TYPE(idProp.ulPropTag) != PT_BINARY)
 	{
@@ -172,21 +251,31 @@ response::IdType Folder::GetIdColumn(DefaultColumn column) const
 	return { idBegin, idEnd };
 }
 
-std::string Folder::GetStringColumn(DefaultColumn column) const
+template <Folder::DefaultColumn Column>
+const std::optional<std::string>& Folder::GetStringColumn(
+	std::once_flag& once, std::optional<std::string>& decoded) const
 {
-	const auto& stringProp = GetColumnProp(column);
+	static_assert(c_folderSchema.propType(Column) == PT_UNICODE, "type mismatch");
 
-	if (PROP_TYPE(stringProp.ulPropTag) != PT_UNICODE)
-	{
-		return {};
-	}
+	std::call_once(once, [this, &decoded]() {
+		const auto& stringProp = GetColumnProp(Column);
 
-	return convert::utf8::to_utf8(stringProp.Value.lpszW);
+		decoded = (PROP_TYPE(stringProp.ulPropTag) == PT_UNICODE)
+			? convert::utf8::to_utf8(stringProp.Value.lpszW)
+			: std::string {};
+		m_decodedBytes += decoded->capacity();
+		UpdateCachedBytes();
+	});
+
+	return decoded;
 }
 
-int Folder::GetIntColumn(DefaultColumn column) const
+template <Folder::DefaultColumn Column>
+int Folder::GetIntColumn() const
 {
-	const auto& intProp = GetColumnProp(column);
+	static_assert(c_folderSchema.propType(Column) == PT_LONG, "type mismatch");
+
+	const auto& intProp = GetColumnProp(Column);
 
 	if (PROP_TYPE(intProp.ulPropTag) != PT_LONG)
 	{
@@ -215,89 +304,182 @@ void Folder::OpenFolder()
 	CFRt(objType == MAPI_FOLDER);
 }
 
-void Folder::LoadSubFolders(service::Directives&& fieldDirectives)
+TableHandle& Folder::subFolderTable()
 {
-	if (m_subFolderDirectives != fieldDirectives)
+	if (!m_subFolderTable)
 	{
-		// Reset the subFolders and reload if the directives change
-		m_subFolders.reset();
-		m_subFolderDirectives = std::move(fieldDirectives);
-	}
+		CComPtr<IMAPITable> sptable;
 
-	if (m_subFolders)
-	{
-		return;
+		CORt(folder()->GetHierarchyTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
+
+		auto spThis = shared_from_this();
+		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
+		ULONG_PTR connectionId = 0;
+
+		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>([wpStore = m_store,
+															 wpFolder = std::weak_ptr { spThis }](
+															 size_t count,
+															 LPNOTIFICATION pNotifications) {
+			auto spStore = wpStore.lock();
+
+			if (spStore)
+			{
+				spStore->QueueNotifications(count,
+					pNotifications,
+					[wpFolder](Store&, size_t count, LPNOTIFICATION pNotifications) {
+						auto spFolder = wpFolder.lock();
+
+						if (spFolder)
+						{
+							spFolder->ApplySubFolderNotifications(count, pNotifications);
+						}
+					});
+			}
+		}));
+
+		CORt(sptable->Advise(fnevTableModified, sinkProxy, &connectionId));
+		sinkProxy->OnAdvise(sptable, connectionId);
+
+		m_subFolderSink = sinkProxy;
+		m_subFolderTable = std::make_unique<TableHandle>(sptable);
 	}
 
-	m_subFolderIds = std::make_unique<std::map<response::IdType, size_t>>();
-	m_subFolders = std::make_unique<std::vector<std::shared_ptr<Folder>>>();
+	return *m_subFolderTable;
+}
 
-	constexpr auto c_folderProps = GetFolderColumns();
-	mapi_ptr<SPropTagArray> folderProps;
+TableHandle& Folder::itemTable()
+{
+	if (!m_itemTable)
+	{
+		CComPtr<IMAPITable> sptable;
 
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_folderProps.size()),
-		reinterpret_cast<void**>(&out_ptr { folderProps })));
-	CFRt(folderProps != nullptr);
-	folderProps->cValues = static_cast<ULONG>(c_folderProps.size());
-	std::copy(c_folderProps.begin(), c_folderProps.end(), folderProps->aulPropTag);
+		CORt(folder()->GetContentsTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
 
-	constexpr auto c_folderSorts = GetFolderSorts();
-	mapi_ptr<SSortOrderSet> folderSorts;
+		auto spThis = shared_from_this();
+		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
+		ULONG_PTR connectionId = 0;
 
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_folderSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { folderSorts })));
-	CFRt(folderSorts != nullptr);
-	folderSorts->cSorts = static_cast<ULONG>(c_folderSorts.size());
-	folderSorts->cCategories = 0;
-	folderSorts->cExpanded = 0;
-	std::copy(c_folderSorts.begin(), c_folderSorts.end(), folderSorts->aSort);
+		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>([wpStore = m_store,
+															 wpFolder = std::weak_ptr { spThis }](
+															 size_t count,
+															 LPNOTIFICATION pNotifications) {
+			auto spStore = wpStore.lock();
+
+			if (spStore)
+			{
+				spStore->QueueNotifications(count,
+					pNotifications,
+					[wpFolder](Store&, size_t count, LPNOTIFICATION pNotifications) {
+						auto spFolder = wpFolder.lock();
+
+						if (spFolder)
+						{
+							spFolder->ApplyItemNotifications(count, pNotifications);
+						}
+					});
+			}
+		}));
 
-	auto store = m_store.lock();
-	const TableDirectives directives { store, m_subFolderDirectives };
-	CComPtr<IMAPITable> sptable;
+		CORt(sptable->Advise(fnevTableModified, sinkProxy, &connectionId));
+		sinkProxy->OnAdvise(sptable, connectionId);
 
-	CORt(folder()->GetHierarchyTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
+		m_itemSink = sinkProxy;
+		m_itemTable = std::make_unique<TableHandle>(sptable);
+	}
 
-	const rowset_ptr sprows =
-		directives.read(sptable, std::move(folderProps), std::move(folderSorts));
+	return *m_itemTable;
+}
 
-	m_subFolders->reserve(static_cast<size_t>(sprows->cRows));
-	for (ULONG i = 0; i != sprows->cRows; i++)
+std::shared_ptr<TableHandle> Folder::groupTable(const TableDirectives& directives)
+{
+	// Re-sorting a categorized view invalidates the instance keys of its headings, so each distinct
+	// view gets its own table, and each ItemGroup holds on to the table it came from. Only the most
+	// recently used views stay open on the folder.
+	constexpr size_t c_groupTableLimit = 4;
+	const auto& key = directives.viewKey();
+	auto itr = std::find_if(m_groupTables.begin(), m_groupTables.end(), [&key](const auto& entry) {
+		return entry.first == key;
+	});
+
+	if (itr == m_groupTables.end())
 	{
-		auto& row = sprows->aRow[i];
-		const size_t columnCount = static_cast<size_t>(row.cValues);
-		mapi_ptr<SPropValue> columns { row.lpProps };
+		// Keep the categorized view on a separate table, so switching between items and itemGroups
+		// doesn't re-sort the item table every time. Nothing is cached from this table, so it
+		// doesn't need to Advise for changes either.
+		CComPtr<IMAPITable> sptable;
 
-		row.lpProps = nullptr;
+		CORt(folder()->GetContentsTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
 
-		auto folder = std::make_shared<Folder>(store, nullptr, columnCount, std::move(columns));
+		if (m_groupTables.size() >= c_groupTableLimit)
+		{
+			m_groupTables.pop_back();
+		}
+
+		m_groupTables.emplace_back(service::Directives {}, std::make_shared<TableHandle>(sptable));
+
+		auto& entry = m_groupTables.back();
+
+		for (const auto& [name, arguments] : key)
+		{
+			entry.first.emplace_back(name, response::Value { arguments });
+		}
+
+		itr = std::prev(m_groupTables.end());
+	}
+
+	// Move the most recently used view to the front.
+	std::rotate(m_groupTables.begin(), itr, std::next(itr));
+
+	return m_groupTables.front().second;
+}
 
-		store->CacheFolder(folder);
-		m_subFolderIds->insert(std::make_pair(folder->id(), m_subFolders->size()));
-		m_subFolders->push_back(std::move(folder));
+void Folder::LoadSubFolders(service::Directives&& fieldDirectives)
+{
+	if (m_subFolderDirectives != fieldDirectives)
+	{
+		// Reset the subFolders and reload if the directives change
+		m_subFolders.reset();
+		m_subFolderDirectives = std::move(fieldDirectives);
 	}
 
-	if (!m_subFolderSink)
+	if (m_subFolders)
 	{
-		auto spThis = shared_from_this();
-		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
-		ULONG_PTR connectionId = 0;
+		return;
+	}
 
-		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>(
-			[wpFolder = std::weak_ptr { spThis }](size_t, LPNOTIFICATION) {
-				auto spFolder = wpFolder.lock();
+	m_subFolderIds = std::make_unique<EntryIdIndex<size_t>>();
+	m_subFolders = std::make_unique<std::vector<std::shared_ptr<Folder>>>();
+	m_subFolderKeys.clear();
 
-				if (spFolder)
-				{
-					spFolder->m_subFolders.reset();
-				}
-			}));
+	const auto& schema = GetFolderSchema();
+	auto store = m_store.lock();
+	const TableDirectives directives { store, m_subFolderDirectives };
+	TagBuffer selected;
 
-		CORt(sptable->Advise(fnevTableModified, sinkProxy, &connectionId));
-		sinkProxy->OnAdvise(sptable, connectionId);
+	directives.enumerate(subFolderTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-		m_subFolderSink = sinkProxy;
-	}
+			row.lpProps = nullptr;
+
+			auto folder = std::make_shared<Folder>(store, nullptr, columnCount, std::move(columns));
+
+			if (!directives.projected())
+			{
+				// Only cache complete folders, projected rows are missing some columns.
+				store->CacheFolder(folder);
+			}
+
+			m_subFolderIds->insert(folder->id(), m_subFolders->size());
+			m_subFolderKeys.push_back(folder->instanceKey());
+			m_subFolders->push_back(std::move(folder));
+		});
+
+	m_subFolderWindow = directives.window(subFolderTable(), m_subFolders->size());
+	UpdateCachedBytes();
 }
 
 void Folder::LoadItems(service::Directives&& fieldDirectives)
@@ -314,74 +496,315 @@ void Folder::LoadItems(service::Directives&& fieldDirectives)
 		return;
 	}
 
-	m_itemIds = std::make_unique<std::map<response::IdType, size_t>>();
+	m_itemIds = std::make_unique<EntryIdIndex<size_t>>();
 	m_items = std::make_unique<std::vector<std::shared_ptr<Item>>>();
+	m_itemKeys.clear();
 
-	constexpr auto c_itemProps = Item::GetItemColumns();
-	mapi_ptr<SPropTagArray> itemProps;
+	const auto& schema = Item::GetItemSchema();
+	auto store = m_store.lock();
+	const TableDirectives directives { store, m_itemDirectives };
+	TagBuffer selected;
 
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_itemProps.size()),
-		reinterpret_cast<void**>(&out_ptr { itemProps })));
-	CFRt(itemProps != nullptr);
-	itemProps->cValues = static_cast<ULONG>(c_itemProps.size());
-	std::copy(c_itemProps.begin(), c_itemProps.end(), itemProps->aulPropTag);
+	directives.enumerate(itemTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-	constexpr auto c_itemSorts = Item::GetItemSorts();
-	mapi_ptr<SSortOrderSet> itemSorts;
+			row.lpProps = nullptr;
 
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_itemSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { itemSorts })));
-	CFRt(itemSorts != nullptr);
-	itemSorts->cSorts = static_cast<ULONG>(c_itemSorts.size());
-	itemSorts->cCategories = 0;
-	itemSorts->cExpanded = 0;
-	std::copy(c_itemSorts.begin(), c_itemSorts.end(), itemSorts->aSort);
+			auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
 
-	auto store = m_store.lock();
-	const TableDirectives directives { store, m_itemDirectives };
-	CComPtr<IMAPITable> sptable;
+			if (!directives.projected())
+			{
+				// Only cache complete items, projected rows are missing some columns.
+				store->CacheItem(item);
+			}
 
-	CORt(folder()->GetContentsTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
+			m_itemIds->insert(item->id(), m_items->size());
+			m_itemKeys.push_back(item->instanceKey());
+			m_items->push_back(std::move(item));
+		});
 
-	const rowset_ptr sprows = directives.read(sptable, std::move(itemProps), std::move(itemSorts));
+	m_itemWindow = directives.window(itemTable(), m_items->size());
+	UpdateCachedBytes();
+}
 
-	m_items->reserve(static_cast<size_t>(sprows->cRows));
-	for (ULONG i = 0; i != sprows->cRows; i++)
+void Folder::ApplySubFolderNotifications(size_t count, LPNOTIFICATION pNotifications)
+{
+	if (m_subFolderTable)
 	{
-		auto& row = sprows->aRow[i];
+		// Any pages which were read ahead are also stale now.
+		m_subFolderTable->discardPages();
+	}
+
+	if (m_subFolders)
+	{
+		if (!m_subFolderTable || m_subFolderTable->version() != m_subFolderWindow.tableVersion
+			|| !ApplyTableNotifications(m_store.lock(),
+				m_subFolderWindow,
+				*m_subFolders,
+				m_subFolderKeys,
+				count,
+				pNotifications,
+				&Store::CacheFolder))
+		{
+			// Read the whole window again the next time it's needed.
+			m_subFolders.reset();
+		}
+		else
+		{
+			m_subFolderIds = IndexRows(*m_subFolders);
+		}
+	}
+
+	UpdateCachedBytes();
+}
+
+void Folder::ApplyItemNotifications(size_t count, LPNOTIFICATION pNotifications)
+{
+	if (m_itemTable)
+	{
+		// Any pages which were read ahead are also stale now.
+		m_itemTable->discardPages();
+	}
+
+	if (m_items)
+	{
+		if (!m_itemTable || m_itemTable->version() != m_itemWindow.tableVersion
+			|| !ApplyTableNotifications(m_store.lock(),
+				m_itemWindow,
+				*m_items,
+				m_itemKeys,
+				count,
+				pNotifications,
+				&Store::CacheItem))
+		{
+			// Read the whole window again the next time it's needed.
+			m_items.reset();
+		}
+		else
+		{
+			m_itemIds = IndexRows(*m_items);
+		}
+	}
+
+	UpdateCachedBytes();
+}
+
+template <class T>
+bool Folder::ApplyTableNotifications(const std::shared_ptr<Store>& store, TableWindow& window,
+	std::vector<std::shared_ptr<T>>& rows, InstanceKeyColumn& keys, size_t count,
+	LPNOTIFICATION pNotifications, void (Store::*cacheRow)(const std::shared_ptr<T>&))
+{
+	if (!store || nullptr == pNotifications)
+	{
+		return false;
+	}
+
+	const auto makeRow = [&store, &window, cacheRow](const SRow& row) {
 		const size_t columnCount = static_cast<size_t>(row.cValues);
-		mapi_ptr<SPropValue> columns { row.lpProps };
+		mapi_ptr<SPropValue> columns;
 
-		row.lpProps = nullptr;
+		CORt(ScDupPropset(row.cValues, row.lpProps, ::MAPIAllocateBuffer, &out_ptr { columns }));
+		CFRt(columns != nullptr);
 
-		auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
+		auto object = std::make_shared<T>(store, nullptr, columnCount, std::move(columns));
 
-		store->CacheItem(item);
-		m_itemIds->insert({ item->id(), m_items->size() });
-		m_items->push_back(std::move(item));
+		if (!window.projected)
+		{
+			// Only cache complete objects, projected rows are missing some columns.
+			(store.get()->*cacheRow)(object);
+		}
+
+		return object;
+	};
+
+	// The cached window is read directly, so it doesn't need to know which rows changed.
+	const auto ignoreChange = [](RowChange, size_t, const std::shared_ptr<T>&) noexcept {
+	};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!ApplyTableNotification(pNotifications[i],
+				window,
+				rows,
+				keys,
+				makeRow,
+				ignoreChange))
+		{
+			return false;
+		}
 	}
 
-	if (!m_itemSink)
+	return true;
+}
+
+template <class T>
+std::unique_ptr<EntryIdIndex<size_t>> Folder::IndexRows(const std::vector<std::shared_ptr<T>>& rows)
+{
+	auto result = std::make_unique<EntryIdIndex<size_t>>();
+
+	result->reserve(rows.size());
+
+	for (size_t i = 0; i < rows.size(); ++i)
 	{
-		auto spThis = shared_from_this();
-		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
-		ULONG_PTR connectionId = 0;
+		result->insert(rows[i]->id(), i);
+	}
 
-		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>(
-			[wpFolder = std::weak_ptr { spThis }](size_t, LPNOTIFICATION) {
-				auto spFolder = wpFolder.lock();
+	return result;
+}
 
-				if (spFolder)
-				{
-					spFolder->m_items.reset();
-				}
-			}));
+template <class T>
+auto Folder::StreamRows(const std::shared_ptr<Store>& store, TableHandle& table,
+	const typename T::Schema& schema, const TableDirectives& directives,
+	const std::optional<std::vector<response::IdType>>& ids)
+	-> std::vector<decltype(std::declval<T&>().object())>
+{
+	std::vector<decltype(std::declval<T&>().object())> result;
+	EntryIdIndex<size_t> positions;
+	TagBuffer selected;
 
-		CORt(sptable->Advise(fnevTableModified, sinkProxy, &connectionId));
-		sinkProxy->OnAdvise(sptable, connectionId);
+	if (ids)
+	{
+		result.resize(ids->size());
+		positions.reserve(ids->size());
 
-		m_itemSink = sinkProxy;
+		for (size_t i = 0; i < ids->size(); ++i)
+		{
+			positions.insert((*ids)[i], i);
+		}
 	}
+
+	directives.enumerate(table,
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
+
+			row.lpProps = nullptr;
+
+			auto object = std::make_shared<T>(store, nullptr, columnCount, std::move(columns));
+
+			if (!ids)
+			{
+				result.push_back(object->object());
+			}
+			else if (const auto position = positions.find(object->id()))
+			{
+				result[*position] = object->object();
+			}
+		});
+
+	return result;
+}
+
+bool Folder::LoadSubFoldersPage(const TableDirectives& directives,
+	std::optional<response::IdType>&& after, std::vector<std::shared_ptr<FolderEdge>>& edges)
+{
+	const auto& schema = GetFolderSchema();
+	auto store = m_store.lock();
+	TagBuffer selected;
+
+	const bool hasNextPage = directives.paginate(subFolderTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		std::move(after),
+		[&](SRow& row, response::IdType&& cursor) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
+
+			row.lpProps = nullptr;
+
+			auto folder = std::make_shared<Folder>(store, nullptr, columnCount, std::move(columns));
+
+			if (!directives.projected())
+			{
+				// Only cache complete folders, projected rows are missing some columns.
+				store->CacheFolder(folder);
+			}
+
+			edges.push_back(std::make_shared<FolderEdge>(folder, std::move(cursor)));
+		});
+
+	// Any rows which were read ahead are parked on the table now.
+	UpdateCachedBytes();
+
+	return hasNextPage;
+}
+
+bool Folder::LoadItemsPage(const TableDirectives& directives,
+	std::optional<response::IdType>&& after, std::vector<std::shared_ptr<ItemEdge>>& edges)
+{
+	const auto& schema = Item::GetItemSchema();
+	auto store = m_store.lock();
+	TagBuffer selected;
+
+	const bool hasNextPage = directives.paginate(itemTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		std::move(after),
+		[&](SRow& row, response::IdType&& cursor) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
+
+			row.lpProps = nullptr;
+
+			auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
+
+			if (!directives.projected())
+			{
+				// Only cache complete items, projected rows are missing some columns.
+				store->CacheItem(item);
+			}
+
+			edges.push_back(std::make_shared<ItemEdge>(item, std::move(cursor)));
+		});
+
+	// Any rows which were read ahead are parked on the table now.
+	UpdateCachedBytes();
+
+	return hasNextPage;
+}
+
+std::vector<std::shared_ptr<Item>> Folder::LoadGroupItems(TableHandle& table,
+	const TableDirectives& directives, const response::IdType& instanceKey,
+	const service::Directives& fieldDirectives)
+{
+	const auto& schema = Item::GetItemSchema();
+	auto store = m_store.lock();
+	const TableDirectives itemDirectives { store, fieldDirectives };
+	TagBuffer selected;
+	std::vector<std::shared_ptr<Item>> result;
+
+	directives.expand(table,
+		itemDirectives.select(schema, selected),
+		&schema.sorts(),
+		instanceKey,
+		itemDirectives,
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
+
+			row.lpProps = nullptr;
+
+			auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
+
+			if (!itemDirectives.projected())
+			{
+				// Only cache complete items, projected rows are missing some columns.
+				store->CacheItem(item);
+			}
+
+			result.push_back(std::move(item));
+		});
+
+	// The group table may have been opened or parked pages since the folder was measured.
+	UpdateCachedBytes();
+
+	return result;
 }
 
 const response::IdType& Folder::getId() const
@@ -391,17 +814,19 @@ const response::IdType& Folder::getId() const
 
 std::shared_ptr<object::Folder> Folder::getParentFolder() const
 {
-	return std::make_shared<object::Folder>(parentFolder());
+	auto folder = parentFolder();
+
+	return folder ? folder->object() : nullptr;
 }
 
 std::shared_ptr<object::Store> Folder::getStore() const
 {
-	return std::make_shared<object::Store>(m_store.lock());
+	return m_store.lock()->object();
 }
 
 const std::string& Folder::getName() const
 {
-	return m_name;
+	return name();
 }
 
 int Folder::getCount() const
@@ -416,16 +841,20 @@ int Folder::getUnread() const
 
 std::optional<SpecialFolder> Folder::getSpecialFolder() const
 {
-	return m_specialFolder;
+	return m_store.lock()->classifySpecialFolder(m_id);
 }
 
-std::vector<std::shared_ptr<object::Property>> Folder::getColumns() const
+std::vector<std::shared_ptr<object::Property>> Folder::getColumns(
+	service::FieldParams&& params) const
 {
 	auto store = m_store.lock();
 	const auto offset = static_cast<size_t>(DefaultColumn::Count);
 
-	CFRt(m_columnCount >= offset);
-	return { store->GetColumns(m_columnCount - offset, m_columns.get() + offset) };
+	return store->GetColumnFragment(m_id,
+		m_columnCount,
+		m_columns.get(),
+		offset,
+		GetRequestArena(params));
 }
 
 std::vector<std::shared_ptr<object::Folder>> Folder::getSubFolders(
@@ -433,6 +862,50 @@ std::vector<std::shared_ptr<object::Folder>> Folder::getSubFolders(
 {
 	std::vector<std::shared_ptr<object::Folder>> result {};
 
+	if (idsArg && params.fieldDirectives.empty())
+	{
+		// Without any directives, the folders with the specified IDs can come from the hierarchy
+		// snapshot. Fall back to the table for any IDs which aren't in the snapshot.
+		auto store = m_store.lock();
+		auto spThis = shared_from_this();
+
+		result.resize(idsArg->size());
+		std::transform(idsArg->cbegin(),
+			idsArg->cend(),
+			result.begin(),
+			[this, &store, &spThis](const response::IdType& id) {
+				auto folder = store->lookupHierarchyChild(spThis, id);
+
+				if (!folder)
+				{
+					folder = lookupSubFolder(id);
+				}
+
+				return folder ? folder->object() : nullptr;
+			});
+
+		return result;
+	}
+
+	auto store = m_store.lock();
+
+	if (params.fieldDirectives.empty())
+	{
+		// Without any directives, the children in the hierarchy snapshot are already in the default
+		// order, so this folder doesn't need to open its own hierarchy table.
+		if (auto children = store->lookupHierarchyChildren(*this))
+		{
+			return WrapRows(*children, m_subFolderObjects);
+		}
+	}
+
+	const TableDirectives directives { store, params.fieldDirectives };
+
+	if (directives.streamed())
+	{
+		return StreamRows<Folder>(store, subFolderTable(), GetFolderSchema(), directives, idsArg);
+	}
+
 	LoadSubFolders(std::move(params.fieldDirectives));
 
 	if (idsArg)
@@ -443,24 +916,39 @@ std::vector<std::shared_ptr<object::Folder>> Folder::getSubFolders(
 			idsArg->cend(),
 			result.begin(),
 			[this](const response::IdType& id) noexcept {
-				return std::make_shared<object::Folder>(lookupSubFolder(id));
+				auto folder = lookupSubFolder(id);
+
+				return folder ? folder->object() : nullptr;
 			});
 	}
 	else
 	{
-		// Just clone the entire vector of folders.
-		result.resize(m_subFolders->size());
-		std::transform(m_subFolders->cbegin(),
-			m_subFolders->cend(),
-			result.begin(),
-			[this](const std::shared_ptr<Folder>& folder) noexcept {
-				return std::make_shared<object::Folder>(folder);
-			});
+		// Reuse the wrappers we returned for the same folders last time.
+		result = WrapRows(*m_subFolders, m_subFolderObjects);
 	}
 
 	return result;
 }
 
+std::shared_ptr<object::FolderConnection> Folder::getSubFoldersConnection(
+	service::FieldParams&& params, std::optional<response::IdType>&& afterArg)
+{
+	// Pages are not cached on the folder, but they share the folder's open table. The rows are only
+	// read if the edges or pageInfo are selected.
+	auto directives =
+		std::make_shared<const TableDirectives>(m_store.lock(), params.fieldDirectives);
+	auto spThis = shared_from_this();
+
+	return std::make_shared<object::FolderConnection>(std::make_shared<FolderConnection>(
+		[spThis, directives]() {
+			return static_cast<int>(directives->count(spThis->subFolderTable()));
+		},
+		[spThis, directives, after = std::move(afterArg)](
+			std::vector<std::shared_ptr<FolderEdge>>& edges) mutable {
+			return spThis->LoadSubFoldersPage(*directives, std::move(after), edges);
+		}));
+}
+
 std::vector<std::shared_ptr<object::Conversation>> Folder::getConversations(
 	service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg)
 {
@@ -472,6 +960,13 @@ std::vector<std::shared_ptr<object::Item>> Folder::getItems(
 	service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg)
 {
 	std::vector<std::shared_ptr<object::Item>> result {};
+	auto store = m_store.lock();
+	const TableDirectives directives { store, params.fieldDirectives };
+
+	if (directives.streamed())
+	{
+		return StreamRows<Item>(store, itemTable(), Item::GetItemSchema(), directives, idsArg);
+	}
 
 	LoadItems(std::move(params.fieldDirectives));
 
@@ -483,22 +978,100 @@ std::vector<std::shared_ptr<object::Item>> Folder::getItems(
 			idsArg->cend(),
 			result.begin(),
 			[this](const response::IdType& id) noexcept {
-				return std::make_shared<object::Item>(lookupItem(id));
+				auto item = lookupItem(id);
+
+				return item ? item->object() : nullptr;
 			});
 	}
 	else
 	{
-		// Just clone the entire vector of items.
-		result.resize(m_items->size());
-		std::transform(m_items->cbegin(),
-			m_items->cend(),
-			result.begin(),
-			[this](const std::shared_ptr<Item>& item) noexcept {
-				return std::make_shared<object::Item>(item);
-			});
+		// Reuse the wrappers we returned for the same items last time.
+		result = WrapRows(*m_items, m_itemObjects);
 	}
 
 	return result;
 }
 
+std::shared_ptr<object::ItemConnection> Folder::getItemsConnection(
+	service::FieldParams&& params, std::optional<response::IdType>&& afterArg)
+{
+	// Pages are not cached on the folder, but they share the folder's open table. The rows are only
+	// read if the edges or pageInfo are selected.
+	auto directives =
+		std::make_shared<const TableDirectives>(m_store.lock(), params.fieldDirectives);
+	auto spThis = shared_from_this();
+
+	return std::make_shared<object::ItemConnection>(std::make_shared<ItemConnection>(
+		[spThis, directives]() {
+			return static_cast<int>(directives->count(spThis->itemTable()));
+		},
+		[spThis, directives, after = std::move(afterArg)](
+			std::vector<std::shared_ptr<ItemEdge>>& edges) mutable {
+			return spThis->LoadItemsPage(*directives, std::move(after), edges);
+		}));
+}
+
+std::vector<std::shared_ptr<object::ItemGroup>> Folder::getItemGroups(
+	service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg)
+{
+	// The headings are not cached on the folder, and the items in each category are only read if
+	// they are selected on that ItemGroup.
+	auto store = m_store.lock();
+	auto directives = std::make_shared<const TableDirectives>(store, params.fieldDirectives);
+	auto spThis = shared_from_this();
+	const auto arena = GetRequestArena(params);
+	const auto table = groupTable(*directives);
+	std::vector<std::shared_ptr<object::ItemGroup>> result;
+
+	directives->groups(*table, &Item::GetItemSchema().sorts(), [&](SRow& row) {
+		constexpr auto c_headingColumns =
+			static_cast<size_t>(TableDirectives::HeadingColumn::Count);
+
+		CFRt(static_cast<size_t>(row.cValues) == c_headingColumns);
+
+		const auto& instanceKeyProp =
+			row.lpProps[static_cast<size_t>(TableDirectives::HeadingColumn::InstanceKey)];
+
+		CFRt(PROP_TYPE(instanceKeyProp.ulPropTag) == PT_BINARY);
+
+		response::IdType id(instanceKeyProp.Value.bin.lpb,
+			instanceKeyProp.Value.bin.lpb + instanceKeyProp.Value.bin.cb);
+
+		if (idsArg && std::find(idsArg->cbegin(), idsArg->cend(), id) == idsArg->cend())
+		{
+			return;
+		}
+
+		const auto getIntColumn = [&row](TableDirectives::HeadingColumn column) noexcept {
+			const auto& prop = row.lpProps[static_cast<size_t>(column)];
+
+			return PROP_TYPE(prop.ulPropTag) == PT_LONG ? static_cast<int>(prop.Value.l) : 0;
+		};
+		const int count = getIntColumn(TableDirectives::HeadingColumn::ContentCount);
+		const int unread = getIntColumn(TableDirectives::HeadingColumn::ContentUnread);
+		auto values = store->GetColumns(1,
+			&row.lpProps[static_cast<size_t>(TableDirectives::HeadingColumn::Category)],
+			arena);
+
+		CFRt(values.size() == 1);
+
+		auto instanceKey = id;
+
+		result.push_back(std::make_shared<object::ItemGroup>(
+			std::make_shared<ItemGroup>(std::move(id),
+				std::move(values.front()),
+				count,
+				unread,
+				[spThis, table, directives, instanceKey = std::move(instanceKey)](
+					const service::Directives& fieldDirectives) {
+					return spThis->LoadGroupItems(*table,
+						*directives,
+						instanceKey,
+						fieldDirectives);
+				})));
+	});
+
+	return result;
+}
+
 } // namespace graphql::mapi
\ No newline at end of file
@@ -21,7 +21,7 @@ int FolderAdded::getIndex() const
 
 std::shared_ptr<object::Folder> FolderAdded::getAdded() const
 {
-	return std::make_shared<object::Folder>(m_added);
+	return m_added->object();
 }
 
 } // namespace graphql::mapi
\ No newline at end of file
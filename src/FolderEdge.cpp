@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include "FolderObject.h"
+
+namespace graphql::mapi {
+
+FolderEdge::FolderEdge(const std::shared_ptr<Folder>& node, response::IdType&& cursor)
+	: m_node { node }
+	, m_cursor { std::move(cursor) }
+{
+}
+
+const response::IdType& FolderEdge::getCursor() const
+{
+	return m_cursor;
+}
+
+std::shared_ptr<object::Folder> FolderEdge::getNode() const
+{
+	return m_node->object();
+}
+
+} // namespace graphql::mapi
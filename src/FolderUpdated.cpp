@@ -21,7 +21,7 @@ int FolderUpdated::getIndex() const
 
 std::shared_ptr<object::Folder> FolderUpdated::getUpdated() const
 {
-	return std::make_shared<object::Folder>(m_updated);
+	return m_updated->object();
 }
 
 } // namespace graphql::mapi
\ No newline at end of file
@@ -21,7 +21,7 @@ std::vector<std::shared_ptr<object::Folder>> FoldersReloaded::getReloaded() cons
 		m_reloaded.cend(),
 		result.begin(),
 		[](const std::shared_ptr<Folder>& folder) noexcept {
-			return std::make_shared<object::Folder>(folder);
+			return folder->object();
 		});
 
 	return result;
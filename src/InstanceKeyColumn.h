@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "EntryIdIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace graphql::mapi {
+
+// The instance keys of a window of table rows, in the same order as the rows. Table notifications
+// find rows by PR_INSTANCE_KEY, so this keeps the hash, offset and size of each key in one
+// contiguous array, and the bytes of every key in one shared buffer. Finding a row is a linear scan
+// over the hashes, which doesn't need to visit each row object or copy the key from the
+// notification.
+class InstanceKeyColumn
+{
+public:
+	// Returns size() if the key is not in the window.
+	size_t find(const std::uint8_t* key, size_t size) const
+	{
+		const auto keyHash = EntryIdIndex<size_t>::hash(key, size);
+
+		for (size_t index = 0; index < m_entries.size(); ++index)
+		{
+			const auto& entry = m_entries[index];
+
+			if (entry.hash == keyHash && entry.size == size
+				&& std::memcmp(m_bytes.data() + entry.offset, key, size) == 0)
+			{
+				return index;
+			}
+		}
+
+		return m_entries.size();
+	}
+
+	size_t find(const response::IdType& key) const
+	{
+		return find(key.data(), key.size());
+	}
+
+	void insert(size_t index, const response::IdType& key)
+	{
+		const Entry entry { EntryIdIndex<size_t>::hash(key), m_bytes.size(), key.size() };
+
+		m_bytes.insert(m_bytes.end(), key.cbegin(), key.cend());
+		m_entries.insert(m_entries.begin() + static_cast<std::ptrdiff_t>(index), entry);
+	}
+
+	void push_back(const response::IdType& key)
+	{
+		insert(m_entries.size(), key);
+	}
+
+	void erase(size_t index)
+	{
+		m_unused += m_entries[index].size;
+		m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(index));
+
+		// The buffer only grows as rows are added, so compact it once most of it is unused.
+		if (m_unused > m_bytes.size() / 2)
+		{
+			compact();
+		}
+	}
+
+	void pop_back()
+	{
+		erase(m_entries.size() - 1);
+	}
+
+	void reserve(size_t count)
+	{
+		m_entries.reserve(count);
+	}
+
+	void clear() noexcept
+	{
+		m_entries.clear();
+		m_bytes.clear();
+		m_unused = 0;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	size_t bytes() const noexcept
+	{
+		return m_entries.capacity() * sizeof(Entry) + m_bytes.capacity();
+	}
+
+private:
+	struct Entry
+	{
+		std::uint64_t hash = 0;
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	void compact()
+	{
+		std::vector<std::uint8_t> bytes;
+
+		bytes.reserve(m_bytes.size() - m_unused);
+
+		for (auto& entry : m_entries)
+		{
+			const auto begin = m_bytes.cbegin() + static_cast<std::ptrdiff_t>(entry.offset);
+
+			entry.offset = bytes.size();
+			bytes.insert(bytes.end(), begin, begin + static_cast<std::ptrdiff_t>(entry.size));
+		}
+
+		m_bytes = std::move(bytes);
+		m_unused = 0;
+	}
+
+	std::vector<Entry> m_entries;
+	std::vector<std::uint8_t> m_bytes;
+	size_t m_unused = 0;
+};
+
+} // namespace graphql::mapi
@@ -8,42 +8,55 @@
 #include "ConversationObject.h"
 #include "FileAttachmentObject.h"
 #include "FolderObject.h"
+#include "ItemObject.h"
 
 namespace graphql::mapi {
 
-constexpr ULONG GetColumnPropType(Item::DefaultColumn column)
+constexpr Item::Schema c_itemSchema {
+	{
+		PR_INSTANCE_KEY,
+		PR_ENTRYID,
+		PR_PARENT_ENTRYID,
+		PR_SUBJECT_W,
+		PR_SENDER_NAME_W,
+		PR_DISPLAY_TO_W,
+		PR_DISPLAY_CC_W,
+		PR_MESSAGE_FLAGS,
+		PR_MESSAGE_DELIVERY_TIME,
+		PR_LAST_MODIFICATION_TIME,
+		PR_BODY_W,
+	},
+	{
+		SSortOrder { PR_MESSAGE_DELIVERY_TIME, TABLE_SORT_DESCEND },
+	},
+	{
+		std::make_pair(std::string_view { "subject" }, Item::DefaultColumn::Subject),
+		std::make_pair(std::string_view { "sender" }, Item::DefaultColumn::Sender),
+		std::make_pair(std::string_view { "to" }, Item::DefaultColumn::To),
+		std::make_pair(std::string_view { "cc" }, Item::DefaultColumn::Cc),
+		std::make_pair(std::string_view { "read" }, Item::DefaultColumn::MessageFlags),
+		std::make_pair(std::string_view { "received" }, Item::DefaultColumn::Received),
+		std::make_pair(std::string_view { "modified" }, Item::DefaultColumn::Modified),
+		std::make_pair(std::string_view { "preview" }, Item::DefaultColumn::Preview),
+	},
+};
+
+const Item::Schema& Item::GetItemSchema() noexcept
 {
-	return PROP_TYPE(Item::GetItemColumns()[static_cast<size_t>(column)]);
+	return c_itemSchema;
 }
 
-static_assert(GetColumnPropType(Item::DefaultColumn::InstanceKey) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Id) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::ParentId) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Subject) == PT_UNICODE, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Sender) == PT_UNICODE, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::To) == PT_UNICODE, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Cc) == PT_UNICODE, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::MessageFlags) == PT_LONG, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Received) == PT_SYSTIME, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Modified) == PT_SYSTIME, "type mismatch");
-static_assert(GetColumnPropType(Item::DefaultColumn::Preview) == PT_UNICODE, "type mismatch");
-
 Item::Item(const std::shared_ptr<Store>& store, IMessage* pMessage, size_t columnCount,
 	mapi_ptr<SPropValue>&& columns)
 	: m_store { store }
 	, m_columnCount { columnCount }
 	, m_columns { std::move(columns) }
-	, m_instanceKey { GetIdColumn(DefaultColumn::InstanceKey) }
-	, m_id { GetIdColumn(DefaultColumn::Id) }
-	, m_parentId { GetIdColumn(DefaultColumn::ParentId) }
-	, m_subject { GetStringColumn(DefaultColumn::Subject) }
-	, m_sender { GetStringColumn(DefaultColumn::Sender) }
-	, m_to { GetStringColumn(DefaultColumn::To) }
-	, m_cc { GetStringColumn(DefaultColumn::Cc) }
-	, m_read { GetReadColumn(DefaultColumn::MessageFlags) }
-	, m_received { GetTimeColumn(DefaultColumn::Received) }
-	, m_modified { GetTimeColumn(DefaultColumn::Modified) }
-	, m_preview { GetStringColumn(DefaultColumn::Preview) }
+	, m_instanceKey { GetIdColumn<DefaultColumn::InstanceKey>() }
+	, m_id { GetIdColumn<DefaultColumn::Id>() }
+	, m_parentId { GetIdColumn<DefaultColumn::ParentId>() }
+	, m_read { GetReadColumn<DefaultColumn::MessageFlags>() }
+	, m_received { GetTimeColumn<DefaultColumn::Received>() }
+	, m_modified { GetTimeColumn<DefaultColumn::Modified>() }
 	, m_message { pMessage }
 {
 }
@@ -60,22 +73,26 @@ const response::IdType& Item::id() const
 
 const std::string& Item::subject() const
 {
-	return m_subject;
+	static const std::string s_empty;
+	const auto& subject = GetStringColumn<DefaultColumn::Subject>(m_subjectOnce, m_subject);
+
+	// The subject is not nullable, so it's still an empty string if it was skipped with @select.
+	return subject ? *subject : s_empty;
 }
 
 const std::optional<std::string>& Item::sender() const
 {
-	return m_sender;
+	return GetStringColumn<DefaultColumn::Sender>(m_senderOnce, m_sender);
 }
 
 const std::optional<std::string>& Item::to() const
 {
-	return m_to;
+	return GetStringColumn<DefaultColumn::To>(m_toOnce, m_to);
 }
 
 const std::optional<std::string>& Item::cc() const
 {
-	return m_cc;
+	return GetStringColumn<DefaultColumn::Cc>(m_ccOnce, m_cc);
 }
 
 bool Item::read() const
@@ -93,6 +110,23 @@ const FILETIME& Item::modified() const
 	return m_modified;
 }
 
+const std::optional<std::string>& Item::preview() const
+{
+	return GetStringColumn<DefaultColumn::Preview>(m_previewOnce, m_preview);
+}
+
+size_t Item::bytes() const noexcept
+{
+	// Any strings which were already decoded are copies of the column values, so count both.
+	return sizeof(*this) + GetRowBytes(static_cast<ULONG>(m_columnCount), m_columns.get())
+		+ m_instanceKey.size() + m_id.size() + m_parentId.size() + m_decodedBytes;
+}
+
+std::shared_ptr<object::Item> Item::object()
+{
+	return m_object.get(shared_from_this());
+}
+
 const CComPtr<IMessage>& Item::message()
 {
 	OpenItem();
@@ -108,9 +142,12 @@ const SPropValue& Item::GetColumnProp(DefaultColumn column) const
 	return m_columns.get()[index];
 }
 
-response::IdType Item::GetIdColumn(DefaultColumn column) const
+template <Item::DefaultColumn Column>
+response::IdType Item::GetIdColumn() const
 {
-	const auto& idProp = GetColumnProp(column);
+	static_assert(c_itemSchema.propType(Column) == PT_BINARY, "type mismatch");
+
+	const auto& idProp = GetColumnProp(Column);
 
 	if (PROP_TYPE(idProp.ulPropTag) != PT_BINARY)
 	{
@@ -123,29 +160,68 @@ response::IdType Item::GetIdColumn(DefaultColumn column) const
 	return { idBegin, idEnd };
 }
 
-std::string Item::GetStringColumn(DefaultColumn column) const
+template <Item::DefaultColumn Column>
+const std::optional<std::string>& Item::GetStringColumn(
+	std::once_flag& once, std::optional<std::string>& decoded) const
 {
-	const auto& stringProp = GetColumnProp(column);
+	static_assert(c_itemSchema.propType(Column) == PT_UNICODE, "type mismatch");
 
-	if (PROP_TYPE(stringProp.ulPropTag) != PT_UNICODE)
-	{
-		return {};
-	}
+	std::call_once(once, [this, &decoded]() {
+		const auto& stringProp = GetColumnProp(Column);
 
-	return convert::utf8::to_utf8(stringProp.Value.lpszW);
+		switch (PROP_TYPE(stringProp.ulPropTag))
+		{
+			case PT_UNICODE:
+				decoded = convert::utf8::to_utf8(stringProp.Value.lpszW);
+				break;
+
+			case PT_NULL:
+				// The column was skipped with @select, so the field resolves to null.
+				break;
+
+			default:
+				decoded = std::string {};
+				break;
+		}
+
+		if (decoded)
+		{
+			m_decodedBytes += decoded->capacity();
+
+			// Ask the store to measure the item again if it's in the store's item cache.
+			if (const auto store = m_store.lock())
+			{
+				store->UpdateCachedItem(*this);
+			}
+		}
+	});
+
+	return decoded;
 }
 
-bool Item::GetReadColumn(DefaultColumn column) const
+template <Item::DefaultColumn Column>
+bool Item::GetReadColumn() const
 {
-	const auto& messageFlagsProp = GetColumnProp(column);
+	static_assert(c_itemSchema.propType(Column) == PT_LONG, "type mismatch");
+
+	const auto& messageFlagsProp = GetColumnProp(Column);
 
 	return (PROP_TYPE(messageFlagsProp.ulPropTag) == PT_LONG)
 		&& ((messageFlagsProp.Value.l & MSGFLAG_READ) == MSGFLAG_READ);
 }
 
-FILETIME Item::GetTimeColumn(DefaultColumn column) const
+template <Item::DefaultColumn Column>
+FILETIME Item::GetTimeColumn() const
 {
-	const auto& timeProp = GetColumnProp(column);
+	static_assert(c_itemSchema.propType(Column) == PT_SYSTIME, "type mismatch");
+
+	const auto& timeProp = GetColumnProp(Column);
+
+	if (PROP_TYPE(timeProp.ulPropTag) == PT_NULL)
+	{
+		// The column was skipped with @select.
+		return {};
+	}
 
 	CFRt(PROP_TYPE(timeProp.ulPropTag) == PT_SYSTIME);
 
@@ -178,7 +254,10 @@ const response::IdType& Item::getId() const
 
 std::shared_ptr<object::Folder> Item::getParentFolder() const
 {
-	return std::make_shared<object::Folder>(m_store.lock()->OpenFolder(m_parentId));
+	auto parentFolder = m_store.lock()->OpenFolder(m_parentId);
+
+	CFRt(parentFolder != nullptr);
+	return parentFolder->object();
 }
 
 std::shared_ptr<object::Conversation> Item::getConversation(service::FieldParams&& params) const
@@ -189,22 +268,22 @@ std::shared_ptr<object::Conversation> Item::getConversation(service::FieldParams
 
 const std::string& Item::getSubject() const
 {
-	return m_subject;
+	return subject();
 }
 
 std::optional<std::string> Item::getSender() const
 {
-	return m_sender;
+	return sender();
 }
 
 std::optional<std::string> Item::getTo() const
 {
-	return m_to;
+	return to();
 }
 
 std::optional<std::string> Item::getCc() const
 {
-	return m_cc;
+	return cc();
 }
 
 std::optional<response::Value> Item::getBody(service::FieldParams&& params) const
@@ -220,26 +299,40 @@ bool Item::getRead() const
 
 std::optional<response::Value> Item::getReceived() const
 {
+	if (m_received.dwLowDateTime == 0 && m_received.dwHighDateTime == 0)
+	{
+		return std::nullopt;
+	}
+
 	return std::make_optional<response::Value>(convert::datetime::to_string(m_received));
 }
 
 std::optional<response::Value> Item::getModified() const
 {
+	if (m_modified.dwLowDateTime == 0 && m_modified.dwHighDateTime == 0)
+	{
+		return std::nullopt;
+	}
+
 	return std::make_optional<response::Value>(convert::datetime::to_string(m_modified));
 }
 
 std::optional<std::string> Item::getPreview() const
 {
-	return m_preview;
+	return preview();
 }
 
-std::vector<std::shared_ptr<object::Property>> Item::getColumns() const
+std::vector<std::shared_ptr<object::Property>> Item::getColumns(
+	service::FieldParams&& params) const
 {
 	auto store = m_store.lock();
 	const auto offset = static_cast<size_t>(DefaultColumn::Count);
 
-	CFRt(m_columnCount >= offset);
-	return { store->GetColumns(m_columnCount - offset, m_columns.get() + offset) };
+	return store->GetColumnFragment(m_id,
+		m_columnCount,
+		m_columns.get(),
+		offset,
+		GetRequestArena(params));
 }
 
 std::vector<std::shared_ptr<object::Attachment>> Item::getAttachments(
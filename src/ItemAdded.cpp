@@ -21,7 +21,7 @@ int ItemAdded::getIndex() const
 
 std::shared_ptr<object::Item> ItemAdded::getAdded() const
 {
-	return std::make_shared<object::Item>(m_added);
+	return m_added->object();
 }
 
 } // namespace graphql::mapi
\ No newline at end of file
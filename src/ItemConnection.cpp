@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include "ItemEdgeObject.h"
+#include "PageInfoObject.h"
+
+namespace graphql::mapi {
+
+ItemConnection::ItemConnection(CountLoader&& loadCount, PageLoader&& loadPage)
+	: m_loadCount { std::move(loadCount) }
+	, m_loadPage { std::move(loadPage) }
+{
+}
+
+void ItemConnection::LoadPage()
+{
+	if (m_edges)
+	{
+		return;
+	}
+
+	auto edges = std::make_unique<std::vector<std::shared_ptr<ItemEdge>>>();
+	const bool hasNextPage = m_loadPage(*edges);
+	std::optional<response::IdType> endCursor;
+
+	if (!edges->empty())
+	{
+		endCursor = edges->back()->getCursor();
+	}
+
+	m_edges = std::move(edges);
+	m_pageInfo = std::make_shared<PageInfo>(hasNextPage, std::move(endCursor));
+}
+
+std::vector<std::shared_ptr<object::ItemEdge>> ItemConnection::getEdges()
+{
+	LoadPage();
+
+	std::vector<std::shared_ptr<object::ItemEdge>> result(m_edges->size());
+
+	std::transform(m_edges->cbegin(),
+		m_edges->cend(),
+		result.begin(),
+		[](const std::shared_ptr<ItemEdge>& edge) noexcept {
+			return std::make_shared<object::ItemEdge>(edge);
+		});
+
+	return result;
+}
+
+std::shared_ptr<object::PageInfo> ItemConnection::getPageInfo()
+{
+	LoadPage();
+
+	return std::make_shared<object::PageInfo>(m_pageInfo);
+}
+
+int ItemConnection::getTotalCount()
+{
+	if (!m_totalCount)
+	{
+		m_totalCount = m_loadCount();
+	}
+
+	return *m_totalCount;
+}
+
+} // namespace graphql::mapi
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include "ItemObject.h"
+
+namespace graphql::mapi {
+
+ItemEdge::ItemEdge(const std::shared_ptr<Item>& node, response::IdType&& cursor)
+	: m_node { node }
+	, m_cursor { std::move(cursor) }
+{
+}
+
+const response::IdType& ItemEdge::getCursor() const
+{
+	return m_cursor;
+}
+
+std::shared_ptr<object::Item> ItemEdge::getNode() const
+{
+	return m_node->object();
+}
+
+} // namespace graphql::mapi
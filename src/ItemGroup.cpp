@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include "ItemObject.h"
+#include "PropertyObject.h"
+
+namespace graphql::mapi {
+
+ItemGroup::ItemGroup(response::IdType&& id, std::shared_ptr<object::Property>&& value, int count,
+	int unread, ItemsLoader&& loadItems)
+	: m_id { std::move(id) }
+	, m_value { std::move(value) }
+	, m_count { count }
+	, m_unread { unread }
+	, m_loadItems { std::move(loadItems) }
+{
+}
+
+const response::IdType& ItemGroup::getId() const
+{
+	return m_id;
+}
+
+std::shared_ptr<object::Property> ItemGroup::getValue() const
+{
+	return m_value;
+}
+
+int ItemGroup::getCount() const
+{
+	return m_count;
+}
+
+int ItemGroup::getUnread() const
+{
+	return m_unread;
+}
+
+std::vector<std::shared_ptr<object::Item>> ItemGroup::getItems(service::FieldParams&& params)
+{
+	if (!m_items || m_itemDirectives != params.fieldDirectives)
+	{
+		// Reset the items and expand the category again if the directives change
+		m_itemDirectives = std::move(params.fieldDirectives);
+		m_items = std::make_unique<std::vector<std::shared_ptr<Item>>>(
+			m_loadItems(m_itemDirectives));
+	}
+
+	std::vector<std::shared_ptr<object::Item>> result(m_items->size());
+
+	std::transform(m_items->cbegin(),
+		m_items->cend(),
+		result.begin(),
+		[](const std::shared_ptr<Item>& item) noexcept {
+			return item->object();
+		});
+
+	return result;
+}
+
+} // namespace graphql::mapi
@@ -21,7 +21,7 @@ int ItemUpdated::getIndex() const
 
 std::shared_ptr<object::Item> ItemUpdated::getUpdated() const
 {
-	return std::make_shared<object::Item>(m_updated);
+	return m_updated->object();
 }
 
 } // namespace graphql::mapi
\ No newline at end of file
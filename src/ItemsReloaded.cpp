@@ -21,7 +21,7 @@ std::vector<std::shared_ptr<object::Item>> ItemsReloaded::getReloaded() const
 		m_reloaded.cend(),
 		result.begin(),
 		[](const std::shared_ptr<Item>& item) noexcept {
-			return std::make_shared<object::Item>(item);
+			return item->object();
 		});
 
 	return result;
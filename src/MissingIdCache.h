@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "EntryIdIndex.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <list>
+
+namespace graphql::mapi {
+
+// Entry IDs which are known not to exist, so opening them again can skip the round trip to MAPI.
+// Each ID expires after a fixed lifetime, and the least recently inserted or refreshed IDs are
+// dropped to stay within the limit.
+class MissingIdCache
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit MissingIdCache(Clock::duration lifetime, size_t limit) noexcept
+		: m_lifetime { lifetime }
+		, m_limit { limit }
+	{
+	}
+
+	bool contains(const response::IdType& id, Clock::time_point now = Clock::now())
+	{
+		const auto itr = m_index.find(id);
+
+		if (!itr)
+		{
+			return false;
+		}
+
+		if ((*itr)->expiration <= now)
+		{
+			erase(id);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Insert or refresh the ID, which moves it to the back of the list so it's the last one to be
+	// dropped.
+	void insert(const response::IdType& id, Clock::time_point now = Clock::now())
+	{
+		if (m_limit == 0)
+		{
+			return;
+		}
+
+		if (const auto itr = m_index.find(id))
+		{
+			(*itr)->expiration = now + m_lifetime;
+			m_entries.splice(m_entries.end(), m_entries, *itr);
+			return;
+		}
+
+		m_entries.push_back(Entry { id, now + m_lifetime });
+		m_index.insert(id, std::prev(m_entries.end()));
+
+		while (m_entries.size() > m_limit)
+		{
+			m_index.erase(m_entries.front().id);
+			m_entries.pop_front();
+		}
+	}
+
+	// The ID exists again, e.g. it was created or moved back.
+	void erase(const response::IdType& id)
+	{
+		const auto itr = m_index.find(id);
+
+		if (!itr)
+		{
+			return;
+		}
+
+		// The id may refer to the entry itself, so remove it from the index first.
+		const auto entry = *itr;
+
+		m_index.erase(id);
+		m_entries.erase(entry);
+	}
+
+	void clear() noexcept
+	{
+		m_index.clear();
+		m_entries.clear();
+	}
+
+	size_t size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+private:
+	struct Entry
+	{
+		response::IdType id;
+		Clock::time_point expiration;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	const Clock::duration m_lifetime;
+	const size_t m_limit;
+
+	// IDs from the least to the most recently inserted or refreshed.
+	EntryList m_entries;
+	EntryIdIndex<typename EntryList::iterator> m_index;
+};
+
+} // namespace graphql::mapi
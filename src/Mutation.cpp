@@ -79,8 +79,16 @@ bool Mutation::CopyItems(MultipleItemsInput&& inputArg, ObjectId&& destinationAr
 	return (result != MAPI_W_PARTIAL_COMPLETION);
 }
 
+void Mutation::beginSelectionSet(const service::SelectionSetParams&)
+{
+	m_query->ApplyNotifications();
+}
+
 void Mutation::endSelectionSet(const service::SelectionSetParams&)
 {
+	// The store notifications for our own changes arrive asynchronously, so don't wait for them to
+	// expire the cached folders and items which the mutation changed.
+	m_query->ReportCacheStats();
 	m_query->ClearCaches();
 }
 
@@ -184,7 +192,7 @@ std::shared_ptr<object::Item> Mutation::applyCreateItem(CreateItemInput&& inputA
 	auto created = std::make_shared<Item>(store, message, count, std::move(properties));
 
 	store->CacheItem(created);
-	return std::make_shared<object::Item>(created);
+	return created->object();
 }
 
 std::shared_ptr<object::Folder> Mutation::applyCreateSubFolder(CreateSubFolderInput&& inputArg)
@@ -248,7 +256,7 @@ std::shared_ptr<object::Folder> Mutation::applyCreateSubFolder(CreateSubFolderIn
 	auto created = std::make_shared<Folder>(store, folder, count, std::move(properties));
 
 	store->CacheFolder(created);
-	return std::make_shared<object::Folder>(created);
+	return created->object();
 }
 
 std::shared_ptr<object::Item> Mutation::applyModifyItem(ModifyItemInput&& inputArg)
@@ -267,7 +275,7 @@ std::shared_ptr<object::Item> Mutation::applyModifyItem(ModifyItemInput&& inputA
 
 	if (deleteCount > 0)
 	{
-		auto propIds = store->lookupPropIdInputs(std::move(*inputArg.deleted));
+		auto propIds = store->lookupPropIdInputs(*inputArg.deleted);
 		mapi_ptr<SPropTagArray> deletePropIds;
 
 		CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(propIds.size()),
@@ -337,7 +345,7 @@ std::shared_ptr<object::Item> Mutation::applyModifyItem(ModifyItemInput&& inputA
 
 	CORt(message->message()->SetReadFlag(inputArg.read ? 0 : CLEAR_READ_FLAG));
 
-	return std::make_shared<object::Item>(message);
+	return message->object();
 }
 
 std::shared_ptr<object::Folder> Mutation::applyModifyFolder(ModifyFolderInput&& inputArg)
@@ -356,7 +364,7 @@ std::shared_ptr<object::Folder> Mutation::applyModifyFolder(ModifyFolderInput&&
 
 	if (deleteCount > 0)
 	{
-		auto propIds = store->lookupPropIdInputs(std::move(*inputArg.deleted));
+		auto propIds = store->lookupPropIdInputs(*inputArg.deleted);
 		mapi_ptr<SPropTagArray> deletePropIds;
 
 		CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(propIds.size()),
@@ -424,7 +432,7 @@ std::shared_ptr<object::Folder> Mutation::applyModifyFolder(ModifyFolderInput&&
 		CORt(folder->folder()->SaveChanges(0));
 	}
 
-	return std::make_shared<object::Folder>(folder);
+	return folder->object();
 }
 
 bool Mutation::applyRemoveFolder(ObjectId&& inputArg, bool hardDeleteArg)
@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace graphql::mapi {
+
+// The file is only read on the same machine that wrote it, so it uses the native byte order.
+constexpr std::uint32_t c_namedPropCacheMagic = 0x4350'4E4D; // "MNPC"
+constexpr std::uint32_t c_namedPropCacheVersion = 2;
+
+// The header is followed by the store ID and the signature of the store's named property mappings.
+struct NamedPropCacheHeader
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint32_t storeIdSize;
+	std::uint32_t signatureSize;
+	std::uint32_t entryCount;
+};
+
+// Each entry is followed by the characters of the name if kind is MNID_STRING, in which case value
+// is the number of characters. Otherwise value is the MNID_ID.
+struct NamedPropCacheEntry
+{
+	std::uint32_t propId;
+	std::uint32_t kind;
+	GUID propset;
+	std::uint32_t value;
+};
+
+std::filesystem::path GetNamedPropCachePath(
+	const std::filesystem::path& directory, const response::IdType& storeId)
+{
+	std::ostringstream oss;
+
+	// Store IDs are too long for a file name, the header has the full store ID to check for
+	// collisions.
+	oss << "namedprops-" << std::hex << std::setfill('0') << std::setw(16)
+		<< EntryIdIndex<ULONG>::hash(storeId) << ".bin";
+
+	return directory / oss.str();
+}
+
+NamedPropCache::NamedPropCache(
+	const std::filesystem::path& directory, const response::IdType& storeId)
+	: m_path { GetNamedPropCachePath(directory, storeId) }
+	, m_storeId { storeId }
+{
+	// The file is optional, so any failure just leaves it unmapped.
+	m_file = ::CreateFileW(m_path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr);
+
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	LARGE_INTEGER size {};
+
+	if (!::GetFileSizeEx(m_file, &size)
+		|| size.QuadPart < static_cast<LONGLONG>(sizeof(NamedPropCacheHeader))
+		|| size.QuadPart > 16 * 1024 * 1024)
+	{
+		close();
+		return;
+	}
+
+	m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (m_mapping)
+	{
+		const auto view = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+
+		m_view = reinterpret_cast<const std::uint8_t*>(view);
+		m_size = static_cast<size_t>(size.QuadPart);
+	}
+
+	if (!m_view)
+	{
+		close();
+	}
+}
+
+// Several processes, or several sessions in the same process, may save the same store at once, so
+// each of them writes to its own temporary file before replacing the file.
+void WriteNamedPropCacheFile(
+	const std::filesystem::path& path, const std::vector<std::uint8_t>& buffer)
+{
+	static std::atomic_uint32_t s_saveCount { 0 };
+	std::wostringstream tempSuffix;
+
+	tempSuffix << L'.' << ::GetCurrentProcessId() << L'.' << ++s_saveCount << L".tmp";
+
+	// This is only a cache, so just give up if anything fails.
+	std::error_code ec;
+	auto tempPath = path;
+
+	tempPath += tempSuffix.str();
+	std::filesystem::create_directories(path.parent_path(), ec);
+
+	{
+		std::ofstream file { tempPath, std::ios::binary | std::ios::trunc };
+
+		file.write(reinterpret_cast<const char*>(buffer.data()),
+			static_cast<std::streamsize>(buffer.size()));
+		file.close();
+
+		if (!file)
+		{
+			std::filesystem::remove(tempPath, ec);
+			return;
+		}
+	}
+
+	std::filesystem::rename(tempPath, path, ec);
+
+	if (ec)
+	{
+		std::filesystem::remove(tempPath, ec);
+	}
+}
+
+NamedPropCache::~NamedPropCache()
+{
+	close();
+
+	// The writer keeps going until it has written the last buffer which was saved.
+	if (m_writer.valid())
+	{
+		m_writer.wait();
+	}
+}
+
+NameIdToPropId NamedPropCache::load(const response::IdType& signature)
+{
+	NameIdToPropId result;
+
+	if (m_signature)
+	{
+		return result;
+	}
+
+	m_signature = std::make_optional(signature);
+
+	if (!m_view)
+	{
+		return result;
+	}
+
+	const auto begin = m_view;
+	const auto end = m_view + m_size;
+	auto current = begin;
+
+	// Copy each field out of the view, it might not be aligned.
+	const auto read = [&current, end](void* target, size_t size) noexcept {
+		if (static_cast<size_t>(end - current) < size)
+		{
+			return false;
+		}
+
+		std::memcpy(target, current, size);
+		current += size;
+		return true;
+	};
+
+	// Compare the next bytes in the view with an ID from the header.
+	const auto match = [&current, end](const response::IdType& id, std::uint32_t size) noexcept {
+		if (static_cast<size_t>(size) != id.size() || static_cast<size_t>(end - current) < id.size()
+			|| std::memcmp(current, id.data(), id.size()) != 0)
+		{
+			return false;
+		}
+
+		current += id.size();
+		return true;
+	};
+
+	NamedPropCacheHeader header {};
+
+	if (!read(&header, sizeof(header)) || header.magic != c_namedPropCacheMagic
+		|| header.version != c_namedPropCacheVersion || !match(m_storeId, header.storeIdSize)
+		|| !match(signature, header.signatureSize))
+	{
+		close();
+		return result;
+	}
+
+	for (std::uint32_t i = 0; i < header.entryCount; ++i)
+	{
+		NamedPropCacheEntry entry {};
+
+		if (!read(&entry, sizeof(entry)) || PROP_ID(entry.propId) < 0x8000)
+		{
+			result.clear();
+			break;
+		}
+
+		mapi_ptr<MAPINAMEID> namedId;
+
+		CORt(::MAPIAllocateBuffer(sizeof(*namedId) + sizeof(*namedId->lpguid),
+			reinterpret_cast<void**>(&out_ptr { namedId })));
+
+		namedId->lpguid = reinterpret_cast<LPGUID>(namedId.get() + 1);
+		*namedId->lpguid = entry.propset;
+		namedId->ulKind = entry.kind;
+
+		if (entry.kind == MNID_STRING)
+		{
+			const size_t length = static_cast<size_t>(entry.value);
+
+			if (static_cast<size_t>(end - current) < length * sizeof(wchar_t))
+			{
+				result.clear();
+				break;
+			}
+
+			CORt(::MAPIAllocateMore((length + 1) * sizeof(wchar_t),
+				namedId.get(),
+				reinterpret_cast<void**>(&namedId->Kind.lpwstrName)));
+			CFRt(namedId->Kind.lpwstrName != nullptr);
+			read(namedId->Kind.lpwstrName, length * sizeof(wchar_t));
+			namedId->Kind.lpwstrName[length] = L'\0';
+		}
+		else if (entry.kind == MNID_ID)
+		{
+			namedId->Kind.lID = static_cast<LONG>(entry.value);
+		}
+		else
+		{
+			result.clear();
+			break;
+		}
+
+		result.insert(
+			std::make_pair(std::move(namedId), PROP_TAG(PT_UNSPECIFIED, PROP_ID(entry.propId))));
+	}
+
+	// Any trailing bytes mean the file is corrupt, so don't trust any of the entries.
+	if (current != end)
+	{
+		result.clear();
+	}
+
+	close();
+	return result;
+}
+
+bool NamedPropCache::loaded() const noexcept
+{
+	return m_signature.has_value();
+}
+
+void NamedPropCache::save(const NameIdToPropId& nameIdToPropIds)
+{
+	if (!m_signature)
+	{
+		return;
+	}
+
+	// Serialize the mappings now, since the map may keep changing while the file is written.
+	std::vector<std::uint8_t> buffer;
+	const auto write = [&buffer](const void* source, size_t size) {
+		const auto bytes = reinterpret_cast<const std::uint8_t*>(source);
+
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	};
+	const NamedPropCacheHeader header { c_namedPropCacheMagic,
+		c_namedPropCacheVersion,
+		static_cast<std::uint32_t>(m_storeId.size()),
+		static_cast<std::uint32_t>(m_signature->size()),
+		static_cast<std::uint32_t>(nameIdToPropIds.size()) };
+
+	write(&header, sizeof(header));
+	write(m_storeId.data(), m_storeId.size());
+	write(m_signature->data(), m_signature->size());
+
+	for (const auto& [namedId, propId] : nameIdToPropIds)
+	{
+		NamedPropCacheEntry entry { propId, namedId->ulKind, *namedId->lpguid, 0 };
+		std::wstring_view name;
+
+		if (namedId->ulKind == MNID_STRING)
+		{
+			name = namedId->Kind.lpwstrName;
+			entry.value = static_cast<std::uint32_t>(name.size());
+		}
+		else
+		{
+			entry.value = static_cast<std::uint32_t>(namedId->Kind.lID);
+		}
+
+		write(&entry, sizeof(entry));
+		write(name.data(), name.size() * sizeof(wchar_t));
+	}
+
+	// Release the mapped file so it can be replaced.
+	close();
+
+	std::lock_guard lock { m_pendingMutex };
+
+	// If the writer is still busy, replace any buffer which it hasn't started writing yet, it
+	// only needs to write the latest mappings. Otherwise start it again.
+	m_pendingBuffer = std::move(buffer);
+
+	if (m_writing)
+	{
+		return;
+	}
+
+	m_writing = true;
+	m_writer = std::async(std::launch::async, [this]() {
+		while (true)
+		{
+			std::vector<std::uint8_t> pending;
+
+			{
+				std::lock_guard lock { m_pendingMutex };
+
+				if (!m_pendingBuffer)
+				{
+					m_writing = false;
+					return;
+				}
+
+				pending = std::move(*m_pendingBuffer);
+				m_pendingBuffer.reset();
+			}
+
+			try
+			{
+				WriteNamedPropCacheFile(m_path, pending);
+			}
+			catch (const std::exception&)
+			{
+				// Keep going with the next buffer, the file is only a cache.
+			}
+		}
+	});
+}
+
+void NamedPropCache::close() noexcept
+{
+	if (m_view)
+	{
+		::UnmapViewOfFile(m_view);
+		m_view = nullptr;
+		m_size = 0;
+	}
+
+	if (m_mapping)
+	{
+		::CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		::CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+	}
+}
+
+} // namespace graphql::mapi
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "EntryIdIndex.h"
+
+#include "include/ServiceOptions.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+
+namespace graphql::mapi {
+
+// Cache of shared objects by ID, which evicts the least recently used objects to stay within a
+// budget in bytes. T must have an id() accessor, and a bytes() method which estimates how much
+// memory it holds. Objects which grow or shrink after they are inserted should call update, so the
+// cache measures them again. It isn't thread safe, so callers which share it must hold a lock.
+template <class T>
+class ObjectCache
+{
+public:
+	using Counters = CacheCounters;
+
+	explicit ObjectCache(size_t budget) noexcept
+		: m_budget { budget }
+	{
+	}
+
+	std::shared_ptr<T> find(const response::IdType& id)
+	{
+		const auto itr = m_index.find(id);
+
+		if (!itr)
+		{
+			++m_counters.misses;
+			return nullptr;
+		}
+
+		// Move the entry to the front of the list, so it's the last one to be evicted.
+		++m_counters.hits;
+		m_entries.splice(m_entries.begin(), m_entries, *itr);
+
+		return (*itr)->object;
+	}
+
+	// Replace any object with the same ID, then evict the least recently used objects until the
+	// cache fits in the budget again. Objects which are larger than the whole budget are skipped.
+	void insert(const std::shared_ptr<T>& object)
+	{
+		const auto& id = object->id();
+		const size_t bytes = object->bytes();
+
+		erase(id);
+
+		if (bytes > m_budget)
+		{
+			return;
+		}
+
+		m_entries.push_front(Entry { object, bytes });
+		m_index.insert(id, m_entries.begin());
+		m_bytes += bytes;
+
+		while (m_bytes > m_budget)
+		{
+			evictLast();
+		}
+	}
+
+	// Measure a cached object again and make it the most recently used, then evict the least
+	// recently used objects until the cache fits in the budget again. The object itself is never
+	// evicted here, since the caller is still using it, but the next insert may evict it. Objects
+	// which aren't in the cache are ignored.
+	void update(const T& object)
+	{
+		const auto itr = m_index.find(object.id());
+
+		if (!itr || (*itr)->object.get() != &object)
+		{
+			return;
+		}
+
+		const auto entry = *itr;
+		const size_t bytes = object.bytes();
+
+		m_bytes = m_bytes - entry->bytes + bytes;
+		entry->bytes = bytes;
+		m_entries.splice(m_entries.begin(), m_entries, entry);
+
+		while (m_bytes > m_budget && m_entries.size() > 1)
+		{
+			evictLast();
+		}
+	}
+
+	void erase(const response::IdType& id)
+	{
+		const auto itr = m_index.find(id);
+
+		if (!itr)
+		{
+			return;
+		}
+
+		// The id may refer to the cached object itself, so remove it from the index before the
+		// entry releases the object.
+		const auto entry = *itr;
+
+		m_index.erase(id);
+		m_bytes -= entry->bytes;
+		m_entries.erase(entry);
+	}
+
+	void clear() noexcept
+	{
+		m_index.clear();
+		m_entries.clear();
+		m_bytes = 0;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	size_t bytes() const noexcept
+	{
+		return m_bytes;
+	}
+
+	size_t budget() const noexcept
+	{
+		return m_budget;
+	}
+
+	const Counters& counters() const noexcept
+	{
+		return m_counters;
+	}
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<T> object;
+		size_t bytes = 0;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	void evictLast()
+	{
+		const auto& last = m_entries.back();
+
+		m_bytes -= last.bytes;
+		m_index.erase(last.object->id());
+		m_entries.pop_back();
+		++m_counters.evictions;
+	}
+
+	const size_t m_budget;
+	EntryList m_entries;
+	EntryIdIndex<typename EntryList::iterator> m_index;
+	size_t m_bytes = 0;
+	Counters m_counters;
+};
+
+} // namespace graphql::mapi
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace graphql::mapi {
+
+// Each generated object:: wrapper builds its own resolver map when it's constructed, so wrapping
+// the same implementation object again on every resolution is expensive. This remembers the last
+// wrapper for an implementation object for as long as something else still holds it. It can't own
+// the wrapper, since the wrapper owns the implementation object. The same implementation object may
+// be resolved on several threads at once, so the weak reference is guarded by a mutex.
+template <class Object>
+class WrapperCache
+{
+public:
+	template <class T>
+	std::shared_ptr<Object> get(const std::shared_ptr<T>& impl) const
+	{
+		std::lock_guard lock { m_mutex };
+		auto result = m_wrapper.lock();
+
+		if (!result)
+		{
+			result = std::make_shared<Object>(impl);
+			m_wrapper = result;
+		}
+
+		return result;
+	}
+
+private:
+	mutable std::mutex m_mutex;
+	mutable std::weak_ptr<Object> m_wrapper;
+};
+
+// Wrap every row in a cached window with its object() wrapper. The previous result is kept in
+// held, which keeps the wrappers of rows that are still in the window alive until the next time,
+// so returning the same window again only allocates the vector.
+template <class Object, class T>
+std::vector<std::shared_ptr<Object>> WrapRows(
+	const std::vector<std::shared_ptr<T>>& rows, std::vector<std::shared_ptr<Object>>& held)
+{
+	std::vector<std::shared_ptr<Object>> result(rows.size());
+
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		result[i] = rows[i]->object();
+	}
+
+	held = result;
+
+	return result;
+}
+
+} // namespace graphql::mapi
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+namespace graphql::mapi {
+
+PageInfo::PageInfo(bool hasNextPage, std::optional<response::IdType>&& endCursor)
+	: m_hasNextPage { hasNextPage }
+	, m_endCursor { std::move(endCursor) }
+{
+}
+
+bool PageInfo::getHasNextPage() const
+{
+	return m_hasNextPage;
+}
+
+const std::optional<response::IdType>& PageInfo::getEndCursor() const
+{
+	return m_endCursor;
+}
+
+} // namespace graphql::mapi
@@ -16,7 +16,7 @@
 
 namespace graphql::mapi {
 
-Property::Property(const id_variant& id, mapi_ptr<SPropValue>&& value)
+Property::Property(const id_variant& id, std::shared_ptr<const SPropValue>&& value)
 	: m_id { std::visit(
 		[](const auto& id) -> std::shared_ptr<object::PropId> {
 			using T = std::decay_t<decltype(id)>;
@@ -43,54 +43,61 @@ std::shared_ptr<object::PropId> Property::getId() const
 }
 
 std::shared_ptr<object::PropValue> Property::getValue() const
+{
+	std::call_once(m_valueOnce, [this]() { m_propValue = MakeValue(*m_value); });
+
+	return m_propValue;
+}
+
+std::shared_ptr<object::PropValue> Property::MakeValue(const SPropValue& value)
 {
 	std::shared_ptr<object::PropValue> result;
 
-	switch (PROP_TYPE(m_value->ulPropTag))
+	switch (PROP_TYPE(value.ulPropTag))
 	{
 		case PT_I2:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::IntValue>(
-				std::make_shared<IntValue>(static_cast<int>(m_value->Value.i))));
+				std::make_shared<IntValue>(static_cast<int>(value.Value.i))));
 			break;
 
 		case PT_LONG:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::IntValue>(
-				std::make_shared<IntValue>(static_cast<int>(m_value->Value.l))));
+				std::make_shared<IntValue>(static_cast<int>(value.Value.l))));
 			break;
 
 		case PT_I8:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::IntValue>(
-				std::make_shared<IntValue>(static_cast<int>(m_value->Value.li.QuadPart))));
+				std::make_shared<IntValue>(static_cast<int>(value.Value.li.QuadPart))));
 			break;
 
 		case PT_BOOLEAN:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::BoolValue>(
-				std::make_shared<BoolValue>(!!m_value->Value.b)));
+				std::make_shared<BoolValue>(!!value.Value.b)));
 			break;
 
 		case PT_STRING8:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::StringValue>(
-				std::make_shared<StringValue>(std::string { m_value->Value.lpszA })));
+				std::make_shared<StringValue>(std::string { value.Value.lpszA })));
 			break;
 
 		case PT_UNICODE:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::StringValue>(
-				std::make_shared<StringValue>(m_value->Value.lpszW)));
+				std::make_shared<StringValue>(value.Value.lpszW)));
 			break;
 
 		case PT_CLSID:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::GuidValue>(
-				std::make_shared<GuidValue>(*m_value->Value.lpguid)));
+				std::make_shared<GuidValue>(*value.Value.lpguid)));
 			break;
 
 		case PT_SYSTIME:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::DateTimeValue>(
-				std::make_shared<DateTimeValue>(m_value->Value.ft)));
+				std::make_shared<DateTimeValue>(value.Value.ft)));
 			break;
 
 		case PT_BINARY:
 			result = std::make_shared<object::PropValue>(std::make_shared<object::BinaryValue>(
-				std::make_shared<BinaryValue>(m_value->Value.bin)));
+				std::make_shared<BinaryValue>(value.Value.bin)));
 			break;
 
 		default:
@@ -3,12 +3,16 @@
 
 #include "Types.h"
 
+#include "ItemObject.h"
 #include "StoreObject.h"
 
 namespace graphql::mapi {
 
-Query::Query(const std::shared_ptr<Session>& session)
+Query::Query(
+	const std::shared_ptr<Session>& session, bool clearCaches, const CacheOptions& cacheOptions)
 	: m_session { session }
+	, m_clearCaches { clearCaches }
+	, m_cacheOptions { cacheOptions }
 {
 }
 
@@ -34,14 +38,14 @@ std::shared_ptr<Store> Query::lookup(const response::IdType& id)
 {
 	LoadStores({});
 
-	auto itr = m_ids->find(id);
+	const auto index = m_ids->find(id);
 
-	if (itr == m_ids->cend())
+	if (!index)
 	{
 		return nullptr;
 	}
 
-	return m_stores->at(itr->second);
+	return m_stores->at(*index);
 }
 
 void Query::ClearCaches()
@@ -55,6 +59,54 @@ void Query::ClearCaches()
 	}
 }
 
+void Query::ExpireCaches()
+{
+	if (m_clearCaches)
+	{
+		ClearCaches();
+		return;
+	}
+
+	if (m_stores)
+	{
+		for (const auto& entry : *m_stores)
+		{
+			entry->ExpireCaches();
+		}
+	}
+}
+
+void Query::ApplyNotifications()
+{
+	if (m_stores)
+	{
+		for (const auto& entry : *m_stores)
+		{
+			entry->ApplyNotifications();
+		}
+	}
+}
+
+void Query::ReportCacheStats()
+{
+	if (!m_cacheOptions.cacheStats)
+	{
+		return;
+	}
+
+	CacheStats stats;
+
+	if (m_stores)
+	{
+		for (const auto& entry : *m_stores)
+		{
+			entry->AddCacheStats(stats);
+		}
+	}
+
+	m_cacheOptions.cacheStats(stats);
+}
+
 void Query::LoadStores(service::Directives&& fieldDirectives)
 {
 	if (m_storeDirectives != fieldDirectives)
@@ -69,37 +121,18 @@ void Query::LoadStores(service::Directives&& fieldDirectives)
 		return;
 	}
 
-	m_ids = std::make_unique<std::map<response::IdType, size_t>>();
+	m_ids = std::make_unique<EntryIdIndex<size_t>>();
 	m_stores = std::make_unique<std::vector<std::shared_ptr<Store>>>();
 
 	// Enumerate the message stores table and fill in the Store object collection.
-	constexpr auto c_storeProps = Store::GetStoreColumns();
-	mapi_ptr<SPropTagArray> storeProps;
-
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_storeProps.size()),
-		reinterpret_cast<void**>(&out_ptr { storeProps })));
-	CFRt(storeProps != nullptr);
-	storeProps->cValues = static_cast<ULONG>(c_storeProps.size());
-	std::copy(c_storeProps.begin(), c_storeProps.end(), storeProps->aulPropTag);
-
-	constexpr std::array c_storeSorts = Store::GetStoreSorts();
-	mapi_ptr<SSortOrderSet> storeSorts;
-
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_storeSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { storeSorts })));
-	CFRt(storeSorts != nullptr);
-	storeSorts->cSorts = static_cast<ULONG>(c_storeSorts.size());
-	storeSorts->cCategories = 0;
-	storeSorts->cExpanded = 0;
-	std::copy(c_storeSorts.begin(), c_storeSorts.end(), storeSorts->aSort);
-
+	const auto& schema = Store::GetStoreSchema();
 	const TableDirectives directives { {}, m_storeDirectives };
 	CComPtr<IMAPITable> sptable;
 
 	CORt(m_session->session()->GetMsgStoresTable(0, &sptable));
 
-	const rowset_ptr sprows =
-		directives.read(sptable, std::move(storeProps), std::move(storeSorts));
+	TableHandle table { sptable };
+	const rowset_ptr sprows = directives.read(table, schema.columns(), &schema.sorts());
 
 	m_stores->reserve(static_cast<size_t>(sprows->cRows));
 	for (ULONG i = 0; i != sprows->cRows; i++)
@@ -110,9 +143,12 @@ void Query::LoadStores(service::Directives&& fieldDirectives)
 
 		row.lpProps = nullptr;
 
-		auto store = std::make_shared<Store>(m_session->session(), columnCount, std::move(columns));
+		auto store = std::make_shared<Store>(m_session->session(),
+			m_cacheOptions,
+			columnCount,
+			std::move(columns));
 
-		m_ids->insert(std::make_pair(store->id(), m_stores->size()));
+		m_ids->insert(store->id(), m_stores->size());
 		m_stores->push_back(std::move(store));
 	}
 
@@ -139,9 +175,15 @@ void Query::LoadStores(service::Directives&& fieldDirectives)
 	}
 }
 
+void Query::beginSelectionSet(const service::SelectionSetParams&)
+{
+	ApplyNotifications();
+}
+
 void Query::endSelectionSet(const service::SelectionSetParams&)
 {
-	ClearCaches();
+	ReportCacheStats();
+	ExpireCaches();
 }
 
 std::vector<std::shared_ptr<object::Store>> Query::getStores(
@@ -159,21 +201,72 @@ std::vector<std::shared_ptr<object::Store>> Query::getStores(
 			idsArg->cend(),
 			result.begin(),
 			[this](const response::IdType& id) noexcept {
-				return std::make_shared<object::Store>(lookup(id));
+				auto store = lookup(id);
+
+				return store ? store->object() : nullptr;
 			});
 	}
 	else
 	{
-		// Just clone the entire vector of stores.
-		result.resize(m_stores->size());
-		std::transform(m_stores->cbegin(),
-			m_stores->cend(),
-			result.begin(),
-			[this](const std::shared_ptr<Store>& store) noexcept {
-				return std::make_shared<object::Store>(store);
-			});
+		// Reuse the wrappers we returned for the same stores last time.
+		result = WrapRows(*m_stores, m_storeObjects);
+	}
+
+	return result;
+}
+
+std::vector<std::shared_ptr<object::Item>> Query::getItems(
+	service::FieldParams&& params, std::vector<ObjectId>&& folderIdsArg)
+{
+	const auto& schema = Item::GetItemSchema();
+	const TableDirectives window { {}, params.fieldDirectives };
+	std::vector<std::shared_ptr<Store>> stores;
+	std::vector<rowset_ptr> sources;
+
+	stores.reserve(folderIdsArg.size());
+	sources.reserve(folderIdsArg.size());
+
+	// MAPI tables must be read on the calling thread, but each folder only reads as many rows as
+	// the merged @offset and @take window could use from that table.
+	for (const auto& folderId : folderIdsArg)
+	{
+		auto store = lookup(folderId.storeId);
+
+		CFRt(store != nullptr);
+
+		auto folder = store->OpenFolder(folderId.objectId);
+
+		CFRt(folder != nullptr);
+
+		// Named properties in @columns or @orderBy are resolved separately in each store.
+		const TableDirectives directives { store, params.fieldDirectives };
+		TagBuffer selected;
+
+		sources.push_back(directives.readHead(folder->itemTable(),
+			directives.select(schema, selected),
+			&schema.sorts()));
+		stores.push_back(std::move(store));
 	}
 
+	std::vector<std::shared_ptr<object::Item>> result {};
+
+	window.merge(sources, &schema.sorts(), [&](size_t source, SRow& row) {
+		const size_t columnCount = static_cast<size_t>(row.cValues);
+		mapi_ptr<SPropValue> columns { row.lpProps };
+
+		row.lpProps = nullptr;
+
+		auto item = std::make_shared<Item>(stores[source], nullptr, columnCount, std::move(columns));
+
+		if (!window.projected())
+		{
+			// Only cache complete items, projected rows are missing some columns.
+			stores[source]->CacheItem(item);
+		}
+
+		result.push_back(item->object());
+	});
+
 	return result;
 }
 
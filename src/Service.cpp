@@ -17,10 +17,16 @@
 
 namespace graphql::mapi {
 
-GQLMAPI_EXPORT std::shared_ptr<service::Request> GetService(bool useDefaultProfile) noexcept
+GQLMAPI_EXPORT std::shared_ptr<service::Request> GetService(const ServiceOptions& options) noexcept
 {
-	auto session = std::make_shared<Session>(useDefaultProfile);
-	auto query = std::make_shared<Query>(session);
+	auto session = std::make_shared<Session>(options.useDefaultProfile);
+	auto query = std::make_shared<Query>(session,
+		options.clearCaches,
+		CacheOptions { options.folderCacheBytes,
+			options.itemCacheBytes,
+			options.namedPropCacheDirectory,
+			options.fragmentCacheBytes,
+			options.cacheStats });
 	auto mutation = std::make_shared<Mutation>(query);
 	auto subscription = std::make_shared<Subscription>(query);
 	auto service = std::make_shared<Operations>(query, mutation, subscription);
@@ -29,4 +35,12 @@ GQLMAPI_EXPORT std::shared_ptr<service::Request> GetService(bool useDefaultProfi
 	return service;
 }
 
+GQLMAPI_EXPORT std::shared_ptr<service::Request> GetService(bool useDefaultProfile) noexcept
+{
+	ServiceOptions options;
+
+	options.useDefaultProfile = useDefaultProfile;
+	return GetService(options);
+}
+
 } // namespace graphql::mapi
\ No newline at end of file
@@ -6,11 +6,24 @@
 #include "Input.h"
 #include "Types.h"
 
+#include "FolderConnectionObject.h"
 #include "FolderObject.h"
 #include "PropertyObject.h"
+#include "StoreObject.h"
 
 namespace graphql::mapi {
 
+namespace {
+
+// Move a MAPI allocation of property values into a shared_ptr, so each Property can hold an
+// aliasing shared_ptr to its own value and the buffer is freed along with the last of them.
+std::shared_ptr<const SPropValue> ShareProps(mapi_ptr<SPropValue>&& props)
+{
+	return std::shared_ptr<SPropValue> { props.release(), ::MAPIFreeBuffer };
+}
+
+} // namespace
+
 // Comparator for mapi_ptr<MAPINAMEID> for std::map
 bool CompareMAPINAMEID::operator()(
 	const mapi_ptr<MAPINAMEID>& lhs, const mapi_ptr<MAPINAMEID>& rhs) const noexcept
@@ -67,21 +80,45 @@ enum class FolderProp : size_t
 	Drafts,	  // PR_IPM_DRAFTS_ENTRYID
 };
 
-constexpr ULONG GetColumnPropType(Store::DefaultColumn column)
+constexpr Store::Schema c_storeSchema {
+	{
+		PR_ENTRYID,
+		PR_DISPLAY_NAME_W,
+	},
+	{
+		SSortOrder { PR_DISPLAY_NAME_W, TABLE_SORT_ASCEND },
+	},
+	{},
+};
+
+// Entry IDs which are known to be missing are remembered for a short time, in case another client
+// creates an object with the same ID again without sending us a notification.
+constexpr auto c_missingIdLifetime = std::chrono::seconds { 30 };
+constexpr size_t c_missingIdLimit = 1024;
+
+// Batches of notifications which can wait for the next operation. If nothing resolves an operation
+// before the queue fills up, the whole queue is dropped and the caches are cleared instead.
+constexpr size_t c_notificationLimit = 1024;
+
+const Store::Schema& Store::GetStoreSchema() noexcept
 {
-	return PROP_TYPE(Store::GetStoreColumns()[static_cast<size_t>(column)]);
+	return c_storeSchema;
 }
 
-static_assert(GetColumnPropType(Store::DefaultColumn::Id) == PT_BINARY, "type mismatch");
-static_assert(GetColumnPropType(Store::DefaultColumn::Name) == PT_UNICODE, "type mismatch");
-
-Store::Store(
-	const CComPtr<IMAPISession>& session, size_t columnCount, mapi_ptr<SPropValue>&& columns)
+Store::Store(const CComPtr<IMAPISession>& session, const CacheOptions& cacheOptions,
+	size_t columnCount, mapi_ptr<SPropValue>&& columns)
 	: m_session { session }
 	, m_columnCount { columnCount }
 	, m_columns { std::move(columns) }
-	, m_id { GetIdColumn(DefaultColumn::Id) }
-	, m_name { GetStringColumn(DefaultColumn::Name) }
+	, m_id { GetIdColumn<DefaultColumn::Id>() }
+	, m_name { GetStringColumn<DefaultColumn::Name>() }
+	, m_namedPropCache { cacheOptions.namedPropDirectory.empty()
+			  ? nullptr
+			  : std::make_unique<NamedPropCache>(cacheOptions.namedPropDirectory, m_id) }
+	, m_folderCache { cacheOptions.folderBytes }
+	, m_itemCache { cacheOptions.itemBytes }
+	, m_fragmentCache { cacheOptions.fragmentBytes }
+	, m_missingIds { c_missingIdLifetime, c_missingIdLimit }
 {
 }
 
@@ -92,6 +129,21 @@ Store::~Store()
 	{
 		m_rootFolderSink->Unadvise();
 	}
+
+	if (m_hierarchySink)
+	{
+		m_hierarchySink->Unadvise();
+	}
+
+	if (m_cacheSink)
+	{
+		m_cacheSink->Unadvise();
+	}
+}
+
+std::shared_ptr<object::Store> Store::object()
+{
+	return m_object.get(shared_from_this());
 }
 
 const CComPtr<IMsgStore>& Store::store()
@@ -120,14 +172,14 @@ std::shared_ptr<Folder> Store::lookupRootFolder(const response::IdType& id)
 {
 	LoadRootFolders({});
 
-	auto itr = m_rootFolderIds->find(id);
+	const auto index = m_rootFolderIds->find(id);
 
-	if (itr == m_rootFolderIds->cend())
+	if (!index)
 	{
 		return nullptr;
 	}
 
-	return m_rootFolders->at(itr->second);
+	return m_rootFolders->at(*index);
 }
 
 const std::map<SpecialFolder, response::IdType>& Store::specialFolders()
@@ -150,12 +202,90 @@ std::shared_ptr<Folder> Store::lookupSpecialFolder(SpecialFolder id)
 	return OpenFolder(itr->second);
 }
 
-std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIdInputs(
-	std::vector<PropIdInput>&& namedProps)
+std::optional<SpecialFolder> Store::classifySpecialFolder(const response::IdType& folderId)
+{
+	LoadSpecialFolders();
+
+	// A canonical match doesn't need a round trip to the store provider, but anything else still
+	// has to be compared with CompareEntryIDs.
+	return m_specialFolderIds->find(folderId,
+		[this](const response::IdType& lhs, const response::IdType& rhs) {
+			ULONG result = 0;
+
+			const HRESULT hr = m_store->CompareEntryIDs(static_cast<ULONG>(lhs.size()),
+				reinterpret_cast<LPENTRYID>(const_cast<response::IdType&>(lhs).data()),
+				static_cast<ULONG>(rhs.size()),
+				reinterpret_cast<LPENTRYID>(const_cast<response::IdType&>(rhs).data()),
+				0,
+				&result);
+
+			return SUCCEEDED(hr) && result != 0;
+		});
+}
+
+std::shared_ptr<Folder> Store::lookupHierarchyChild(
+	const std::shared_ptr<Folder>& parentFolder, const response::IdType& id)
+{
+	LoadHierarchy();
+
+	const auto index = m_hierarchyIds->find(id);
+
+	if (!index)
+	{
+		return nullptr;
+	}
+
+	const auto& node = m_hierarchy->at(*index);
+
+	if (!node.parent)
+	{
+		return parentFolder ? nullptr : node.folder;
+	}
+
+	return (parentFolder && m_hierarchy->at(*node.parent).folder->id() == parentFolder->id())
+		? node.folder
+		: nullptr;
+}
+
+std::optional<std::vector<std::shared_ptr<Folder>>> Store::lookupHierarchyChildren(
+	const Folder& parentFolder)
+{
+	LoadHierarchy();
+
+	const std::vector<size_t>* children = nullptr;
+
+	if (parentFolder.id() == m_rootId)
+	{
+		children = &m_hierarchyRoots;
+	}
+	else if (const auto index = m_hierarchyIds->find(parentFolder.id()))
+	{
+		children = &m_hierarchy->at(*index).children;
+	}
+	else
+	{
+		return std::nullopt;
+	}
+
+	std::vector<std::shared_ptr<Folder>> result(children->size());
+
+	std::transform(children->cbegin(),
+		children->cend(),
+		result.begin(),
+		[this](size_t index) noexcept {
+			return m_hierarchy->at(index).folder;
+		});
+
+	return std::make_optional(std::move(result));
+}
+
+std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIdInputs(
+	std::span<const PropIdInput> namedProps, std::pmr::memory_resource* arena)
 {
-	std::vector<std::pair<ULONG, LPMAPINAMEID>> result(namedProps.size());
-	std::vector<std::pair<mapi_ptr<MAPINAMEID>, size_t>> resolve;
+	std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> result(namedProps.size(), arena);
+	std::pmr::vector<std::pair<mapi_ptr<MAPINAMEID>, size_t>> resolve { arena };
 
+	LoadNamedPropCache();
 	resolve.reserve(namedProps.size());
 	for (size_t i = 0; i < namedProps.size(); ++i)
 	{
@@ -229,10 +359,9 @@ std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIdInputs(
 
 	if (!resolve.empty())
 	{
-		std::vector<LPMAPINAMEID> pmnids;
+		std::pmr::vector<LPMAPINAMEID> pmnids(resolve.size(), arena);
 		mapi_ptr<SPropTagArray> namedPropIds;
 
-		pmnids.resize(resolve.size());
 		std::transform(resolve.cbegin(),
 			resolve.cend(),
 			pmnids.begin(),
@@ -263,16 +392,20 @@ std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIdInputs(
 
 			result[offset] = std::make_pair(propId, itr->first.get());
 		}
+
+		SaveNamedPropCache();
 	}
 
 	return result;
 }
 
-std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIds(const std::vector<ULONG>& propIds)
+std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIds(
+	std::span<const ULONG> propIds, std::pmr::memory_resource* arena)
 {
-	std::vector<std::pair<ULONG, LPMAPINAMEID>> result(propIds.size());
-	std::vector<std::pair<ULONG, size_t>> resolve;
+	std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> result(propIds.size(), arena);
+	std::pmr::vector<std::pair<ULONG, size_t>> resolve { arena };
 
+	LoadNamedPropCache();
 	resolve.reserve(propIds.size());
 	for (size_t i = 0; i < propIds.size(); ++i)
 	{
@@ -339,7 +472,7 @@ std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIds(const std::vect
 				reinterpret_cast<void**>(&out_ptr { namedId })));
 
 			namedId->lpguid = reinterpret_cast<LPGUID>(namedId.get() + 1);
-			memmove(namedId->lpguid, name->lpguid, sizeof(namedId->lpguid));
+			memmove(namedId->lpguid, name->lpguid, sizeof(*namedId->lpguid));
 			namedId->ulKind = name->ulKind;
 
 			if (name->ulKind == MNID_STRING)
@@ -364,11 +497,69 @@ std::vector<std::pair<ULONG, LPMAPINAMEID>> Store::lookupPropIds(const std::vect
 
 			result[offset] = std::make_pair(itr->second, itr->first.get());
 		}
+
+		SaveNamedPropCache();
 	}
 
 	return result;
 }
 
+void Store::LoadNamedPropCache()
+{
+	if (!m_namedPropCache || m_namedPropCache->loaded())
+	{
+		return;
+	}
+
+	// The file is only valid for the same named property mappings, which may change if the store
+	// is re-created with the same ID. Stores which share their mappings have the same
+	// PR_MAPPING_SIGNATURE, otherwise the PR_RECORD_KEY identifies this instance of the store.
+	SizedSPropTagArray(2, signatureProps) = { 2,
+		{
+			PR_MAPPING_SIGNATURE,
+			PR_RECORD_KEY,
+		} };
+	ULONG cValues = 0;
+	mapi_ptr<SPropValue> signatureValues;
+
+	if (FAILED(store()->GetProps(reinterpret_cast<LPSPropTagArray>(&signatureProps),
+			0,
+			&cValues,
+			&out_ptr { signatureValues }))
+		|| nullptr == signatureValues || cValues != signatureProps.cValues)
+	{
+		m_namedPropCache.reset();
+		return;
+	}
+
+	const auto itrSignature = std::find_if(signatureValues.get(),
+		signatureValues.get() + cValues,
+		[](const SPropValue& value) noexcept {
+			return PROP_TYPE(value.ulPropTag) == PT_BINARY && value.Value.bin.cb > 0;
+		});
+
+	if (itrSignature == signatureValues.get() + cValues)
+	{
+		// Without a signature there's no way to tell if the file is stale, so don't use it.
+		m_namedPropCache.reset();
+		return;
+	}
+
+	const auto signatureBegin = reinterpret_cast<std::uint8_t*>(itrSignature->Value.bin.lpb);
+	const auto signatureEnd = signatureBegin + itrSignature->Value.bin.cb;
+	auto cached = m_namedPropCache->load(response::IdType { signatureBegin, signatureEnd });
+
+	m_nameIdToPropIds.merge(cached);
+}
+
+void Store::SaveNamedPropCache()
+{
+	if (m_namedPropCache)
+	{
+		m_namedPropCache->save(m_nameIdToPropIds);
+	}
+}
+
 const SPropValue& Store::GetColumnProp(DefaultColumn column) const
 {
 	const auto index = static_cast<size_t>(column);
@@ -378,9 +569,12 @@ const SPropValue& Store::GetColumnProp(DefaultColumn column) const
 	return m_columns.get()[index];
 }
 
-response::IdType Store::GetIdColumn(DefaultColumn column) const
+template <Store::DefaultColumn Column>
+response::IdType Store::GetIdColumn() const
 {
-	const auto& idProp = GetColumnProp(column);
+	static_assert(c_storeSchema.propType(Column) == PT_BINARY, "type mismatch");
+
+	const auto& idProp = GetColumnProp(Column);
 
 	if (PROP_TYPE(idProp.ulPropTag) != PT_BINARY)
 	{
@@ -393,9 +587,12 @@ response::IdType Store::GetIdColumn(DefaultColumn column) const
 	return { idBegin, idEnd };
 }
 
-std::string Store::GetStringColumn(DefaultColumn column) const
+template <Store::DefaultColumn Column>
+std::string Store::GetStringColumn() const
 {
-	const auto& stringProp = GetColumnProp(column);
+	static_assert(c_storeSchema.propType(Column) == PT_UNICODE, "type mismatch");
+
+	const auto& stringProp = GetColumnProp(Column);
 
 	if (PROP_TYPE(stringProp.ulPropTag) != PT_UNICODE)
 	{
@@ -406,19 +603,20 @@ std::string Store::GetStringColumn(DefaultColumn column) const
 }
 
 std::vector<std::shared_ptr<object::Property>> Store::GetColumns(
-	size_t columnCount, const LPSPropValue columns)
+	size_t columnCount, const LPSPropValue columns, std::pmr::memory_resource* arena)
 {
-	std::map<ULONG, Property::id_variant> idMap;
-	std::vector<std::pair<Property::id_variant, mapi_ptr<SPropValue>>> idValuePairs;
+	std::pmr::map<ULONG, Property::id_variant> idMap { arena };
+	std::pmr::vector<std::pair<Property::id_variant, std::shared_ptr<const SPropValue>>>
+		idValuePairs { arena };
 	LPSPropValue propBegin = columns;
 	LPSPropValue propEnd = columns + columnCount;
-	std::vector<ULONG> propIds(columnCount);
+	std::pmr::vector<ULONG> propIds(columnCount, arena);
 
 	std::transform(propBegin, propEnd, propIds.begin(), [](const SPropValue& value) noexcept {
 		return value.ulPropTag;
 	});
 
-	auto resolved = lookupPropIds(propIds);
+	auto resolved = lookupPropIds(propIds, arena);
 
 	for (const auto& entry : resolved)
 	{
@@ -438,20 +636,31 @@ std::vector<std::shared_ptr<object::Property>> Store::GetColumns(
 	// Double check that we mapped all of the property IDs.
 	CFRt(idMap.size() == columnCount);
 
-	// Split the values allocation into a separate buffer for each property.
-	idValuePairs.reserve(columnCount);
-	std::transform(propBegin,
-		propEnd,
-		std::back_insert_iterator(idValuePairs),
-		[&idMap](SPropValue& prop) {
-			mapi_ptr<SPropValue> dupe;
+	if (columnCount == 0)
+	{
+		return {};
+	}
+
+	// Copy all of the values into a single allocation, which the properties share.
+	mapi_ptr<SPropValue> dupe;
+
+	CORt(ScDupPropset(static_cast<int>(columnCount),
+		propBegin,
+		::MAPIAllocateBuffer,
+		&out_ptr { dupe }));
+	CFRt(dupe != nullptr);
 
-			CORt(ScDupPropset(1, &prop, ::MAPIAllocateBuffer, &out_ptr { dupe }));
-			CFRt(dupe != nullptr);
+	const auto values = ShareProps(std::move(dupe));
 
+	idValuePairs.reserve(columnCount);
+	std::transform(values.get(),
+		values.get() + columnCount,
+		std::back_insert_iterator(idValuePairs),
+		[&idMap, &values](const SPropValue& prop) {
 			const ULONG propId = PROP_ID(prop.ulPropTag);
 
-			return std::make_pair(std::move(idMap[propId]), std::move(dupe));
+			return std::make_pair(std::move(idMap[propId]),
+				std::shared_ptr<const SPropValue> { values, &prop });
 		});
 
 	std::vector<std::shared_ptr<object::Property>> result(idValuePairs.size());
@@ -464,11 +673,54 @@ std::vector<std::shared_ptr<object::Property>> Store::GetColumns(
 	return result;
 }
 
-std::vector<std::shared_ptr<object::Property>> Store::GetProperties(
-	IMAPIProp* pObject, std::optional<std::vector<Column>>&& idsArg)
+std::vector<std::shared_ptr<object::Property>> Store::GetColumnFragment(const response::IdType& id,
+	size_t columnCount, const LPSPropValue columns, size_t offset, std::pmr::memory_resource* arena)
+{
+	CFRt(columnCount >= offset);
+
+	std::optional<response::IdType> key;
+
+	if (m_fragmentCache.budget() != 0)
+	{
+		key = ColumnFragment::MakeKey(id, columnCount, columns, offset);
+
+		if (key)
+		{
+			std::lock_guard lock { m_cacheMutex };
+
+			if (auto fragment = m_fragmentCache.find(*key))
+			{
+				return fragment->columns();
+			}
+		}
+	}
+
+	auto result = GetColumns(columnCount - offset, columns + offset, arena);
+
+	if (key)
+	{
+		// The Property objects hold a copy of each value, and each of them has an object wrapper.
+		const size_t bytes = sizeof(ColumnFragment) + key->size()
+			+ GetRowBytes(static_cast<ULONG>(columnCount - offset), columns + offset)
+			+ result.size() * (sizeof(Property) + sizeof(object::Property));
+
+		auto fragment = std::make_shared<ColumnFragment>(std::move(*key),
+			bytes,
+			std::vector<std::shared_ptr<object::Property>> { result });
+		std::lock_guard lock { m_cacheMutex };
+
+		m_fragmentCache.insert(fragment);
+	}
+
+	return result;
+}
+
+std::vector<std::shared_ptr<object::Property>> Store::GetProperties(IMAPIProp* pObject,
+	std::optional<std::vector<Column>>&& idsArg, std::pmr::memory_resource* arena)
 {
-	std::map<ULONG, Property::id_variant> idMap;
-	std::vector<std::pair<Property::id_variant, mapi_ptr<SPropValue>>> idValuePairs;
+	std::pmr::map<ULONG, Property::id_variant> idMap { arena };
+	std::pmr::vector<std::pair<Property::id_variant, std::shared_ptr<const SPropValue>>>
+		idValuePairs { arena };
 	ULONG cValues = 0;
 	mapi_ptr<SPropValue> props;
 	LPSPropValue propBegin = nullptr;
@@ -477,7 +729,7 @@ std::vector<std::shared_ptr<object::Property>> Store::GetProperties(
 	if (idsArg && !idsArg->empty())
 	{
 		// Only get selected properties.
-		std::vector<PropIdInput> inputs(idsArg->size());
+		std::pmr::vector<PropIdInput> inputs(idsArg->size(), arena);
 
 		std::transform(idsArg->cbegin(),
 			idsArg->cend(),
@@ -486,7 +738,7 @@ std::vector<std::shared_ptr<object::Property>> Store::GetProperties(
 				return column.property;
 			});
 
-		auto resolved = lookupPropIdInputs(std::move(inputs));
+		auto resolved = lookupPropIdInputs(inputs, arena);
 
 		CFRt(resolved.size() == idsArg->size());
 
@@ -549,13 +801,13 @@ std::vector<std::shared_ptr<object::Property>> Store::GetProperties(
 		propBegin = props.get();
 		propEnd = propBegin + static_cast<size_t>(cValues);
 
-		std::vector<ULONG> propIds(static_cast<size_t>(cValues));
+		std::pmr::vector<ULONG> propIds(static_cast<size_t>(cValues), arena);
 
 		std::transform(propBegin, propEnd, propIds.begin(), [](const SPropValue& value) noexcept {
 			return value.ulPropTag;
 		});
 
-		auto resolved = lookupPropIds(propIds);
+		auto resolved = lookupPropIds(propIds, arena);
 
 		for (const auto& entry : resolved)
 		{
@@ -576,20 +828,18 @@ std::vector<std::shared_ptr<object::Property>> Store::GetProperties(
 	// Double check that we mapped all of the property IDs.
 	CFRt(idMap.size() == static_cast<size_t>(cValues));
 
-	// Split the values allocation into a separate buffer for each property.
+	// Each property points into the GetProps result, which they all share.
+	const auto values = ShareProps(std::move(props));
+
 	idValuePairs.reserve(static_cast<size_t>(cValues));
 	std::transform(propBegin,
 		propEnd,
 		std::back_insert_iterator(idValuePairs),
-		[&idMap](SPropValue& prop) {
-			mapi_ptr<SPropValue> dupe;
-
-			CORt(ScDupPropset(1, &prop, ::MAPIAllocateBuffer, &out_ptr { dupe }));
-			CFRt(dupe != nullptr);
-
+		[&idMap, &values](const SPropValue& prop) {
 			const ULONG propId = PROP_ID(prop.ulPropTag);
 
-			return std::make_pair(std::move(idMap[propId]), std::move(dupe));
+			return std::make_pair(std::move(idMap[propId]),
+				std::shared_ptr<const SPropValue> { values, &prop });
 		});
 
 	std::vector<std::shared_ptr<object::Property>> result(idValuePairs.size());
@@ -612,7 +862,7 @@ void Store::ConvertPropertyInputs(void* pAllocMore, LPSPropValue propBegin, LPSP
 		return propId;
 	});
 
-	auto resolved = lookupPropIdInputs(std::move(propIds));
+	auto resolved = lookupPropIdInputs(propIds);
 
 	CFRt(resolved.size() == input.size());
 	for (size_t i = 0; i < resolved.size(); ++i)
@@ -686,7 +936,7 @@ void Store::ConvertPropertyInputs(void* pAllocMore, LPSPropValue propBegin, LPSP
 			CFRt(!value.bin);
 			CFRt(!value.stream);
 
-			const auto& str = value.guid->get<std::string>();
+			const auto& str = value.time->get<std::string>();
 
 			prop.ulPropTag = PROP_TAG(PT_SYSTIME, propId);
 			prop.Value.ft = convert::datetime::from_string(str);
@@ -720,33 +970,61 @@ void Store::ConvertPropertyInputs(void* pAllocMore, LPSPropValue propBegin, LPSP
 
 std::shared_ptr<Folder> Store::OpenFolder(const response::IdType& folderId)
 {
-	auto itr = m_folderCache.find(folderId);
+	{
+		std::lock_guard lock { m_cacheMutex };
+
+		if (auto cached = m_folderCache.find(folderId))
+		{
+			return cached;
+		}
+	}
 
-	if (itr != m_folderCache.cend())
+	if (m_missingIds.contains(folderId))
 	{
-		return itr->second;
+		return nullptr;
+	}
+
+	if (m_hierarchyIds)
+	{
+		// Use the hierarchy snapshot if it's already loaded, but don't read it just for this.
+		if (const auto index = m_hierarchyIds->find(folderId))
+		{
+			return m_hierarchy->at(*index).folder;
+		}
 	}
 
 	ULONG objType = 0;
 	CComPtr<IMAPIFolder> folder;
+	// Open the store first, which also reads the root folder ID.
+	const auto& msgStore = store();
+	const auto& entryId = folderId.empty() ? m_rootId : folderId;
+	const HRESULT hr = msgStore->OpenEntry(static_cast<ULONG>(entryId.size()),
+		reinterpret_cast<LPENTRYID>(const_cast<response::IdType&>(entryId).data()),
+		&IID_IMAPIFolder,
+		MAPI_BEST_ACCESS | MAPI_DEFERRED_ERRORS,
+		&objType,
+		reinterpret_cast<LPUNKNOWN*>(&folder));
 
-	CORt(
-		store()->OpenEntry(static_cast<ULONG>(folderId.empty() ? m_rootId.size() : folderId.size()),
-			reinterpret_cast<LPENTRYID>(
-				const_cast<response::IdType&>(folderId.empty() ? m_rootId : folderId).data()),
-			&IID_IMAPIFolder,
-			MAPI_BEST_ACCESS | MAPI_DEFERRED_ERRORS,
-			&objType,
-			reinterpret_cast<LPUNKNOWN*>(&folder)));
+	if (hr == MAPI_E_NOT_FOUND && !folderId.empty())
+	{
+		// Remember the miss, so we don't need to ask MAPI again until it expires.
+		m_missingIds.insert(folderId);
+		return nullptr;
+	}
+
+	CORt(hr);
 	CFRt(folder != nullptr);
 	CFRt(objType == MAPI_FOLDER);
 
-	auto folderProps = GetFolderProperties();
+	const auto& folderProps = Folder::GetFolderSchema().columns();
 	ULONG cValues = 0;
 	mapi_ptr<SPropValue> values;
 
-	CORt(folder->GetProps(folderProps.get(), MAPI_UNICODE, &cValues, &out_ptr { values }));
-	CFRt(cValues == folderProps->cValues);
+	CORt(folder->GetProps(const_cast<LPSPropTagArray>(&folderProps),
+		MAPI_UNICODE,
+		&cValues,
+		&out_ptr { values }));
+	CFRt(cValues == folderProps.cValues);
 	CFRt(values != nullptr);
 
 	auto result = std::make_shared<Folder>(shared_from_this(),
@@ -760,31 +1038,49 @@ std::shared_ptr<Folder> Store::OpenFolder(const response::IdType& folderId)
 
 std::shared_ptr<Item> Store::OpenItem(const response::IdType& itemId)
 {
-	auto itr = m_itemCache.find(itemId);
+	{
+		std::lock_guard lock { m_cacheMutex };
+
+		if (auto cached = m_itemCache.find(itemId))
+		{
+			return cached;
+		}
+	}
 
-	if (itr != m_itemCache.cend())
+	if (m_missingIds.contains(itemId))
 	{
-		return itr->second;
+		return nullptr;
 	}
 
 	ULONG objType = 0;
 	CComPtr<IMessage> item;
-
-	CORt(store()->OpenEntry(static_cast<ULONG>(itemId.size()),
+	const HRESULT hr = store()->OpenEntry(static_cast<ULONG>(itemId.size()),
 		reinterpret_cast<LPENTRYID>(const_cast<response::IdType&>(itemId).data()),
 		&IID_IMessage,
 		MAPI_BEST_ACCESS | MAPI_DEFERRED_ERRORS,
 		&objType,
-		reinterpret_cast<LPUNKNOWN*>(&item)));
+		reinterpret_cast<LPUNKNOWN*>(&item));
+
+	if (hr == MAPI_E_NOT_FOUND)
+	{
+		// Remember the miss, so we don't need to ask MAPI again until it expires.
+		m_missingIds.insert(itemId);
+		return nullptr;
+	}
+
+	CORt(hr);
 	CFRt(item != nullptr);
 	CFRt(objType == MAPI_MESSAGE);
 
-	auto itemProps = GetItemProperties();
+	const auto& itemProps = Item::GetItemSchema().columns();
 	ULONG cValues = 0;
 	mapi_ptr<SPropValue> values;
 
-	CORt(item->GetProps(itemProps.get(), MAPI_UNICODE, &cValues, &out_ptr { values }));
-	CFRt(cValues == itemProps->cValues);
+	CORt(item->GetProps(const_cast<LPSPropTagArray>(&itemProps),
+		MAPI_UNICODE,
+		&cValues,
+		&out_ptr { values }));
+	CFRt(cValues == itemProps.cValues);
 	CFRt(values != nullptr);
 
 	auto result = std::make_shared<Item>(shared_from_this(),
@@ -798,18 +1094,161 @@ std::shared_ptr<Item> Store::OpenItem(const response::IdType& itemId)
 
 void Store::CacheFolder(const std::shared_ptr<Folder>& folder)
 {
-	m_folderCache.insert(std::make_pair(folder->id(), folder));
+	std::lock_guard lock { m_cacheMutex };
+
+	m_folderCache.insert(folder);
 }
 
 void Store::CacheItem(const std::shared_ptr<Item>& item)
 {
-	m_itemCache.insert(std::make_pair(item->id(), item));
+	std::lock_guard lock { m_cacheMutex };
+
+	m_itemCache.insert(item);
 }
 
 void Store::ClearCaches()
 {
-	m_folderCache.clear();
-	m_itemCache.clear();
+	{
+		std::lock_guard lock { m_cacheMutex };
+
+		m_folderCache.clear();
+		m_itemCache.clear();
+		m_resizedFolders.clear();
+		m_resizedItems.clear();
+	}
+
+	m_missingIds.clear();
+	m_hierarchy.reset();
+	m_hierarchyIds.reset();
+}
+
+void Store::ExpireCaches()
+{
+	if (!m_cacheSink)
+	{
+		ClearCaches();
+		return;
+	}
+
+	MeasureCachedObjects();
+}
+
+void Store::QueueNotifications(
+	size_t count, LPNOTIFICATION notifications, NotificationCallback&& callback)
+{
+	if (0 == count || nullptr == notifications)
+	{
+		return;
+	}
+
+	// The notifications and everything they point to are only valid during OnNotify, so copy them
+	// into a single allocation. This runs on the MAPI notification thread, so if it fails, treat it
+	// like an overflow instead of throwing.
+	const int cNotifications = static_cast<int>(count);
+	ULONG cb = 0;
+	mapi_ptr<NOTIFICATION> copied;
+
+	const bool copiedBatch = SUCCEEDED(::ScCountNotifications(cNotifications, notifications, &cb))
+		&& SUCCEEDED(::MAPIAllocateBuffer(cb, reinterpret_cast<void**>(&out_ptr { copied })))
+		&& SUCCEEDED(::ScCopyNotifications(cNotifications, notifications, copied.get(), &cb));
+
+	std::lock_guard lock { m_notificationMutex };
+
+	if (m_notificationsOverflowed)
+	{
+		return;
+	}
+
+	if (!copiedBatch || m_notifications.size() >= c_notificationLimit)
+	{
+		m_notifications.clear();
+		m_notificationsOverflowed = true;
+		return;
+	}
+
+	m_notifications.push_back({ std::move(callback), count, std::move(copied) });
+}
+
+void Store::ApplyNotifications()
+{
+	std::vector<QueuedNotifications> notifications;
+	bool overflowed = false;
+
+	{
+		std::lock_guard lock { m_notificationMutex };
+
+		notifications.swap(m_notifications);
+		overflowed = std::exchange(m_notificationsOverflowed, false);
+	}
+
+	if (overflowed)
+	{
+		// Some notifications were dropped, so none of the cached folders or windows can be trusted.
+		ClearCaches();
+		m_rootFolders.reset();
+
+		if (m_rootFolderTable)
+		{
+			m_rootFolderTable->discardPages();
+		}
+
+		return;
+	}
+
+	for (auto& entry : notifications)
+	{
+		entry.callback(*this, entry.count, entry.notifications.get());
+	}
+
+	// Subscriptions may have decoded more strings since the last operation.
+	MeasureCachedObjects();
+}
+
+void Store::UpdateCachedFolder(const Folder& folder)
+{
+	std::lock_guard lock { m_cacheMutex };
+
+	m_resizedFolders.push_back(folder.weak_from_this());
+}
+
+void Store::UpdateCachedItem(const Item& item)
+{
+	std::lock_guard lock { m_cacheMutex };
+
+	m_resizedItems.push_back(item.weak_from_this());
+}
+
+void Store::AddCacheStats(CacheStats& stats)
+{
+	std::lock_guard lock { m_cacheMutex };
+
+	stats.folders += m_folderCache.counters();
+	stats.items += m_itemCache.counters();
+	stats.fragments += m_fragmentCache.counters();
+}
+
+void Store::MeasureCachedObjects()
+{
+	std::lock_guard lock { m_cacheMutex };
+
+	for (const auto& entry : m_resizedFolders)
+	{
+		if (const auto folder = entry.lock())
+		{
+			m_folderCache.update(*folder);
+		}
+	}
+
+	for (const auto& entry : m_resizedItems)
+	{
+		if (const auto item = entry.lock())
+		{
+			m_itemCache.update(*item);
+		}
+	}
+
+	m_resizedFolders.clear();
+	m_resizedItems.clear();
 }
 
 void Store::OpenStore()
@@ -826,6 +1265,8 @@ void Store::OpenStore()
 		MAPI_BEST_ACCESS | MAPI_DEFERRED_ERRORS,
 		&m_store));
 
+	AdviseCaches();
+
 	// These properties always come from the IMsgStore.
 	SizedSPropTagArray(4, storeIdProps) = { 4,
 		{
@@ -919,6 +1360,130 @@ void Store::OpenStore()
 	}
 }
 
+void Store::AdviseCaches()
+{
+	auto spThis = shared_from_this();
+	CComPtr<AdviseSinkProxy<IMsgStore>> sinkProxy;
+	ULONG_PTR connectionId = 0;
+
+	sinkProxy.Attach(new AdviseSinkProxy<IMsgStore>(
+		[wpStore = std::weak_ptr { spThis }](size_t count, LPNOTIFICATION notifications) {
+			auto spStore = wpStore.lock();
+
+			if (spStore)
+			{
+				spStore->QueueNotifications(count, notifications, &Store::InvalidateCaches);
+			}
+		}));
+
+	// Passing a NULL entry ID registers for notifications on every object in the store. If the
+	// store doesn't support that, ExpireCaches falls back to clearing the caches after every
+	// operation.
+	if (FAILED(m_store->Advise(0,
+			nullptr,
+			fnevObjectCreated | fnevObjectModified | fnevObjectDeleted | fnevObjectMoved
+				| fnevObjectCopied,
+			sinkProxy,
+			&connectionId)))
+	{
+		return;
+	}
+
+	sinkProxy->OnAdvise(m_store, connectionId);
+	m_cacheSink = sinkProxy;
+}
+
+void Store::InvalidateCaches(size_t count, LPNOTIFICATION notifications)
+{
+	if (0 == count || nullptr == notifications)
+	{
+		return;
+	}
+
+	const auto getId = [](ULONG cbEntryId, LPENTRYID lpEntryId) {
+		const auto beginId = reinterpret_cast<const std::uint8_t*>(lpEntryId);
+
+		return (cbEntryId == 0 || lpEntryId == nullptr)
+			? std::nullopt
+			: std::make_optional<response::IdType>(beginId,
+				beginId + static_cast<size_t>(cbEntryId));
+	};
+	const auto erase = [this, &getId](ULONG cbEntryId, LPENTRYID lpEntryId) {
+		if (const auto id = getId(cbEntryId, lpEntryId))
+		{
+			std::lock_guard lock { m_cacheMutex };
+
+			m_folderCache.erase(*id);
+			m_itemCache.erase(*id);
+		}
+	};
+
+	// Remember which IDs were deleted or moved away, and forget about any which exist again.
+	const auto missing = [this, &getId](ULONG cbEntryId, LPENTRYID lpEntryId) {
+		if (const auto id = getId(cbEntryId, lpEntryId))
+		{
+			m_missingIds.insert(*id);
+		}
+	};
+	const auto found = [this, &getId](ULONG cbEntryId, LPENTRYID lpEntryId) {
+		if (const auto id = getId(cbEntryId, lpEntryId))
+		{
+			m_missingIds.erase(*id);
+		}
+	};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& notif = notifications[i];
+
+		switch (notif.ulEventType)
+		{
+			case fnevObjectCreated:
+			case fnevObjectModified:
+			case fnevObjectDeleted:
+			case fnevObjectMoved:
+			case fnevObjectCopied:
+			{
+				// Creating, deleting, or moving an item also changes the counts on the parent
+				// folders, so remove them along with the object itself.
+				const auto& obj = notif.info.obj;
+
+				erase(obj.cbEntryID, obj.lpEntryID);
+				erase(obj.cbParentID, obj.lpParentID);
+				erase(obj.cbOldID, obj.lpOldID);
+				erase(obj.cbOldParentID, obj.lpOldParentID);
+
+				if (notif.ulEventType == fnevObjectDeleted)
+				{
+					missing(obj.cbEntryID, obj.lpEntryID);
+				}
+				else
+				{
+					found(obj.cbEntryID, obj.lpEntryID);
+				}
+
+				if (notif.ulEventType == fnevObjectMoved)
+				{
+					// The old entry ID is gone, unless the store kept the same ID.
+					const auto oldId = getId(obj.cbOldID, obj.lpOldID);
+
+					if (oldId && oldId != getId(obj.cbEntryID, obj.lpEntryID))
+					{
+						m_missingIds.insert(*oldId);
+					}
+				}
+
+				break;
+			}
+
+			default:
+				// Anything else might have changed any of the cached objects.
+				ClearCaches();
+				return;
+		}
+	}
+}
+
 void Store::LoadSpecialFolders()
 {
 	if (m_specialFolders)
@@ -956,78 +1521,236 @@ void Store::LoadSpecialFolders()
 
 		m_specialFolders->insert(std::make_pair(specialFolder, std::move(id)));
 	}
+
+	// Index the canonical entry IDs, so classifySpecialFolder can usually skip CompareEntryIDs for
+	// the special folders themselves.
+	m_specialFolderIds = std::make_unique<CanonicalEntryIdIndex<SpecialFolder>>();
+
+	for (const auto& entry : *m_specialFolders)
+	{
+		m_specialFolderIds->insert(entry.second, entry.first);
+	}
 }
 
-void Store::LoadRootFolders(service::Directives&& fieldDirectives)
+TableHandle& Store::hierarchyTable()
 {
-	if (m_rootFolderDirectives != fieldDirectives)
+	if (!m_hierarchyTable)
 	{
-		// Reset the subFolders and reload if the directives change
-		m_rootFolders.reset();
-		m_rootFolderDirectives = std::move(fieldDirectives);
+		CComPtr<IMAPITable> sptable;
+
+		OpenStore();
+
+		CORt(m_ipmSubtree->GetHierarchyTable(CONVENIENT_DEPTH | MAPI_DEFERRED_ERRORS | MAPI_UNICODE,
+			&sptable));
+
+		auto spThis = shared_from_this();
+		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
+		ULONG_PTR connectionId = 0;
+
+		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>(
+			[wpStore = std::weak_ptr { spThis }](size_t count, LPNOTIFICATION pNotifications) {
+				auto spStore = wpStore.lock();
+
+				if (spStore)
+				{
+					spStore->QueueNotifications(count,
+						pNotifications,
+						&Store::ApplyHierarchyNotifications);
+				}
+			}));
+
+		CORt(sptable->Advise(fnevTableModified, sinkProxy, &connectionId));
+		sinkProxy->OnAdvise(sptable, connectionId);
+
+		m_hierarchySink = sinkProxy;
+		m_hierarchyTable = std::make_unique<TableHandle>(sptable);
 	}
 
-	if (m_rootFolders)
+	return *m_hierarchyTable;
+}
+
+void Store::LoadHierarchy()
+{
+	if (m_hierarchy)
 	{
 		return;
 	}
 
-	m_rootFolderIds = std::make_unique<std::map<response::IdType, size_t>>();
-	m_rootFolders = std::make_unique<std::vector<std::shared_ptr<Folder>>>();
+	auto& table = hierarchyTable();
+	auto hierarchy = std::make_unique<std::vector<HierarchyNode>>();
+	auto hierarchyIds = std::make_unique<EntryIdIndex<size_t>>();
+
+	// Read the default folder columns, followed by PR_DEPTH.
+	const auto& folderSchema = Folder::GetFolderSchema();
+	const auto& folderColumns = folderSchema.columns();
+	const size_t columnCount = static_cast<size_t>(folderColumns.cValues);
+	TagBuffer columns;
+
+	columns.assign({ static_cast<ULONG>(1 + columnCount) });
+	columns.append(folderColumns.aulPropTag, folderColumns.aulPropTag + columnCount);
+	columns.push_back(PR_DEPTH);
+
+	// Sort it like the default subFolders order. With CONVENIENT_DEPTH, the store sorts the
+	// children of each folder and keeps them after their parent, so the children in the snapshot
+	// end up in the same order as the subFolders table, with the store's own string comparison.
+	table.setColumns(*reinterpret_cast<const SPropTagArray*>(columns.data()));
+	table.sortTable(&folderSchema.sorts());
+	CORt(table.table()->SeekRow(BOOKMARK_BEGINNING, 0, nullptr));
+
+	// The rows come back in hierarchy order, so the ancestors of each row are the last rows we read
+	// at each of the lower depths.
+	std::vector<size_t> ancestors;
+	std::vector<size_t> roots;
+	auto spThis = shared_from_this();
+
+	while (true)
+	{
+		rowset_ptr sprows;
 
-	auto folderProps = GetFolderProperties();
-	constexpr auto c_folderSorts = Folder::GetFolderSorts();
-	mapi_ptr<SSortOrderSet> folderSorts;
+		CORt(table.table()->QueryRows(500, 0, &out_ptr { sprows }));
 
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_folderSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { folderSorts })));
-	CFRt(folderSorts != nullptr);
-	folderSorts->cSorts = static_cast<ULONG>(c_folderSorts.size());
-	folderSorts->cCategories = 0;
-	folderSorts->cExpanded = 0;
-	std::copy(c_folderSorts.begin(), c_folderSorts.end(), folderSorts->aSort);
+		if (!sprows || sprows->cRows == 0)
+		{
+			break;
+		}
 
-	OpenStore();
-	LoadSpecialFolders();
+		for (ULONG i = 0; i != sprows->cRows; i++)
+		{
+			auto& row = sprows->aRow[i];
 
-	const TableDirectives directives { shared_from_this(), m_rootFolderDirectives };
-	CComPtr<IMAPITable> sptable;
+			CFRt(static_cast<size_t>(row.cValues) == 1 + columnCount);
+
+			const auto& depthProp = row.lpProps[columnCount];
+			const size_t depth = (depthProp.ulPropTag == PR_DEPTH && depthProp.Value.l > 0)
+				? static_cast<size_t>(depthProp.Value.l)
+				: 1;
+
+			CFRt(depth <= 1 + ancestors.size());
+			ancestors.resize(depth - 1);
+
+			// Trim PR_DEPTH from the folder columns, it stays in the same allocation.
+			mapi_ptr<SPropValue> folderProps { row.lpProps };
+
+			row.lpProps = nullptr;
+
+			const size_t index = hierarchy->size();
+			auto folder =
+				std::make_shared<Folder>(spThis, nullptr, columnCount, std::move(folderProps));
 
-	CORt(m_ipmSubtree->GetHierarchyTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
+			hierarchyIds->insert(folder->id(), index);
+			(ancestors.empty() ? roots : hierarchy->at(ancestors.back()).children).push_back(index);
+			hierarchy->push_back(HierarchyNode { std::move(folder),
+				ancestors.empty() ? std::nullopt : std::make_optional(ancestors.back()) });
+			ancestors.push_back(index);
+		}
+	}
 
-	const rowset_ptr sprows =
-		directives.read(sptable, std::move(folderProps), std::move(folderSorts));
+	m_hierarchy = std::move(hierarchy);
+	m_hierarchyIds = std::move(hierarchyIds);
+	m_hierarchyRoots = std::move(roots);
+}
 
-	m_rootFolders->reserve(static_cast<size_t>(sprows->cRows));
-	for (ULONG i = 0; i != sprows->cRows; i++)
+void Store::ApplyHierarchyNotifications(size_t count, LPNOTIFICATION pNotifications)
+{
+	if (!m_hierarchy || 0 == count || nullptr == pNotifications)
 	{
-		auto& row = sprows->aRow[i];
-		const size_t columnCount = static_cast<size_t>(row.cValues);
-		mapi_ptr<SPropValue> columns { row.lpProps };
+		return;
+	}
+
+	const size_t columnCount = static_cast<size_t>(Folder::GetFolderSchema().columns().cValues);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& notif = pNotifications[i];
+		const auto& tab = notif.info.tab;
+
+		if (notif.ulEventType != fnevTableModified)
+		{
+			continue;
+		}
 
-		row.lpProps = nullptr;
+		switch (tab.ulTableEvent)
+		{
+			case TABLE_SETCOL_DONE:
+			case TABLE_SORT_DONE:
+			case TABLE_RESTRICT_DONE:
+				// These follow our own calls on the table.
+				continue;
 
-		auto folder =
-			std::make_shared<Folder>(shared_from_this(), nullptr, columnCount, std::move(columns));
+			case TABLE_ROW_MODIFIED:
+				if (static_cast<size_t>(tab.row.cValues) == 1 + columnCount)
+				{
+					// Renaming a folder or changing its counts doesn't move it in the hierarchy,
+					// so the folder can be replaced in place.
+					const size_t rowColumns = static_cast<size_t>(tab.row.cValues);
+					mapi_ptr<SPropValue> props;
+
+					CORt(ScDupPropset(tab.row.cValues,
+						tab.row.lpProps,
+						::MAPIAllocateBuffer,
+						&out_ptr { props }));
+					CFRt(props != nullptr);
+
+					auto folder = std::make_shared<Folder>(shared_from_this(),
+						nullptr,
+						rowColumns - 1,
+						std::move(props));
+					const auto index = m_hierarchyIds->find(folder->id());
+
+					// A new name might change the order of the parent's children.
+					if (index && m_hierarchy->at(*index).folder->parentId() == folder->parentId()
+						&& m_hierarchy->at(*index).folder->name() == folder->name())
+					{
+						m_hierarchy->at(*index).folder = std::move(folder);
+						continue;
+					}
+				}
+
+				break;
+
+			default:
+				break;
+		}
 
-		CacheFolder(folder);
-		m_rootFolderIds->insert(std::make_pair(folder->id(), m_rootFolders->size()));
-		m_rootFolders->push_back(std::move(folder));
+		// Anything else might have added, removed, or moved folders, so read it again next time.
+		m_hierarchy.reset();
+		m_hierarchyIds.reset();
+		return;
 	}
+}
 
-	if (!m_rootFolderSink)
+TableHandle& Store::rootFolderTable()
+{
+	if (!m_rootFolderTable)
 	{
+		CComPtr<IMAPITable> sptable;
+
+		OpenStore();
+		LoadSpecialFolders();
+
+		CORt(m_ipmSubtree->GetHierarchyTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
+
 		auto spThis = shared_from_this();
 		CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
 		ULONG_PTR connectionId = 0;
 
 		sinkProxy.Attach(new AdviseSinkProxy<IMAPITable>(
-			[wpStore = std::weak_ptr { spThis }](size_t, LPNOTIFICATION) {
+			[wpStore = std::weak_ptr { spThis }](size_t count, LPNOTIFICATION pNotifications) {
 				auto spStore = wpStore.lock();
 
 				if (spStore)
 				{
-					spStore->m_rootFolders.reset();
+					spStore->QueueNotifications(count,
+						pNotifications,
+						[](Store& store, size_t, LPNOTIFICATION) {
+							store.m_rootFolders.reset();
+
+							if (store.m_rootFolderTable)
+							{
+								// Any pages which were read ahead are also stale now.
+								store.m_rootFolderTable->discardPages();
+							}
+						});
 				}
 			}));
 
@@ -1035,35 +1758,90 @@ void Store::LoadRootFolders(service::Directives&& fieldDirectives)
 		sinkProxy->OnAdvise(sptable, connectionId);
 
 		m_rootFolderSink = sinkProxy;
+		m_rootFolderTable = std::make_unique<TableHandle>(sptable);
 	}
+
+	return *m_rootFolderTable;
 }
 
-mapi_ptr<SPropTagArray> Store::GetFolderProperties() const
+void Store::LoadRootFolders(service::Directives&& fieldDirectives)
 {
-	constexpr auto c_folderProps = Folder::GetFolderColumns();
-	mapi_ptr<SPropTagArray> folderProps;
+	if (m_rootFolderDirectives != fieldDirectives)
+	{
+		// Reset the subFolders and reload if the directives change
+		m_rootFolders.reset();
+		m_rootFolderDirectives = std::move(fieldDirectives);
+	}
+
+	if (m_rootFolders)
+	{
+		return;
+	}
 
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_folderProps.size()),
-		reinterpret_cast<void**>(&out_ptr { folderProps })));
-	CFRt(folderProps != nullptr);
-	folderProps->cValues = static_cast<ULONG>(c_folderProps.size());
-	std::copy(c_folderProps.begin(), c_folderProps.end(), folderProps->aulPropTag);
+	m_rootFolderIds = std::make_unique<EntryIdIndex<size_t>>();
+	m_rootFolders = std::make_unique<std::vector<std::shared_ptr<Folder>>>();
+
+	OpenStore();
+	LoadSpecialFolders();
+
+	const auto& schema = Folder::GetFolderSchema();
+	const TableDirectives directives { shared_from_this(), m_rootFolderDirectives };
+	TagBuffer selected;
+
+	directives.enumerate(rootFolderTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-	return folderProps;
+			row.lpProps = nullptr;
+
+			auto folder = std::make_shared<Folder>(shared_from_this(),
+				nullptr,
+				columnCount,
+				std::move(columns));
+
+			if (!directives.projected())
+			{
+				// Only cache complete folders, projected rows are missing some columns.
+				CacheFolder(folder);
+			}
+
+			m_rootFolderIds->insert(folder->id(), m_rootFolders->size());
+			m_rootFolders->push_back(std::move(folder));
+		});
 }
 
-mapi_ptr<SPropTagArray> Store::GetItemProperties() const
+bool Store::LoadRootFoldersPage(const TableDirectives& directives,
+	std::optional<response::IdType>&& after, std::vector<std::shared_ptr<FolderEdge>>& edges)
 {
-	constexpr auto c_itemProps = Item::GetItemColumns();
-	mapi_ptr<SPropTagArray> itemProps;
+	const auto& schema = Folder::GetFolderSchema();
+	TagBuffer selected;
 
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_itemProps.size()),
-		reinterpret_cast<void**>(&out_ptr { itemProps })));
-	CFRt(itemProps != nullptr);
-	itemProps->cValues = static_cast<ULONG>(c_itemProps.size());
-	std::copy(c_itemProps.begin(), c_itemProps.end(), itemProps->aulPropTag);
+	return directives.paginate(rootFolderTable(),
+		directives.select(schema, selected),
+		&schema.sorts(),
+		std::move(after),
+		[&](SRow& row, response::IdType&& cursor) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-	return itemProps;
+			row.lpProps = nullptr;
+
+			auto folder = std::make_shared<Folder>(shared_from_this(),
+				nullptr,
+				columnCount,
+				std::move(columns));
+
+			if (!directives.projected())
+			{
+				// Only cache complete folders, projected rows are missing some columns.
+				CacheFolder(folder);
+			}
+
+			edges.push_back(std::make_shared<FolderEdge>(folder, std::move(cursor)));
+		});
 }
 
 const response::IdType& Store::getId() const
@@ -1076,12 +1854,12 @@ const std::string& Store::getName() const
 	return m_name;
 }
 
-std::vector<std::shared_ptr<object::Property>> Store::getColumns()
+std::vector<std::shared_ptr<object::Property>> Store::getColumns(service::FieldParams&& params)
 {
 	const auto offset = static_cast<size_t>(DefaultColumn::Count);
 
 	CFRt(m_columnCount >= offset);
-	return { GetColumns(m_columnCount - offset, m_columns.get() + offset) };
+	return { GetColumns(m_columnCount - offset, m_columns.get() + offset, GetRequestArena(params)) };
 }
 
 std::vector<std::shared_ptr<object::Folder>> Store::getRootFolders(
@@ -1089,6 +1867,31 @@ std::vector<std::shared_ptr<object::Folder>> Store::getRootFolders(
 {
 	std::vector<std::shared_ptr<object::Folder>> result {};
 
+	if (idsArg && params.fieldDirectives.empty() && m_hierarchy)
+	{
+		// Without any directives, the root folders with the specified IDs can come from the
+		// hierarchy snapshot if it's already loaded, but reading the whole hierarchy just for this
+		// would be slower than the root folder table. Fall back to the table for any IDs which
+		// aren't in the snapshot.
+		result.resize(idsArg->size());
+		std::transform(idsArg->cbegin(),
+			idsArg->cend(),
+			result.begin(),
+			[this](const response::IdType& id) {
+				auto folder = lookupHierarchyChild(nullptr, id);
+
+				if (!folder)
+				{
+					LoadRootFolders({});
+					folder = lookupRootFolder(id);
+				}
+
+				return folder ? folder->object() : nullptr;
+			});
+
+		return result;
+	}
+
 	LoadRootFolders(std::move(params.fieldDirectives));
 
 	if (idsArg)
@@ -1099,24 +1902,38 @@ std::vector<std::shared_ptr<object::Folder>> Store::getRootFolders(
 			idsArg->cend(),
 			result.begin(),
 			[this](const response::IdType& id) noexcept {
-				return std::make_shared<object::Folder>(lookupRootFolder(id));
+				auto folder = lookupRootFolder(id);
+
+				return folder ? folder->object() : nullptr;
 			});
 	}
 	else
 	{
-		// Just clone the entire vector of stores.
-		result.resize(m_rootFolders->size());
-		std::transform(m_rootFolders->cbegin(),
-			m_rootFolders->cend(),
-			result.begin(),
-			[this](const std::shared_ptr<Folder>& folder) noexcept {
-				return std::make_shared<object::Folder>(folder);
-			});
+		// Reuse the wrappers we returned for the same folders last time.
+		result = WrapRows(*m_rootFolders, m_rootFolderObjects);
 	}
 
 	return result;
 }
 
+std::shared_ptr<object::FolderConnection> Store::getRootFoldersConnection(
+	service::FieldParams&& params, std::optional<response::IdType>&& afterArg)
+{
+	// Pages are not cached on the store, but they share the store's open table. The rows are only
+	// read if the edges or pageInfo are selected.
+	auto spThis = shared_from_this();
+	auto directives = std::make_shared<const TableDirectives>(spThis, params.fieldDirectives);
+
+	return std::make_shared<object::FolderConnection>(std::make_shared<FolderConnection>(
+		[spThis, directives]() {
+			return static_cast<int>(directives->count(spThis->rootFolderTable()));
+		},
+		[spThis, directives, after = std::move(afterArg)](
+			std::vector<std::shared_ptr<FolderEdge>>& edges) mutable {
+			return spThis->LoadRootFoldersPage(*directives, std::move(after), edges);
+		}));
+}
+
 std::vector<std::shared_ptr<object::Folder>> Store::getSpecialFolders(
 	std::vector<SpecialFolder>&& idsArg)
 {
@@ -1130,28 +1947,36 @@ std::vector<std::shared_ptr<object::Folder>> Store::getSpecialFolders(
 		idsArg.cend(),
 		result.begin(),
 		[this](SpecialFolder id) noexcept {
-			return std::make_shared<object::Folder>(lookupSpecialFolder(id));
+			auto folder = lookupSpecialFolder(id);
+
+			return folder ? folder->object() : nullptr;
 		});
 
 	return result;
 }
 
 std::vector<std::shared_ptr<object::Property>> Store::getFolderProperties(
-	response::IdType&& folderIdArg, std::optional<std::vector<Column>>&& idsArg)
+	service::FieldParams&& params, response::IdType&& folderIdArg,
+	std::optional<std::vector<Column>>&& idsArg)
 {
 	auto folder = OpenFolder(convert::input::from_input(std::move(folderIdArg)));
 
 	CFRt(folder != nullptr);
-	return { GetProperties(static_cast<IMAPIFolder*>(folder->folder()), std::move(idsArg)) };
+	return { GetProperties(static_cast<IMAPIFolder*>(folder->folder()),
+		std::move(idsArg),
+		GetRequestArena(params)) };
 }
 
 std::vector<std::shared_ptr<object::Property>> Store::getItemProperties(
-	response::IdType&& itemIdArg, std::optional<std::vector<Column>>&& idsArg)
+	service::FieldParams&& params, response::IdType&& itemIdArg,
+	std::optional<std::vector<Column>>&& idsArg)
 {
 	auto item = OpenItem(convert::input::from_input(std::move(itemIdArg)));
 
 	CFRt(item != nullptr);
-	return { GetProperties(static_cast<IMessage*>(item->message()), std::move(idsArg)) };
+	return { GetProperties(static_cast<IMessage*>(item->message()),
+		std::move(idsArg),
+		GetRequestArena(params)) };
 }
 
 void Store::FillInStoreProps(LPSPropValue storeIds, std::map<SpecialFolder, SBinary>& idMap)
@@ -3,6 +3,7 @@
 
 #include "Guid.h"
 #include "Input.h"
+#include "TableNotifications.h"
 #include "Types.h"
 
 #include "FolderAddedObject.h"
@@ -217,14 +218,32 @@ struct SubscriptionTraits<Folder>
 	using ReloadedObject = object::FoldersReloaded;
 };
 
+template <class T>
+InstanceKeyColumn GetInstanceKeys(const std::vector<std::shared_ptr<T>>& rows)
+{
+	InstanceKeyColumn result;
+
+	result.reserve(rows.size());
+
+	for (const auto& row : rows)
+	{
+		result.push_back(row->instanceKey());
+	}
+
+	return result;
+}
+
 template <class T, class ArgumentType, class PayloadType>
 void Subscription::RegisterAdviseSinkProxy(service::await_async launch, std::string&& fieldName,
 	std::string_view argumentName, const ArgumentType& argumentValue,
 	Registration<T>& registration) const
 {
 	registration.sink = std::make_shared<TableSink<T>>();
-	registration.sink->rows =
-		LoadRows<T>(registration.key, registration.sink->store, registration.sink->table);
+	registration.sink->rows = LoadRows<T>(registration.key,
+		registration.sink->store,
+		registration.sink->table,
+		registration.sink->window);
+	registration.sink->keys = GetInstanceKeys(registration.sink->rows);
 
 	auto spThis = shared_from_this();
 	CComPtr<AdviseSinkProxy<IMAPITable>> sinkProxy;
@@ -262,150 +281,62 @@ void Subscription::RegisterAdviseSinkProxy(service::await_async launch, std::str
 
 		std::vector<std::shared_ptr<typename SubscriptionTraits<T>::Change>> items;
 
-		items.reserve(count);
-		for (size_t i = 0; i < count; ++i)
-		{
-			const auto& notif = pNotifications[i];
-			bool reload = false;
-
-			switch (notif.info.tab.ulTableEvent)
-			{
-				case TABLE_CHANGED:
-				case TABLE_ERROR:
-				case TABLE_RELOAD:
-					reload = true;
-					break;
+		const auto makeRow = [&spSink](const SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns;
 
-				case TABLE_ROW_ADDED:
-					if (notif.info.tab.propPrior.ulPropTag == PR_INSTANCE_KEY)
-					{
-						// Find the insertion point if it's in our cache window.
-						const auto beginKey = reinterpret_cast<const std::uint8_t*>(
-							notif.info.tab.propPrior.Value.bin.lpb);
-						const auto endKey =
-							beginKey + static_cast<size_t>(notif.info.tab.propPrior.Value.bin.cb);
-						const response::IdType priorKey { beginKey, endKey };
-						const auto itrPrior = std::find_if(spSink->rows.cbegin(),
-							spSink->rows.cend(),
-							[&priorKey](const std::shared_ptr<T>& item) noexcept {
-								return item->instanceKey() == priorKey;
-							});
-
-						if (itrPrior == spSink->rows.cend())
-						{
-							break;
-						}
-
-						const auto& row = notif.info.tab.row;
-						const size_t columnCount = static_cast<size_t>(row.cValues);
-						mapi_ptr<SPropValue> columns;
-
-						CORt(ScDupPropset(row.cValues,
-							row.lpProps,
-							::MAPIAllocateBuffer,
-							&out_ptr { columns }));
-						CFRt(columns != nullptr);
-
-						const auto itr = itrPrior + 1;
-						const auto index =
-							static_cast<int>(std::distance(spSink->rows.cbegin(), itr));
-						auto item = std::make_shared<T>(spSink->store,
-							nullptr,
-							columnCount,
-							std::move(columns));
-
-						spSink->rows.insert(itr, item);
-						items.push_back(std::make_shared<typename SubscriptionTraits<T>::Change>(
-							std::make_shared<typename SubscriptionTraits<T>::AddedObject>(
-								std::make_shared<typename SubscriptionTraits<T>::Added>(index,
-									std::move(item)))));
-					}
+			CORt(ScDupPropset(row.cValues,
+				row.lpProps,
+				::MAPIAllocateBuffer,
+				&out_ptr { columns }));
+			CFRt(columns != nullptr);
 
-					break;
+			return std::make_shared<T>(spSink->store, nullptr, columnCount, std::move(columns));
+		};
+		const auto addChange = [&items](RowChange change,
+								   size_t row,
+								   const std::shared_ptr<T>& value) {
+			using Traits = SubscriptionTraits<T>;
 
-				case TABLE_ROW_MODIFIED:
-					if (notif.info.tab.propIndex.ulPropTag == PR_INSTANCE_KEY)
-					{
-						// Find the insertion point if it's in our cache window.
-						const auto beginKey = reinterpret_cast<const std::uint8_t*>(
-							notif.info.tab.propIndex.Value.bin.lpb);
-						const auto endKey =
-							beginKey + static_cast<size_t>(notif.info.tab.propIndex.Value.bin.cb);
-						const response::IdType indexKey { beginKey, endKey };
-						const auto itr = std::find_if(spSink->rows.begin(),
-							spSink->rows.end(),
-							[&indexKey](const std::shared_ptr<T>& item) noexcept {
-								return item->instanceKey() == indexKey;
-							});
-
-						if (itr == spSink->rows.cend())
-						{
-							break;
-						}
-
-						const auto& row = notif.info.tab.row;
-						const size_t columnCount = static_cast<size_t>(row.cValues);
-						mapi_ptr<SPropValue> columns;
-
-						CORt(ScDupPropset(row.cValues,
-							row.lpProps,
-							::MAPIAllocateBuffer,
-							&out_ptr { columns }));
-						CFRt(columns != nullptr);
-
-						const auto index =
-							static_cast<int>(std::distance(spSink->rows.begin(), itr));
-						auto item = std::make_shared<T>(spSink->store,
-							nullptr,
-							columnCount,
-							std::move(columns));
-
-						*itr = item;
-						items.push_back(std::make_shared<typename SubscriptionTraits<T>::Change>(
-							std::make_shared<typename SubscriptionTraits<T>::UpdatedObject>(
-								std::make_shared<typename SubscriptionTraits<T>::Updated>(index,
-									std::move(item)))));
-					}
+			const auto index = static_cast<int>(row);
 
+			switch (change)
+			{
+				case RowChange::Added:
+					items.push_back(std::make_shared<typename Traits::Change>(
+						std::make_shared<typename Traits::AddedObject>(
+							std::make_shared<typename Traits::Added>(index, value))));
 					break;
 
-				case TABLE_ROW_DELETED:
-					if (notif.info.tab.propIndex.ulPropTag == PR_INSTANCE_KEY)
-					{
-						// Find the insertion point if it's in our cache window.
-						const auto beginKey = reinterpret_cast<const std::uint8_t*>(
-							notif.info.tab.propIndex.Value.bin.lpb);
-						const auto endKey =
-							beginKey + static_cast<size_t>(notif.info.tab.propIndex.Value.bin.cb);
-						const response::IdType indexKey { beginKey, endKey };
-						const auto itr = std::find_if(spSink->rows.cbegin(),
-							spSink->rows.cend(),
-							[&indexKey](const std::shared_ptr<T>& item) noexcept {
-								return item->instanceKey() == indexKey;
-							});
-
-						if (itr == spSink->rows.cend())
-						{
-							break;
-						}
-
-						const auto index =
-							static_cast<int>(std::distance(spSink->rows.cbegin(), itr));
-
-						spSink->rows.erase(itr);
-						items.push_back(std::make_shared<typename SubscriptionTraits<T>::Change>(
-							std::make_shared<typename SubscriptionTraits<T>::RemovedObject>(
-								std::make_shared<typename SubscriptionTraits<T>::Removed>(index,
-									indexKey))));
-					}
+				case RowChange::Updated:
+					items.push_back(std::make_shared<typename Traits::Change>(
+						std::make_shared<typename Traits::UpdatedObject>(
+							std::make_shared<typename Traits::Updated>(index, value))));
+					break;
 
+				case RowChange::Removed:
+					items.push_back(std::make_shared<typename Traits::Change>(
+						std::make_shared<typename Traits::RemovedObject>(
+							std::make_shared<typename Traits::Removed>(index,
+								value->instanceKey()))));
 					break;
 			}
+		};
 
-			if (reload)
+		items.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (!ApplyTableNotification(pNotifications[i],
+					spSink->window,
+					spSink->rows,
+					spSink->keys,
+					makeRow,
+					addChange))
 			{
 				items.clear();
-				spSink->rows = spThis->LoadRows<T>(key, spSink->store, spSink->table);
+				spSink->rows =
+					spThis->LoadRows<T>(key, spSink->store, spSink->table, spSink->window);
+				spSink->keys = GetInstanceKeys(spSink->rows);
 				items.push_back(std::make_shared<typename SubscriptionTraits<T>::Change>(
 					std::make_shared<typename SubscriptionTraits<T>::ReloadedObject>(
 						std::make_shared<typename SubscriptionTraits<T>::Reloaded>(spSink->rows))));
@@ -454,8 +385,8 @@ void Subscription::RegisterAdviseSinkProxy(service::await_async launch, std::str
 }
 
 template <>
-std::vector<std::shared_ptr<Item>> Subscription::LoadRows<Item>(
-	const RegistrationKey& key, std::shared_ptr<Store>& store, CComPtr<IMAPITable>& sptable) const
+std::vector<std::shared_ptr<Item>> Subscription::LoadRows<Item>(const RegistrationKey& key,
+	std::shared_ptr<Store>& store, CComPtr<IMAPITable>& sptable, TableWindow& window) const
 {
 	if (!store)
 	{
@@ -471,50 +402,34 @@ std::vector<std::shared_ptr<Item>> Subscription::LoadRows<Item>(
 		CORt(folder->folder()->GetContentsTable(MAPI_DEFERRED_ERRORS | MAPI_UNICODE, &sptable));
 	}
 
-	constexpr auto c_itemProps = Item::GetItemColumns();
-	mapi_ptr<SPropTagArray> itemProps;
-
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_itemProps.size()),
-		reinterpret_cast<void**>(&out_ptr { itemProps })));
-	CFRt(itemProps != nullptr);
-	itemProps->cValues = static_cast<ULONG>(c_itemProps.size());
-	std::copy(c_itemProps.begin(), c_itemProps.end(), itemProps->aulPropTag);
-
-	constexpr auto c_itemSorts = Item::GetItemSorts();
-	mapi_ptr<SSortOrderSet> itemSorts;
-
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_itemSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { itemSorts })));
-	CFRt(itemSorts != nullptr);
-	itemSorts->cSorts = static_cast<ULONG>(c_itemSorts.size());
-	itemSorts->cCategories = 0;
-	itemSorts->cExpanded = 0;
-	std::copy(c_itemSorts.begin(), c_itemSorts.end(), itemSorts->aSort);
-
+	const auto& schema = Item::GetItemSchema();
 	const TableDirectives directives { store, key.directives };
-	const rowset_ptr sprows = directives.read(sptable, std::move(itemProps), std::move(itemSorts));
+	TagBuffer selected;
 	std::vector<std::shared_ptr<Item>> items;
+	TableHandle table { sptable };
 
-	items.reserve(static_cast<size_t>(sprows->cRows));
-	for (ULONG i = 0; i != sprows->cRows; i++)
-	{
-		auto& row = sprows->aRow[i];
-		const size_t columnCount = static_cast<size_t>(row.cValues);
-		mapi_ptr<SPropValue> columns { row.lpProps };
+	directives.enumerate(table,
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-		row.lpProps = nullptr;
+			row.lpProps = nullptr;
 
-		auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
+			auto item = std::make_shared<Item>(store, nullptr, columnCount, std::move(columns));
 
-		items.push_back(std::move(item));
-	}
+			items.push_back(std::move(item));
+		});
+
+	window = directives.window(table, items.size());
 
 	return items;
 }
 
 template <>
-std::vector<std::shared_ptr<Folder>> Subscription::LoadRows<Folder>(
-	const RegistrationKey& key, std::shared_ptr<Store>& store, CComPtr<IMAPITable>& sptable) const
+std::vector<std::shared_ptr<Folder>> Subscription::LoadRows<Folder>(const RegistrationKey& key,
+	std::shared_ptr<Store>& store, CComPtr<IMAPITable>& sptable, TableWindow& window) const
 {
 	if (!store)
 	{
@@ -531,44 +446,27 @@ std::vector<std::shared_ptr<Folder>> Subscription::LoadRows<Folder>(
 			&sptable));
 	}
 
-	constexpr auto c_folderProps = Folder::GetFolderColumns();
-	mapi_ptr<SPropTagArray> folderProps;
-
-	CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(c_folderProps.size()),
-		reinterpret_cast<void**>(&out_ptr { folderProps })));
-	CFRt(folderProps != nullptr);
-	folderProps->cValues = static_cast<ULONG>(c_folderProps.size());
-	std::copy(c_folderProps.begin(), c_folderProps.end(), folderProps->aulPropTag);
-
-	constexpr auto c_folderSorts = Folder::GetFolderSorts();
-	mapi_ptr<SSortOrderSet> folderSorts;
-
-	CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(c_folderSorts.size()),
-		reinterpret_cast<void**>(&out_ptr { folderSorts })));
-	CFRt(folderSorts != nullptr);
-	folderSorts->cSorts = static_cast<ULONG>(c_folderSorts.size());
-	folderSorts->cCategories = 0;
-	folderSorts->cExpanded = 0;
-	std::copy(c_folderSorts.begin(), c_folderSorts.end(), folderSorts->aSort);
-
+	const auto& schema = Folder::GetFolderSchema();
 	const TableDirectives directives { store, key.directives };
-	const rowset_ptr sprows =
-		directives.read(sptable, std::move(folderProps), std::move(folderSorts));
+	TagBuffer selected;
 	std::vector<std::shared_ptr<Folder>> folders;
+	TableHandle table { sptable };
 
-	folders.reserve(static_cast<size_t>(sprows->cRows));
-	for (ULONG i = 0; i != sprows->cRows; i++)
-	{
-		auto& row = sprows->aRow[i];
-		const size_t columnCount = static_cast<size_t>(row.cValues);
-		mapi_ptr<SPropValue> columns { row.lpProps };
+	directives.enumerate(table,
+		directives.select(schema, selected),
+		&schema.sorts(),
+		[&](SRow& row) {
+			const size_t columnCount = static_cast<size_t>(row.cValues);
+			mapi_ptr<SPropValue> columns { row.lpProps };
 
-		row.lpProps = nullptr;
+			row.lpProps = nullptr;
 
-		auto folder = std::make_shared<Folder>(store, nullptr, columnCount, std::move(columns));
+			auto folder = std::make_shared<Folder>(store, nullptr, columnCount, std::move(columns));
 
-		folders.push_back(std::move(folder));
-	}
+			folders.push_back(std::move(folder));
+		});
+
+	window = directives.window(table, folders.size());
 
 	return folders;
 }
@@ -680,6 +578,170 @@ bool operator<(const Order& lhs, const Order& rhs)
 	return lhs.property < rhs.property;
 }
 
+int CompareStringValues(
+	const std::optional<response::Value>& lhs, const std::optional<response::Value>& rhs)
+{
+	if (lhs || rhs)
+	{
+		if (!lhs)
+		{
+			return -1;
+		}
+		else if (!rhs)
+		{
+			return 1;
+		}
+
+		CFRt(lhs->type() == response::Type::String);
+		CFRt(rhs->type() == response::Type::String);
+
+		return lhs->get<std::string>().compare(rhs->get<std::string>());
+	}
+
+	return 0;
+}
+
+bool operator<(const PropValueInput& lhs, const PropValueInput& rhs)
+{
+	if (lhs.integer != rhs.integer)
+	{
+		return lhs.integer < rhs.integer;
+	}
+	else if (lhs.boolean != rhs.boolean)
+	{
+		return lhs.boolean < rhs.boolean;
+	}
+	else if (lhs.string != rhs.string)
+	{
+		return lhs.string < rhs.string;
+	}
+	else if (lhs.bin != rhs.bin)
+	{
+		return lhs.bin < rhs.bin;
+	}
+
+	const int compareGuid = CompareStringValues(lhs.guid, rhs.guid);
+
+	if (compareGuid != 0)
+	{
+		return compareGuid < 0;
+	}
+
+	const int compareTime = CompareStringValues(lhs.time, rhs.time);
+
+	if (compareTime != 0)
+	{
+		return compareTime < 0;
+	}
+
+	return CompareStringValues(lhs.stream, rhs.stream) < 0;
+}
+
+bool operator<(const PropertyComparison& lhs, const PropertyComparison& rhs)
+{
+	if (lhs.relop != rhs.relop)
+	{
+		return lhs.relop < rhs.relop;
+	}
+	else if (lhs.property < rhs.property)
+	{
+		return true;
+	}
+	else if (rhs.property < lhs.property)
+	{
+		return false;
+	}
+
+	return lhs.value < rhs.value;
+}
+
+bool operator<(const ContentFilter& lhs, const ContentFilter& rhs)
+{
+	if (lhs.prefix != rhs.prefix)
+	{
+		return rhs.prefix;
+	}
+	else if (lhs.ignoreCase != rhs.ignoreCase)
+	{
+		return rhs.ignoreCase;
+	}
+	else if (lhs.value != rhs.value)
+	{
+		return lhs.value < rhs.value;
+	}
+
+	return lhs.property < rhs.property;
+}
+
+template <typename T>
+int ComparePointers(const std::unique_ptr<T>& lhs, const std::unique_ptr<T>& rhs)
+{
+	if (lhs || rhs)
+	{
+		if (!lhs)
+		{
+			return -1;
+		}
+		else if (!rhs)
+		{
+			return 1;
+		}
+		else if (*lhs < *rhs)
+		{
+			return -1;
+		}
+		else if (*rhs < *lhs)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+bool operator<(const Restriction& lhs, const Restriction& rhs)
+{
+	if (lhs.all < rhs.all)
+	{
+		return true;
+	}
+	else if (rhs.all < lhs.all)
+	{
+		return false;
+	}
+	else if (lhs.any < rhs.any)
+	{
+		return true;
+	}
+	else if (rhs.any < lhs.any)
+	{
+		return false;
+	}
+
+	const int compareNegate = ComparePointers(lhs.negate, rhs.negate);
+
+	if (compareNegate != 0)
+	{
+		return compareNegate < 0;
+	}
+
+	const int compareCompare = ComparePointers(lhs.compare, rhs.compare);
+
+	if (compareCompare != 0)
+	{
+		return compareCompare < 0;
+	}
+
+	const int compareContains = ComparePointers(lhs.contains, rhs.contains);
+
+	if (compareContains != 0)
+	{
+		return compareContains < 0;
+	}
+
+	return ComparePointers(lhs.exists, rhs.exists) < 0;
+}
+
 template <typename T, service::TypeModifier... Modifiers>
 int CompareDirectives(std::string_view directiveName, std::string_view argumentName,
 	const service::Directives& lhs, const service::Directives& rhs)
@@ -792,6 +854,33 @@ bool Subscription::RegistrationKey::operator<(const RegistrationKey& rhs) const
 		return compareOrders < 0;
 	}
 
+	const int compareChunked =
+		CompareDirectives<int>("chunked"sv, "size"sv, directives, rhs.directives);
+
+	if (compareChunked != 0)
+	{
+		return compareChunked < 0;
+	}
+
+	const int compareSelect = CompareDirectives<std::string, service::TypeModifier::List>(
+		"select"sv,
+		"fields"sv,
+		directives,
+		rhs.directives);
+
+	if (compareSelect != 0)
+	{
+		return compareSelect < 0;
+	}
+
+	const int compareWhere =
+		CompareDirectives<Restriction>("where"sv, "filter"sv, directives, rhs.directives);
+
+	if (compareWhere != 0)
+	{
+		return compareWhere < 0;
+	}
+
 	return false;
 }
 
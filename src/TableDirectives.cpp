@@ -2,121 +2,1086 @@
 // Licensed under the MIT License.
 
 #include "Guid.h"
+#include "Input.h"
 #include "Types.h"
 
+#include <queue>
+
 using namespace std::literals;
 
-namespace graphql::mapi {
+namespace graphql::mapi {
+
+namespace {
+
+template <typename T, service::TypeModifier... Modifiers>
+using modified_type_t =
+	typename service::ModifiedArgument<T>::template ArgumentTraits<T, Modifiers...>::type;
+
+template <typename T, service::TypeModifier... Modifiers>
+std::optional<modified_type_t<T, Modifiers...>> GetFieldDirectiveArgument(
+	std::string_view directiveName, std::string_view argumentName,
+	const service::Directives& fieldDirectives)
+{
+	const auto itr = std::find_if(fieldDirectives.begin(),
+		fieldDirectives.end(),
+		[directiveName](const auto& entry) noexcept {
+			return entry.first == directiveName;
+		});
+
+	if (itr == fieldDirectives.end())
+	{
+		// Return std::nullopt the directive was not found.
+		return std::nullopt;
+	}
+
+	// The argument is required if the directive is present.
+	return std::make_optional(
+		service::ModifiedArgument<T>::template require<Modifiers...>(argumentName, itr->second));
+}
+
+// Directive arguments which can't be combined with each other are reported with a readable
+// message, rather than the condition which failed in CFRt.
+[[noreturn]] void ThrowDirectiveError(std::string&& message)
+{
+	throw service::schema_exception { std::vector<std::string> { std::move(message) } };
+}
+
+// Parked pages are matched on every directive except @offset, which is part of the PagePosition.
+std::shared_ptr<const service::Directives> GetPageKey(const service::Directives& fieldDirectives)
+{
+	const bool readAhead = std::any_of(fieldDirectives.begin(),
+		fieldDirectives.end(),
+		[](const auto& entry) noexcept {
+			return entry.first == "readAhead"sv;
+		});
+
+	if (!readAhead)
+	{
+		return {};
+	}
+
+	auto result = std::make_shared<service::Directives>();
+
+	for (const auto& [name, arguments] : fieldDirectives)
+	{
+		if (name != "offset"sv)
+		{
+			result->emplace_back(name, response::Value { arguments });
+		}
+	}
+
+	return result;
+}
+
+// The categorized view only depends on @groupBy, @orderBy and @where.
+service::Directives GetViewKey(const service::Directives& fieldDirectives)
+{
+	service::Directives result;
+
+	for (const auto& [name, arguments] : fieldDirectives)
+	{
+		if (name == "groupBy"sv || name == "orderBy"sv || name == "where"sv)
+		{
+			result.emplace_back(name, response::Value { arguments });
+		}
+	}
+
+	return result;
+}
+
+// Lay out the columns followed by the sort columns as an SPropTagArray, optionally with
+// PR_INSTANCE_KEY in between them to build a cursor.
+TagBuffer AppendSortColumns(
+	const SPropTagArray& properties, const SSortOrderSet* sorts, bool instanceKey)
+{
+	const size_t columnCount = static_cast<size_t>(properties.cValues);
+	const size_t sortCount = sorts ? static_cast<size_t>(sorts->cSorts) : 0;
+	const size_t trailingCount = (instanceKey ? 1 : 0) + sortCount;
+	TagBuffer result;
+
+	result.reserve(1 + columnCount + trailingCount);
+	result.push_back(static_cast<ULONG>(columnCount + trailingCount));
+	result.append(properties.aulPropTag, properties.aulPropTag + columnCount);
+
+	if (instanceKey)
+	{
+		result.push_back(PR_INSTANCE_KEY);
+	}
+
+	for (size_t i = 0; i < sortCount; ++i)
+	{
+		result.push_back(sorts->aSort[i].ulPropTag);
+	}
+
+	return result;
+}
+
+// Copy the sort order with PR_INSTANCE_KEY as the last sort key, so rows which tie on every other
+// sort key still have a strict order which resumeAfter can use to start right after a cursor.
+const SSortOrderSet& AppendInstanceKeySort(const SSortOrderSet* sorts, TagBuffer& buffer)
+{
+	const size_t sortCount = sorts ? static_cast<size_t>(sorts->cSorts) : 0;
+
+	buffer.clear();
+	buffer.reserve(3 + 2 * (sortCount + 1));
+	buffer.push_back(static_cast<ULONG>(sortCount + 1));
+	buffer.push_back(0);
+	buffer.push_back(0);
+
+	for (size_t i = 0; i < sortCount; ++i)
+	{
+		buffer.push_back(sorts->aSort[i].ulPropTag);
+		buffer.push_back(sorts->aSort[i].ulOrder);
+	}
+
+	buffer.push_back(PR_INSTANCE_KEY);
+	buffer.push_back(TABLE_SORT_ASCEND);
+
+	return *reinterpret_cast<const SSortOrderSet*>(buffer.data());
+}
+
+template <typename T>
+int CompareValues(const T& lhs, const T& rhs) noexcept
+{
+	return (lhs < rhs) ? -1 : ((rhs < lhs) ? 1 : 0);
+}
+
+// Compare sort column values from different tables, roughly the way that each of the tables would
+// sort them. Missing values come back as PT_ERROR, and they sort before any other value.
+int CompareSortValues(const SPropValue& lhs, const SPropValue& rhs)
+{
+	const auto lhsType = PROP_TYPE(lhs.ulPropTag);
+	const auto rhsType = PROP_TYPE(rhs.ulPropTag);
+
+	if (lhsType != rhsType)
+	{
+		if (lhsType == PT_ERROR || rhsType == PT_ERROR)
+		{
+			return (lhsType == PT_ERROR) ? -1 : 1;
+		}
+
+		return CompareValues(lhsType, rhsType);
+	}
+
+	switch (lhsType)
+	{
+		case PT_I2:
+			return CompareValues(lhs.Value.i, rhs.Value.i);
+
+		case PT_LONG:
+			return CompareValues(lhs.Value.l, rhs.Value.l);
+
+		case PT_BOOLEAN:
+			return CompareValues(lhs.Value.b, rhs.Value.b);
+
+		case PT_I8:
+			return CompareValues(lhs.Value.li.QuadPart, rhs.Value.li.QuadPart);
+
+		case PT_R4:
+			return CompareValues(lhs.Value.flt, rhs.Value.flt);
+
+		case PT_DOUBLE:
+			return CompareValues(lhs.Value.dbl, rhs.Value.dbl);
+
+		case PT_APPTIME:
+			return CompareValues(lhs.Value.at, rhs.Value.at);
+
+		case PT_SYSTIME:
+			return ::CompareFileTime(&lhs.Value.ft, &rhs.Value.ft);
+
+		case PT_UNICODE:
+		{
+			// CompareString returns CSTR_LESS_THAN, CSTR_EQUAL or CSTR_GREATER_THAN.
+			const int result = ::CompareStringW(LOCALE_USER_DEFAULT,
+				NORM_IGNORECASE,
+				lhs.Value.lpszW,
+				-1,
+				rhs.Value.lpszW,
+				-1);
+
+			return result - CSTR_EQUAL;
+		}
+
+		case PT_STRING8:
+		{
+			const int result = ::CompareStringA(LOCALE_USER_DEFAULT,
+				NORM_IGNORECASE,
+				lhs.Value.lpszA,
+				-1,
+				rhs.Value.lpszA,
+				-1);
+
+			return result - CSTR_EQUAL;
+		}
+
+		case PT_BINARY:
+		{
+			const int result = memcmp(lhs.Value.bin.lpb,
+				rhs.Value.bin.lpb,
+				static_cast<size_t>(std::min(lhs.Value.bin.cb, rhs.Value.bin.cb)));
+
+			return (result != 0) ? CompareValues(result, 0)
+								 : CompareValues(lhs.Value.bin.cb, rhs.Value.bin.cb);
+		}
+
+		case PT_CLSID:
+			return CompareValues(memcmp(lhs.Value.lpguid, rhs.Value.lpguid, sizeof(GUID)), 0);
+
+		default:
+			return 0;
+	}
+}
+
+// Collect the property values and the property IDs for RES_EXIST in the same order that
+// BuildRestriction will consume them.
+void CollectRestriction(const Restriction& filter, std::vector<PropertyInput>& values,
+	std::vector<PropIdInput>& existIds)
+{
+	const size_t fieldCount = (filter.all ? 1 : 0) + (filter.any ? 1 : 0)
+		+ (filter.negate ? 1 : 0) + (filter.compare ? 1 : 0) + (filter.contains ? 1 : 0)
+		+ (filter.exists ? 1 : 0);
+
+	// Each Restriction is a variant, exactly one of the fields must be set.
+	CFRt(fieldCount == 1);
+
+	if (filter.all || filter.any)
+	{
+		for (const auto& child : filter.all ? *filter.all : *filter.any)
+		{
+			CollectRestriction(child, values, existIds);
+		}
+	}
+	else if (filter.negate)
+	{
+		CollectRestriction(*filter.negate, values, existIds);
+	}
+	else if (filter.compare)
+	{
+		values.push_back(PropertyInput { filter.compare->property, filter.compare->value });
+	}
+	else if (filter.contains)
+	{
+		values.push_back(PropertyInput { filter.contains->property,
+			PropValueInput { std::nullopt,
+				std::nullopt,
+				std::make_optional(filter.contains->value),
+				std::nullopt,
+				std::nullopt,
+				std::nullopt,
+				std::nullopt } });
+	}
+	else
+	{
+		existIds.push_back(*filter.exists);
+	}
+}
+
+void BuildRestriction(const Restriction& filter, SRestriction& result, void* pAllocMore,
+	LPSPropValue& nextValue,
+	std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>>::const_iterator& nextExist)
+{
+	if (filter.all || filter.any)
+	{
+		const auto& children = filter.all ? *filter.all : *filter.any;
+		LPSRestriction pChildren = nullptr;
+
+		CORt(::MAPIAllocateMore(
+			static_cast<ULONG>(sizeof(*pChildren) * std::max<size_t>(1, children.size())),
+			pAllocMore,
+			reinterpret_cast<void**>(&pChildren)));
+		CFRt(pChildren != nullptr);
+
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			BuildRestriction(children[i], pChildren[i], pAllocMore, nextValue, nextExist);
+		}
+
+		if (filter.all)
+		{
+			result.rt = RES_AND;
+			result.res.resAnd.cRes = static_cast<ULONG>(children.size());
+			result.res.resAnd.lpRes = pChildren;
+		}
+		else
+		{
+			result.rt = RES_OR;
+			result.res.resOr.cRes = static_cast<ULONG>(children.size());
+			result.res.resOr.lpRes = pChildren;
+		}
+	}
+	else if (filter.negate)
+	{
+		LPSRestriction pChild = nullptr;
+
+		CORt(::MAPIAllocateMore(static_cast<ULONG>(sizeof(*pChild)),
+			pAllocMore,
+			reinterpret_cast<void**>(&pChild)));
+		CFRt(pChild != nullptr);
+		BuildRestriction(*filter.negate, *pChild, pAllocMore, nextValue, nextExist);
+
+		result.rt = RES_NOT;
+		result.res.resNot.ulReserved = 0;
+		result.res.resNot.lpRes = pChild;
+	}
+	else if (filter.compare)
+	{
+		constexpr std::array c_relops {
+			RELOP_LT,
+			RELOP_LE,
+			RELOP_GT,
+			RELOP_GE,
+			RELOP_EQ,
+			RELOP_NE,
+		};
+
+		CFRt(static_cast<size_t>(filter.compare->relop) < c_relops.size());
+
+		const auto pval = nextValue++;
+
+		result.rt = RES_PROPERTY;
+		result.res.resProperty.relop = c_relops[static_cast<size_t>(filter.compare->relop)];
+		result.res.resProperty.ulPropTag = pval->ulPropTag;
+		result.res.resProperty.lpProp = pval;
+	}
+	else if (filter.contains)
+	{
+		const auto pval = nextValue++;
+
+		result.rt = RES_CONTENT;
+		result.res.resContent.ulFuzzyLevel = (filter.contains->prefix ? FL_PREFIX : FL_SUBSTRING)
+			| (filter.contains->ignoreCase ? FL_IGNORECASE : 0);
+		result.res.resContent.ulPropTag = pval->ulPropTag;
+		result.res.resContent.lpProp = pval;
+	}
+	else
+	{
+		const auto propTag = (nextExist++)->first;
+
+		result.rt = RES_EXIST;
+		result.res.resExist.ulReserved1 = 0;
+		result.res.resExist.ulPropTag = propTag;
+		result.res.resExist.ulReserved2 = 0;
+	}
+}
+
+} // namespace
+
+TableDirectives::TableDirectives(
+	const std::shared_ptr<Store>& store, const service::Directives& fieldDirectives) noexcept
+	: m_store { store }
+	, m_columns { GetFieldDirectiveArgument<Column, service::TypeModifier::List>(
+		  "columns"sv, "ids"sv, fieldDirectives) }
+	, m_orderBy { GetFieldDirectiveArgument<Order, service::TypeModifier::List>(
+		  "orderBy"sv, "sorts"sv, fieldDirectives) }
+	, m_seek { GetFieldDirectiveArgument<response::IdType, service::TypeModifier::Nullable>(
+		  "seek"sv, "id"sv, fieldDirectives) }
+	, m_offset { GetFieldDirectiveArgument<int>("offset"sv, "count"sv, fieldDirectives) }
+	, m_take { GetFieldDirectiveArgument<int>("take"sv, "count"sv, fieldDirectives) }
+	, m_select { GetFieldDirectiveArgument<std::string, service::TypeModifier::List>(
+		  "select"sv, "fields"sv, fieldDirectives) }
+	, m_chunked { GetFieldDirectiveArgument<int>("chunked"sv, "size"sv, fieldDirectives) }
+	, m_where { GetFieldDirectiveArgument<Restriction>("where"sv, "filter"sv, fieldDirectives) }
+	, m_readAhead { GetFieldDirectiveArgument<int>("readAhead"sv, "pages"sv, fieldDirectives) }
+	, m_readAheadBudget { GetFieldDirectiveArgument<int, service::TypeModifier::Nullable>(
+		  "readAhead"sv, "budget"sv, fieldDirectives) }
+	, m_groupBy { GetFieldDirectiveArgument<Order>("groupBy"sv, "sort"sv, fieldDirectives) }
+	, m_pageKey { GetPageKey(fieldDirectives) }
+	, m_viewKey { m_groupBy ? GetViewKey(fieldDirectives) : service::Directives {} }
+{
+	if (m_store && m_columns && !m_columns->empty() && m_orderBy && !m_orderBy->empty())
+	{
+		// Pre-resolve all of the named properties in the columns and orderBy directives together in
+		// a single call
+		std::vector<PropIdInput> propIds;
+
+		propIds.reserve(m_columns->size() + m_orderBy->size());
+		std::transform(m_columns->cbegin(),
+			m_columns->cend(),
+			std::back_insert_iterator(propIds),
+			[](const auto& column) noexcept {
+				return column.property;
+			});
+		std::transform(m_orderBy->cbegin(),
+			m_orderBy->cend(),
+			std::back_insert_iterator(propIds),
+			[](const auto& order) noexcept {
+				return order.property;
+			});
+
+		auto resolved = m_store->lookupPropIdInputs(propIds);
+	}
+}
+
+rowset_ptr TableDirectives::read(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder) const
+{
+	rowset_ptr result;
+	const LONG count = take();
+	const size_t pages = (count > 0) ? readAhead() : 0;
+
+	if (pages > 0)
+	{
+		// Serve the window from an earlier read if it's still parked on the table.
+		auto page = table.takePage(*m_pageKey, PagePosition { offset() });
+
+		if (page)
+		{
+			CORt(::MAPIAllocateBuffer(CbNewSRowSet(page->rows.size()),
+				reinterpret_cast<void**>(&out_ptr { result })));
+			CFRt(result != nullptr);
+			result->cRows = static_cast<ULONG>(page->rows.size());
+
+			for (size_t i = 0; i < page->rows.size(); ++i)
+			{
+				result->aRow[i].ulAdrEntryPad = 0;
+				result->aRow[i].cValues = page->rows[i].columnCount;
+				result->aRow[i].lpProps = page->rows[i].columns.release();
+			}
+
+			return result;
+		}
+	}
+
+	position(table, defaultColumns, defaultOrder);
+
+	// Read the following windows in the same round trip, and park them on the table.
+	CORt(table.table()->QueryRows(count * static_cast<LONG>(1 + pages), 0, &out_ptr { result }));
+
+	if (pages > 0 && result && result->cRows > static_cast<ULONG>(count))
+	{
+		const ULONG rowCount = result->cRows;
+		LONG nextOffset = offset();
+
+		for (ULONG start = static_cast<ULONG>(count); start < rowCount;
+			 start += static_cast<ULONG>(count))
+		{
+			const ULONG end = std::min(rowCount, start + static_cast<ULONG>(count));
+			std::vector<ParkedRow> rows(static_cast<size_t>(end - start));
+
+			for (ULONG i = start; i != end; i++)
+			{
+				auto& row = result->aRow[i];
+				auto& parked = rows[static_cast<size_t>(i - start)];
+
+				parked.columnCount = row.cValues;
+				parked.columns.reset(row.lpProps);
+				row.lpProps = nullptr;
+			}
+
+			nextOffset += count;
+			parkPage(table, PagePosition { nextOffset }, std::move(rows), end < rowCount);
+		}
+
+		// The parked rows own their props now, so FreeProws should skip them.
+		result->cRows = static_cast<ULONG>(count);
+	}
+
+	return result;
+}
+
+void TableDirectives::enumerate(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder, const RowCallback& callback) const
+{
+	if (!m_chunked)
+	{
+		// Read a single window and hand each of the rows to the callback.
+		const rowset_ptr sprows = read(table, defaultColumns, defaultOrder);
+
+		for (ULONG i = 0; i != sprows->cRows; i++)
+		{
+			callback(sprows->aRow[i]);
+		}
+
+		return;
+	}
+
+	if (m_take && *m_take < 0)
+	{
+		// Chunks are always read forward from the starting point.
+		ThrowDirectiveError("@chunked can't be combined with a negative @take");
+	}
+
+	position(table, defaultColumns, defaultOrder);
+
+	// A positive @take limits the total number of rows without the usual cap, otherwise keep
+	// reading until we reach the end of the table.
+	const auto chunkSize = chunked();
+	size_t remaining = (m_take && *m_take > 0) ? static_cast<size_t>(*m_take) : SIZE_MAX;
+
+	while (remaining > 0)
+	{
+		rowset_ptr sprows;
+
+		CORt(table.table()->QueryRows(static_cast<LONG>(std::min<size_t>(chunkSize, remaining)),
+			0,
+			&out_ptr { sprows }));
+
+		if (!sprows || sprows->cRows == 0)
+		{
+			break;
+		}
+
+		for (ULONG i = 0; i != sprows->cRows; i++)
+		{
+			callback(sprows->aRow[i]);
+		}
+
+		remaining -= std::min<size_t>(remaining, static_cast<size_t>(sprows->cRows));
+	}
+}
+
+bool TableDirectives::paginate(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder, std::optional<response::IdType>&& after,
+	const CursorCallback& callback) const
+{
+	// Connections only page forward from the cursor, so they can't be combined with @seek or a
+	// negative @take. The page is already bounded by @take, so @chunked doesn't apply either.
+	const LONG pageSize = take();
+
+	if (m_seek)
+	{
+		ThrowDirectiveError("@seek can't be used with a connection");
+	}
+
+	if (pageSize <= 0)
+	{
+		ThrowDirectiveError("@take must be positive for a connection");
+	}
+
+	const size_t pages = readAhead();
+
+	if (pages > 0 && after)
+	{
+		// Serve the page from an earlier read if it's still parked on the table.
+		auto page = table.takePage(*m_pageKey,
+			PagePosition { convert::input::from_input(response::IdType { *after }) });
+
+		if (page)
+		{
+			for (auto& parked : page->rows)
+			{
+				SRow row {};
+
+				row.cValues = parked.columnCount;
+				row.lpProps = parked.columns.release();
+				callback(row, std::move(parked.cursor));
+				parked.columns.reset(row.lpProps);
+			}
+
+			return page->hasNextPage;
+		}
+	}
+
+	TagBuffer columnBuffer;
+	TagBuffer sortBuffer;
+	TagBuffer pageSortBuffer;
+	const auto& properties = columns(defaultColumns, columnBuffer);
+	const auto sorts = orderBy(defaultOrder, sortBuffer);
+	const auto restriction = where();
+	const size_t columnCount = static_cast<size_t>(properties.cValues);
+	const size_t sortCount = sorts ? static_cast<size_t>(sorts->cSorts) : 0;
+	const size_t trailingCount = 1 + sortCount;
+	const auto pageColumns = AppendSortColumns(properties, sorts, true);
+
+	table.setColumns(*reinterpret_cast<const SPropTagArray*>(pageColumns.data()));
+	table.sortTable(&AppendInstanceKeySort(sorts, pageSortBuffer));
+
+	std::optional<convert::cursor::Boundary> boundary;
+	mapi_ptr<SRestriction> boundaryRestriction;
+
+	if (after)
+	{
+		try
+		{
+			boundary = convert::cursor::from_cursor(
+				convert::input::from_input(std::move(*after)).get<response::IdType::ByteData>());
+		}
+		catch (const std::invalid_argument&)
+		{
+			boundary.reset();
+		}
+
+		if (boundary)
+		{
+			boundaryRestriction = resumeAfter(*boundary, sorts);
+		}
+
+		if (!boundaryRestriction)
+		{
+			// Without a restriction which starts after the cursor, this would start over at the
+			// beginning of the table and return rows which were already on the previous pages.
+			ThrowDirectiveError("invalid after cursor");
+		}
+	}
+
+	if (restriction && boundaryRestriction)
+	{
+		std::array<SRestriction, 2> both { *restriction, *boundaryRestriction };
+		SRestriction combined {};
+
+		combined.rt = RES_AND;
+		combined.res.resAnd.cRes = static_cast<ULONG>(both.size());
+		combined.res.resAnd.lpRes = both.data();
+		table.restrictTable(&combined);
+	}
+	else
+	{
+		table.restrictTable(restriction ? restriction.get() : boundaryRestriction.get());
+	}
+
+	// The boundary restriction only matches rows after the boundary row, even if it was removed.
+	CORt(table.table()->SeekRow(BOOKMARK_BEGINNING, offset(), nullptr));
+
+	// Read one extra row to find out if there is another page, plus any pages for @readAhead.
+	const ULONG readCount = static_cast<ULONG>(pageSize) * static_cast<ULONG>(1 + pages);
+	rowset_ptr sprows;
+
+	CORt(table.table()->QueryRows(static_cast<LONG>(readCount + 1), 0, &out_ptr { sprows }));
+
+	const ULONG rowCount = sprows ? sprows->cRows : 0;
+	const ULONG pageCount = std::min(rowCount, static_cast<ULONG>(pageSize));
+	const auto getCursor = [columnCount, trailingCount](SRow& row) {
+		CFRt(static_cast<size_t>(row.cValues) == columnCount + trailingCount);
+
+		const auto trailing = row.lpProps + columnCount;
+
+		CFRt(PROP_TYPE(trailing->ulPropTag) == PT_BINARY);
+
+		// Trim the trailing columns, they are only used to build the cursor.
+		row.cValues = static_cast<ULONG>(columnCount);
+
+		return response::IdType { convert::cursor::to_cursor(trailing->Value.bin,
+			trailing + 1,
+			trailing + trailingCount) };
+	};
+	response::IdType previousCursor;
+
+	for (ULONG i = 0; i != pageCount; i++)
+	{
+		auto& row = sprows->aRow[i];
+		auto cursor = getCursor(row);
+
+		if (pages > 0 && i + 1 == pageCount)
+		{
+			previousCursor = response::IdType { cursor };
+		}
+
+		callback(row, std::move(cursor));
+	}
+
+	// Park the pages after this one, each of them continues from the last cursor on the page
+	// before it. The extra row at the end is only used to fill in hasNextPage.
+	for (ULONG start = pageCount; start < std::min(rowCount, readCount);
+		 start += static_cast<ULONG>(pageSize))
+	{
+		const ULONG end = std::min(rowCount, start + static_cast<ULONG>(pageSize));
+		std::vector<ParkedRow> rows(static_cast<size_t>(end - start));
+
+		for (ULONG i = start; i != end; i++)
+		{
+			auto& row = sprows->aRow[i];
+			auto& parked = rows[static_cast<size_t>(i - start)];
+
+			parked.cursor = getCursor(row);
+			parked.columnCount = row.cValues;
+			parked.columns.reset(row.lpProps);
+			row.lpProps = nullptr;
+		}
+
+		auto position = std::move(previousCursor);
+
+		previousCursor = response::IdType { rows.back().cursor };
+		parkPage(table, PagePosition { std::move(position) }, std::move(rows), end < rowCount);
+	}
+
+	return rowCount > pageCount;
+}
+
+rowset_ptr TableDirectives::readHead(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder) const
+{
+	// Every table is read from the beginning, so this can't be combined with @seek or a negative
+	// @take. The window is already bounded by @take, so @chunked doesn't apply either.
+	const LONG count = take();
+
+	if (m_seek)
+	{
+		ThrowDirectiveError("@seek can't be used when merging items from several folders");
+	}
+
+	if (count < 0 || offset() < 0)
+	{
+		ThrowDirectiveError(
+			"@offset and @take must not be negative when merging items from several folders");
+	}
+
+	TagBuffer columnBuffer;
+	TagBuffer sortBuffer;
+	const auto& properties = columns(defaultColumns, columnBuffer);
+	const auto sorts = orderBy(defaultOrder, sortBuffer);
+	const auto restriction = where();
+	const auto headColumns = AppendSortColumns(properties, sorts, false);
+
+	table.setColumns(*reinterpret_cast<const SPropTagArray*>(headColumns.data()));
+	table.sortTable(sorts);
+	table.restrictTable(restriction.get());
+	CORt(table.table()->SeekRow(BOOKMARK_BEGINNING, 0, nullptr));
+
+	// None of the rows after the first @offset + @take in this table can end up in the window.
+	// QueryRows may return fewer rows than requested before the end of the table, so keep reading
+	// until there are enough rows or a read comes back empty.
+	const auto headCount = static_cast<ULONG>(offset() + count);
+	std::vector<rowset_ptr> chunks;
+	ULONG rowCount = 0;
+
+	while (rowCount < headCount)
+	{
+		rowset_ptr chunk;
+
+		CORt(table.table()->QueryRows(static_cast<LONG>(headCount - rowCount),
+			0,
+			&out_ptr { chunk }));
+
+		if (!chunk || chunk->cRows == 0)
+		{
+			break;
+		}
+
+		rowCount += chunk->cRows;
+		chunks.push_back(std::move(chunk));
+	}
+
+	if (chunks.size() <= 1)
+	{
+		return chunks.empty() ? rowset_ptr {} : std::move(chunks.front());
+	}
+
+	// Move the rows from every chunk into a single SRowSet.
+	rowset_ptr result;
+
+	CORt(::MAPIAllocateBuffer(CbNewSRowSet(rowCount),
+		reinterpret_cast<void**>(&out_ptr { result })));
+	CFRt(result != nullptr);
+	result->cRows = 0;
+
+	for (auto& chunk : chunks)
+	{
+		std::copy(chunk->aRow, chunk->aRow + chunk->cRows, result->aRow + result->cRows);
+		result->cRows += chunk->cRows;
+
+		// The merged rows own their props now, so FreeProws should skip them.
+		chunk->cRows = 0;
+	}
+
+	return result;
+}
+
+void TableDirectives::merge(std::vector<rowset_ptr>& sources, const SSortOrderSet* defaultOrder,
+	const MergeCallback& callback) const
+{
+	// The sort directions are the same for every source, even if the named properties in @orderBy
+	// resolved to different property IDs in each store.
+	constexpr size_t c_maxSortCount = 64;
+	std::bitset<c_maxSortCount> descending;
+	size_t sortCount = 0;
+
+	if (m_orderBy && !m_orderBy->empty())
+	{
+		sortCount = m_orderBy->size();
+
+		if (sortCount > c_maxSortCount)
+		{
+			ThrowDirectiveError("@orderBy can't have more than 64 sort keys when merging folders");
+		}
+
+		for (size_t i = 0; i < sortCount; ++i)
+		{
+			descending[i] = (*m_orderBy)[i].descending;
+		}
+	}
+	else if (defaultOrder)
+	{
+		sortCount = static_cast<size_t>(defaultOrder->cSorts);
+		CFRt(sortCount <= c_maxSortCount);
+
+		for (size_t i = 0; i < sortCount; ++i)
+		{
+			descending[i] = (defaultOrder->aSort[i].ulOrder == TABLE_SORT_DESCEND);
+		}
+	}
 
-namespace {
+	// Each entry in the heap is the index of a source and the index of its next row.
+	using MergePosition = std::pair<size_t, ULONG>;
 
-template <typename T, service::TypeModifier... Modifiers>
-using modified_type_t =
-	typename service::ModifiedArgument<T>::template ArgumentTraits<T, Modifiers...>::type;
+	const auto getSortValues = [&sources, sortCount](const MergePosition& position) {
+		const auto& row = sources[position.first]->aRow[position.second];
 
-template <typename T, service::TypeModifier... Modifiers>
-std::optional<modified_type_t<T, Modifiers...>> GetFieldDirectiveArgument(
-	std::string_view directiveName, std::string_view argumentName,
-	const service::Directives& fieldDirectives)
-{
-	const auto itr = std::find_if(fieldDirectives.begin(),
-		fieldDirectives.end(),
-		[directiveName](const auto& entry) noexcept {
-			return entry.first == directiveName;
-		});
+		CFRt(static_cast<size_t>(row.cValues) >= sortCount);
 
-	if (itr == fieldDirectives.end())
+		return row.lpProps + (static_cast<size_t>(row.cValues) - sortCount);
+	};
+
+	// std::priority_queue keeps the greatest element on top, so this returns true if lhs should
+	// come after rhs. Rows which tie keep the order of the sources.
+	const auto comesAfter = [&](const MergePosition& lhs, const MergePosition& rhs) {
+		const auto lhsValues = getSortValues(lhs);
+		const auto rhsValues = getSortValues(rhs);
+
+		for (size_t i = 0; i < sortCount; ++i)
+		{
+			const int result = CompareSortValues(lhsValues[i], rhsValues[i]);
+
+			if (result != 0)
+			{
+				return descending[i] ? result < 0 : result > 0;
+			}
+		}
+
+		return lhs.first > rhs.first;
+	};
+	std::priority_queue<MergePosition, std::vector<MergePosition>, decltype(comesAfter)> heap {
+		comesAfter
+	};
+
+	for (size_t i = 0; i < sources.size(); ++i)
 	{
-		// Return std::nullopt the directive was not found.
-		return std::nullopt;
+		if (sources[i] && sources[i]->cRows > 0)
+		{
+			heap.push({ i, 0 });
+		}
 	}
 
-	// The argument is required if the directive is present.
-	return std::make_optional(
-		service::ModifiedArgument<T>::template require<Modifiers...>(argumentName, itr->second));
+	auto skip = static_cast<size_t>(offset());
+	auto remaining = static_cast<size_t>(take());
+
+	while (!heap.empty() && remaining > 0)
+	{
+		const auto [source, index] = heap.top();
+		auto& row = sources[source]->aRow[index];
+
+		heap.pop();
+
+		if (index + 1 < sources[source]->cRows)
+		{
+			heap.push({ source, index + 1 });
+		}
+
+		if (skip > 0)
+		{
+			--skip;
+			continue;
+		}
+
+		// Trim the sort columns, they are only used to merge the rows.
+		row.cValues -= static_cast<ULONG>(sortCount);
+		callback(source, row);
+		--remaining;
+	}
 }
 
-} // namespace
+void TableDirectives::groups(
+	TableHandle& table, const SSortOrderSet* defaultOrder, const RowCallback& callback) const
+{
+	// The headings are read from the beginning of the categorized table, so this can't be combined
+	// with @seek or a negative @take.
+	const LONG count = take();
 
-TableDirectives::TableDirectives(
-	const std::shared_ptr<Store>& store, const service::Directives& fieldDirectives) noexcept
-	: m_store { store }
-	, m_columns { GetFieldDirectiveArgument<Column, service::TypeModifier::List>(
-		  "columns"sv, "ids"sv, fieldDirectives) }
-	, m_orderBy { GetFieldDirectiveArgument<Order, service::TypeModifier::List>(
-		  "orderBy"sv, "sorts"sv, fieldDirectives) }
-	, m_seek { GetFieldDirectiveArgument<response::IdType, service::TypeModifier::Nullable>(
-		  "seek"sv, "id"sv, fieldDirectives) }
-	, m_offset { GetFieldDirectiveArgument<int>("offset"sv, "count"sv, fieldDirectives) }
-	, m_take { GetFieldDirectiveArgument<int>("take"sv, "count"sv, fieldDirectives) }
+	if (m_seek)
+	{
+		ThrowDirectiveError("@seek can't be used with @groupBy");
+	}
+
+	if (count <= 0 || offset() < 0)
+	{
+		ThrowDirectiveError(
+			"@take must be positive and @offset must not be negative with @groupBy");
+	}
+
+	TagBuffer sortBuffer;
+	const auto sorts = groupBy(defaultOrder, sortBuffer);
+	const auto restriction = where();
+	SizedSPropTagArray(static_cast<size_t>(HeadingColumn::Count), headingColumns) = {
+		static_cast<ULONG>(HeadingColumn::Count),
+		{
+			PR_INSTANCE_KEY,
+			PR_CONTENT_COUNT,
+			PR_CONTENT_UNREAD,
+			sorts->aSort[0].ulPropTag,
+		},
+	};
+
+	table.setColumns(reinterpret_cast<const SPropTagArray&>(headingColumns));
+	table.sortTable(sorts);
+	table.restrictTable(restriction.get());
+	CORt(table.table()->SeekRow(BOOKMARK_BEGINNING, offset(), nullptr));
+
+	// With every category collapsed, the only rows left in the view are the headings.
+	rowset_ptr sprows;
+
+	CORt(table.table()->QueryRows(count, 0, &out_ptr { sprows }));
+
+	for (ULONG i = 0; i != sprows->cRows; i++)
+	{
+		callback(sprows->aRow[i]);
+	}
+}
+
+void TableDirectives::expand(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder, const response::IdType& instanceKey,
+	const TableDirectives& itemDirectives, const RowCallback& callback) const
 {
-	if (m_store && m_columns && !m_columns->empty() && m_orderBy && !m_orderBy->empty())
+	// ExpandRow always starts with the first item in the category, so the item window can't use
+	// @seek or a negative @take either.
+	const LONG count = itemDirectives.take();
+
+	if (itemDirectives.m_seek)
 	{
-		// Pre-resolve all of the named properties in the columns and orderBy directives together in
-		// a single call
-		std::vector<PropIdInput> propIds;
+		ThrowDirectiveError("@seek can't be used with the items in a group");
+	}
 
-		propIds.reserve(m_columns->size() + m_orderBy->size());
-		std::transform(m_columns->cbegin(),
-			m_columns->cend(),
-			std::back_insert_iterator(propIds),
-			[](const auto& column) noexcept {
-				return column.property;
-			});
-		std::transform(m_orderBy->cbegin(),
-			m_orderBy->cend(),
-			std::back_insert_iterator(propIds),
-			[](const auto& order) noexcept {
-				return order.property;
-			});
+	if (count <= 0 || itemDirectives.offset() < 0)
+	{
+		ThrowDirectiveError(
+			"@take must be positive and @offset must not be negative for the items in a group");
+	}
 
-		auto resolved = m_store->lookupPropIdInputs(std::move(propIds));
+	TagBuffer columnBuffer;
+	TagBuffer sortBuffer;
+	const auto& properties = itemDirectives.columns(defaultColumns, columnBuffer);
+	const auto sorts = groupBy(defaultOrder, sortBuffer);
+	const auto restriction = where();
+
+	// Re-apply the same categorized view as groups, the instance keys of the headings are only
+	// valid in that view. The item rows use the item columns instead of the heading columns.
+	table.setColumns(properties);
+	table.sortTable(sorts);
+	table.restrictTable(restriction.get());
+
+	const auto cbInstanceKey = static_cast<ULONG>(instanceKey.size());
+	const auto pbInstanceKey = const_cast<LPBYTE>(instanceKey.data());
+	rowset_ptr sprows;
+	ULONG moreRows = 0;
+	const HRESULT hrExpand = table.table()->ExpandRow(cbInstanceKey,
+		pbInstanceKey,
+		static_cast<ULONG>(itemDirectives.offset() + count),
+		0,
+		&out_ptr { sprows },
+		&moreRows);
+
+	if (SUCCEEDED(hrExpand))
+	{
+		// Collapse the category right away, so the next call to groups still only sees headings
+		// without calling SortTable again.
+		ULONG rowCount = 0;
+
+		CORt(table.table()->CollapseRow(cbInstanceKey, pbInstanceKey, 0, &rowCount));
+	}
+
+	CORt(hrExpand);
+
+	if (!sprows)
+	{
+		return;
+	}
+
+	for (ULONG i = static_cast<ULONG>(itemDirectives.offset()); i < sprows->cRows; i++)
+	{
+		callback(sprows->aRow[i]);
 	}
 }
 
-rowset_ptr TableDirectives::read(IMAPITable* pTable, mapi_ptr<SPropTagArray>&& defaultColumns,
-	mapi_ptr<SSortOrderSet>&& defaultOrder) const
+ULONG TableDirectives::count(TableHandle& table) const
 {
-	rowset_ptr result;
-	const auto defaultColumnCount =
-		static_cast<size_t>(defaultColumns ? defaultColumns->cValues : 0);
-	const auto properties = columns(std::move(defaultColumns));
-	const auto sorts = orderBy(std::move(defaultOrder));
-	const auto findRow = seek();
-	const BOOKMARK bookmark = seekBookmark();
+	// Only @where limits the count, the other directives just select a window of the rows. Passing
+	// nullptr to Restrict also removes the boundary restriction from an earlier page.
+	const auto restriction = where();
+	ULONG rowCount = 0;
 
-	CORt(pTable->SetColumns(properties.get(), TBL_BATCH));
+	table.restrictTable(restriction.get());
+	CORt(table.table()->GetRowCount(0, &rowCount));
 
-	if (sorts)
+	return rowCount;
+}
+
+bool TableDirectives::projected() const noexcept
+{
+	return m_select.has_value();
+}
+
+bool TableDirectives::streamed() const noexcept
+{
+	return m_chunked.has_value();
+}
+
+const service::Directives& TableDirectives::viewKey() const noexcept
+{
+	return m_viewKey;
+}
+
+TableWindow TableDirectives::window(const TableHandle& table, size_t rowCount) const
+{
+	TableWindow result;
+
+	result.tableVersion = table.version();
+	result.projected = projected();
+
+	// Windows which skip any rows at the beginning of the table, or read backwards from the end of
+	// it, can't tell where a new row belongs if it's added before the first row in the window. With
+	// @readAhead, the window may also have been parked while the table had a different view.
+	if (m_seek || offset() != 0 || readAhead() > 0)
 	{
-		CORt(pTable->SortTable(sorts.get(), TBL_BATCH));
+		return result;
 	}
 
-	if (findRow)
+	if (m_chunked)
+	{
+		// A positive @take limits the total number of rows without the usual cap, otherwise
+		// enumerate keeps reading until it reaches the end of the table.
+		result.limit = (m_take && *m_take > 0) ? static_cast<size_t>(*m_take) : SIZE_MAX;
+	}
+	else if (take() > 0)
 	{
-		CORt(pTable->FindRow(findRow.get(), BOOKMARK_BEGINNING, 0));
+		result.limit = static_cast<size_t>(take());
 	}
 
-	CORt(pTable->SeekRow(bookmark, offset(), nullptr));
-	CORt(pTable->QueryRows(take(), 0, &out_ptr { result }));
+	result.truncated = result.limit && rowCount >= *result.limit;
 
 	return result;
 }
 
-mapi_ptr<SPropTagArray> TableDirectives::columns(mapi_ptr<SPropTagArray>&& defaultColumns) const
+void TableDirectives::position(TableHandle& table, const SPropTagArray& defaultColumns,
+	const SSortOrderSet* defaultOrder) const
 {
-	auto result = std::move(defaultColumns);
+	TagBuffer columnBuffer;
+	TagBuffer sortBuffer;
+	const auto& properties = columns(defaultColumns, columnBuffer);
+	const auto sorts = orderBy(defaultOrder, sortBuffer);
+	const auto restriction = where();
+	const auto findRow = seek();
+	const BOOKMARK bookmark = seekBookmark();
+
+	table.setColumns(properties);
+	table.sortTable(sorts);
+	table.restrictTable(restriction.get());
+
+	if (findRow)
+	{
+		CORt(table.table()->FindRow(findRow.get(), BOOKMARK_BEGINNING, 0));
+	}
 
+	CORt(table.table()->SeekRow(bookmark, offset(), nullptr));
+}
+
+const SPropTagArray& TableDirectives::columns(
+	const SPropTagArray& defaultColumns, TagBuffer& buffer) const
+{
 	if (m_columns && !m_columns->empty())
 	{
-		mapi_ptr<SPropTagArray> mergedColumns;
-		const size_t defaultCount = result ? static_cast<size_t>(result->cValues) : 0;
+		const size_t defaultCount = static_cast<size_t>(defaultColumns.cValues);
 
-		CORt(::MAPIAllocateBuffer(CbNewSPropTagArray(defaultCount + m_columns->size()),
-			reinterpret_cast<void**>(&out_ptr { mergedColumns })));
-		CFRt(mergedColumns != nullptr);
-		mergedColumns->cValues = static_cast<ULONG>(defaultCount + m_columns->size());
-		std::copy(result->aulPropTag, result->aulPropTag + defaultCount, mergedColumns->aulPropTag);
+		buffer.assign({ static_cast<ULONG>(defaultCount + m_columns->size()) });
+		buffer.append(defaultColumns.aulPropTag, defaultColumns.aulPropTag + defaultCount);
+		buffer.resize(1 + defaultCount + m_columns->size());
 
 		std::vector<PropIdInput> propIds(m_columns->size());
 
@@ -127,11 +1092,11 @@ mapi_ptr<SPropTagArray> TableDirectives::columns(mapi_ptr<SPropTagArray>&& defau
 				return column.property;
 			});
 
-		std::vector<std::pair<ULONG, LPMAPINAMEID>> resolved;
+		std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> resolved;
 
 		if (m_store)
 		{
-			resolved = m_store->lookupPropIdInputs(std::move(propIds));
+			resolved = m_store->lookupPropIdInputs(propIds);
 		}
 		else
 		{
@@ -162,19 +1127,18 @@ mapi_ptr<SPropTagArray> TableDirectives::columns(mapi_ptr<SPropTagArray>&& defau
 			const auto propType = c_propTypes[static_cast<size_t>(m_columns->at(i).type)];
 			const auto propId = PROP_ID(resolved[i].first);
 
-			mergedColumns->aulPropTag[defaultCount + i] = PROP_TAG(propType, propId);
+			buffer[1 + defaultCount + i] = PROP_TAG(propType, propId);
 		}
 
-		result = std::move(mergedColumns);
+		return *reinterpret_cast<const SPropTagArray*>(buffer.data());
 	}
 
-	return result;
+	return defaultColumns;
 }
 
-mapi_ptr<SSortOrderSet> TableDirectives::orderBy(mapi_ptr<SSortOrderSet>&& defaultOrder) const
+const SSortOrderSet* TableDirectives::orderBy(
+	const SSortOrderSet* defaultOrder, TagBuffer& buffer) const
 {
-	auto result = std::move(defaultOrder);
-
 	if (m_orderBy && !m_orderBy->empty())
 	{
 		std::vector<PropIdInput> propIds(m_orderBy->size());
@@ -186,11 +1150,11 @@ mapi_ptr<SSortOrderSet> TableDirectives::orderBy(mapi_ptr<SSortOrderSet>&& defau
 				return order.property;
 			});
 
-		std::vector<std::pair<ULONG, LPMAPINAMEID>> resolved;
+		std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> resolved;
 
 		if (m_store)
 		{
-			resolved = m_store->lookupPropIdInputs(std::move(propIds));
+			resolved = m_store->lookupPropIdInputs(propIds);
 		}
 		else
 		{
@@ -206,12 +1170,10 @@ mapi_ptr<SSortOrderSet> TableDirectives::orderBy(mapi_ptr<SSortOrderSet>&& defau
 		}
 
 		CFRt(resolved.size() == m_orderBy->size());
-		CORt(::MAPIAllocateBuffer(CbNewSSortOrderSet(resolved.size()),
-			reinterpret_cast<void**>(&out_ptr { result })));
-		CFRt(result != nullptr);
-		result->cSorts = static_cast<ULONG>(resolved.size());
-		result->cCategories = 0;
-		result->cExpanded = 0;
+
+		// Lay out the buffer as an SSortOrderSet with no categories.
+		buffer.reserve(3 + 2 * resolved.size());
+		buffer.assign({ static_cast<ULONG>(resolved.size()), 0, 0 });
 
 		for (size_t i = 0; i < resolved.size(); ++i)
 		{
@@ -229,12 +1191,291 @@ mapi_ptr<SSortOrderSet> TableDirectives::orderBy(mapi_ptr<SSortOrderSet>&& defau
 			const auto propType = c_propTypes[static_cast<size_t>(m_orderBy->at(i).type)];
 			const auto propId = PROP_ID(resolved[i].first);
 
-			result->aSort[i].ulPropTag = PROP_TAG(propType, propId);
-			result->aSort[i].ulOrder =
-				m_orderBy->at(i).descending ? TABLE_SORT_DESCEND : TABLE_SORT_ASCEND;
+			buffer.push_back(PROP_TAG(propType, propId));
+			buffer.push_back(m_orderBy->at(i).descending ? TABLE_SORT_DESCEND : TABLE_SORT_ASCEND);
+		}
+
+		return reinterpret_cast<const SSortOrderSet*>(buffer.data());
+	}
+
+	return defaultOrder;
+}
+
+const SSortOrderSet* TableDirectives::groupBy(
+	const SSortOrderSet* defaultOrder, TagBuffer& buffer) const
+{
+	CFRt(m_groupBy.has_value());
+
+	std::pair<ULONG, LPMAPINAMEID> resolved {};
+
+	if (m_store)
+	{
+		std::vector<PropIdInput> propIds { m_groupBy->property };
+		auto lookup = m_store->lookupPropIdInputs(propIds);
+
+		CFRt(lookup.size() == 1);
+		resolved = lookup.front();
+	}
+	else
+	{
+		// Can't use named properties without a store to call GetIDsFromNames
+		CFRt(m_groupBy->property.id && !m_groupBy->property.named);
+		resolved = std::make_pair(PROP_TAG(PT_UNSPECIFIED, *m_groupBy->property.id), nullptr);
+	}
+
+	constexpr std::array c_propTypes {
+		PT_LONG,
+		PT_BOOLEAN,
+		PT_UNICODE,
+		PT_CLSID,
+		PT_SYSTIME,
+		PT_BINARY,
+	};
+
+	CFRt(static_cast<size_t>(m_groupBy->type) < c_propTypes.size());
+
+	const auto categoryTag =
+		PROP_TAG(c_propTypes[static_cast<size_t>(m_groupBy->type)], PROP_ID(resolved.first));
+	TagBuffer sortBuffer;
+	const auto sorts = orderBy(defaultOrder, sortBuffer);
+
+	// Lay out the buffer as an SSortOrderSet with the category first and every category collapsed,
+	// followed by the @orderBy or default sorts within each category.
+	buffer.assign({ 1,
+		1,
+		0,
+		categoryTag,
+		static_cast<ULONG>(m_groupBy->descending ? TABLE_SORT_DESCEND : TABLE_SORT_ASCEND) });
+
+	if (sorts)
+	{
+		for (ULONG i = 0; i != sorts->cSorts; i++)
+		{
+			// MAPI doesn't allow the same property in more than one sort key.
+			if (PROP_ID(sorts->aSort[i].ulPropTag) != PROP_ID(categoryTag))
+			{
+				buffer.push_back(sorts->aSort[i].ulPropTag);
+				buffer.push_back(sorts->aSort[i].ulOrder);
+				++buffer[0];
+			}
+		}
+	}
+
+	return reinterpret_cast<const SSortOrderSet*>(buffer.data());
+}
+
+mapi_ptr<SRestriction> TableDirectives::where() const
+{
+	mapi_ptr<SRestriction> result;
+
+	if (m_where)
+	{
+		// Can't convert the property values or resolve named properties without a store, and only
+		// the stores table is read without one.
+		if (!m_store)
+		{
+			ThrowDirectiveError("@where can't be used on stores");
+		}
+
+		std::vector<PropertyInput> values;
+		std::vector<PropIdInput> existIds;
+
+		CollectRestriction(*m_where, values, existIds);
+
+		const size_t valueCount = values.size();
+		LPSPropValue props = nullptr;
+
+		CORt(::MAPIAllocateBuffer(static_cast<ULONG>(sizeof(*result)),
+			reinterpret_cast<void**>(&out_ptr { result })));
+		CFRt(result != nullptr);
+
+		if (valueCount > 0)
+		{
+			CORt(::MAPIAllocateMore(static_cast<ULONG>(sizeof(*props) * valueCount),
+				result.get(),
+				reinterpret_cast<void**>(&props)));
+			CFRt(props != nullptr);
+			m_store->ConvertPropertyInputs(result.get(),
+				props,
+				props + valueCount,
+				std::move(values));
+		}
+
+		const auto resolved = m_store->lookupPropIdInputs(existIds);
+		auto nextValue = props;
+		auto nextExist = resolved.cbegin();
+
+		BuildRestriction(*m_where, *result, result.get(), nextValue, nextExist);
+		CFRt(nextValue == props + valueCount);
+		CFRt(nextExist == resolved.cend());
+	}
+
+	return result;
+}
+
+mapi_ptr<SRestriction> TableDirectives::resumeAfter(
+	const convert::cursor::Boundary& boundary, const SSortOrderSet* sorts)
+{
+	const size_t sortCount = sorts ? static_cast<size_t>(sorts->cSorts) : 0;
+
+	// The cursor must have been created with the same sort order, otherwise it's invalid.
+	if (boundary.sortValues.size() != sortCount)
+	{
+		return {};
+	}
+
+	for (size_t i = 0; i < sortCount; ++i)
+	{
+		const auto boundaryTag = boundary.sortValues[i].ulPropTag;
+		const auto sortTag = sorts->aSort[i].ulPropTag;
+
+		if (PROP_ID(boundaryTag) != PROP_ID(sortTag)
+			|| (PROP_TYPE(boundaryTag) != PT_ERROR && boundaryTag != sortTag))
+		{
+			return {};
+		}
+	}
+
+	// Match rows which sort strictly after the boundary row, with PR_INSTANCE_KEY as the last sort
+	// key from AppendInstanceKeySort. For sort keys (a, b), this builds:
+	// (a > A) OR (a = A AND b > B) OR (a = A AND b = B AND instanceKey > K)
+	// Descending sort keys use <. Missing values sort before every other value, so if the boundary
+	// is missing a, then a = A becomes NOT EXIST(a) and a > A becomes EXIST(a). If the boundary has
+	// a value for a descending key, rows which are missing it come after the boundary as well.
+	mapi_ptr<SRestriction> result;
+
+	CORt(::MAPIAllocateBuffer(static_cast<ULONG>(sizeof(*result)),
+		reinterpret_cast<void**>(&out_ptr { result })));
+	CFRt(result != nullptr);
+
+	const auto allocate = [&result](size_t count) {
+		LPSRestriction pRestrictions = nullptr;
+
+		CORt(::MAPIAllocateMore(static_cast<ULONG>(sizeof(*pRestrictions) * count),
+			result.get(),
+			reinterpret_cast<void**>(&pRestrictions)));
+		CFRt(pRestrictions != nullptr);
+
+		return pRestrictions;
+	};
+	const auto setProperty = [](SRestriction& restriction, ULONG relop, const SPropValue& value) {
+		restriction.rt = RES_PROPERTY;
+		restriction.res.resProperty.relop = relop;
+		restriction.res.resProperty.ulPropTag = value.ulPropTag;
+		restriction.res.resProperty.lpProp = const_cast<LPSPropValue>(&value);
+	};
+	const auto setMissing = [&allocate](SRestriction& restriction, ULONG propTag) {
+		const auto pExist = allocate(1);
+
+		pExist->rt = RES_EXIST;
+		pExist->res.resExist.ulReserved1 = 0;
+		pExist->res.resExist.ulPropTag = propTag;
+		pExist->res.resExist.ulReserved2 = 0;
+
+		restriction.rt = RES_NOT;
+		restriction.res.resNot.ulReserved = 0;
+		restriction.res.resNot.lpRes = pExist;
+	};
+	const auto isMissing = [&boundary](size_t key) noexcept {
+		return PROP_TYPE(boundary.sortValues[key].ulPropTag) == PT_ERROR;
+	};
+	const auto setEqual = [&](SRestriction& restriction, size_t key) {
+		if (isMissing(key))
+		{
+			setMissing(restriction, sorts->aSort[key].ulPropTag);
+		}
+		else
+		{
+			setProperty(restriction, RELOP_EQ, boundary.sortValues[key]);
+		}
+	};
+
+	// Returns false if no value of this sort key can come after the boundary value.
+	const auto setAfter = [&](SRestriction& restriction, size_t key) {
+		const auto propTag = sorts->aSort[key].ulPropTag;
+		const bool descending = (sorts->aSort[key].ulOrder == TABLE_SORT_DESCEND);
+
+		if (isMissing(key))
+		{
+			if (descending)
+			{
+				return false;
+			}
+
+			restriction.rt = RES_EXIST;
+			restriction.res.resExist.ulReserved1 = 0;
+			restriction.res.resExist.ulPropTag = propTag;
+			restriction.res.resExist.ulReserved2 = 0;
+		}
+		else if (descending)
+		{
+			const auto pEither = allocate(2);
+
+			setProperty(pEither[0], RELOP_LT, boundary.sortValues[key]);
+			setMissing(pEither[1], propTag);
+
+			restriction.rt = RES_OR;
+			restriction.res.resOr.cRes = 2;
+			restriction.res.resOr.lpRes = pEither;
 		}
+		else
+		{
+			setProperty(restriction, RELOP_GT, boundary.sortValues[key]);
+		}
+
+		return true;
+	};
+
+	const auto pTerms = allocate(sortCount + 1);
+	ULONG termCount = 0;
+
+	for (size_t i = 0; i <= sortCount; ++i)
+	{
+		const auto pKeys = allocate(i + 1);
+
+		for (size_t j = 0; j < i; ++j)
+		{
+			setEqual(pKeys[j], j);
+		}
+
+		if (i == sortCount)
+		{
+			// Break the tie on every sort key with the instance key.
+			LPSPropValue pInstanceKey = nullptr;
+			LPBYTE pbInstanceKey = nullptr;
+			const auto cbInstanceKey = static_cast<ULONG>(boundary.instanceKey.size());
+
+			CORt(::MAPIAllocateMore(static_cast<ULONG>(sizeof(*pInstanceKey)),
+				result.get(),
+				reinterpret_cast<void**>(&pInstanceKey)));
+			CFRt(pInstanceKey != nullptr);
+			CORt(::MAPIAllocateMore(std::max<ULONG>(1, cbInstanceKey),
+				result.get(),
+				reinterpret_cast<void**>(&pbInstanceKey)));
+			CFRt(pbInstanceKey != nullptr);
+			memmove(pbInstanceKey, boundary.instanceKey.data(), boundary.instanceKey.size());
+
+			pInstanceKey->ulPropTag = PR_INSTANCE_KEY;
+			pInstanceKey->dwAlignPad = 0;
+			pInstanceKey->Value.bin.cb = cbInstanceKey;
+			pInstanceKey->Value.bin.lpb = pbInstanceKey;
+			setProperty(pKeys[i], RELOP_GT, *pInstanceKey);
+		}
+		else if (!setAfter(pKeys[i], i))
+		{
+			continue;
+		}
+
+		pTerms[termCount].rt = RES_AND;
+		pTerms[termCount].res.resAnd.cRes = static_cast<ULONG>(i + 1);
+		pTerms[termCount].res.resAnd.lpRes = pKeys;
+		++termCount;
 	}
 
+	result->rt = RES_OR;
+	result->res.resOr.cRes = termCount;
+	result->res.resOr.lpRes = pTerms;
+
 	return result;
 }
 
@@ -288,4 +1529,40 @@ LONG TableDirectives::take() const
 					*m_take)));
 }
 
+size_t TableDirectives::readAhead() const
+{
+	return static_cast<size_t>(!m_readAhead || *m_readAhead <= 0
+			? 0					  // Don't read ahead unless @readAhead asks for it.
+			: std::min<int>(10,	  // Cap the read ahead at 10 pages.
+				*m_readAhead));
+}
+
+size_t TableDirectives::readAheadBudget() const
+{
+	// Default to a 1 MB budget for all of the pages parked on each table.
+	return static_cast<size_t>(!m_readAheadBudget || !*m_readAheadBudget || **m_readAheadBudget <= 0
+			? 1024 * 1024
+			: **m_readAheadBudget);
+}
+
+void TableDirectives::parkPage(TableHandle& table, PagePosition&& position,
+	std::vector<ParkedRow>&& rows, bool hasNextPage) const
+{
+	ParkedPage page;
+
+	page.directives = m_pageKey;
+	page.position = std::move(position);
+	page.rows = std::move(rows);
+	page.hasNextPage = hasNextPage;
+	table.parkPage(std::move(page), readAheadBudget());
+}
+
+size_t TableDirectives::chunked() const
+{
+	return static_cast<size_t>(!m_chunked || *m_chunked <= 0
+			? 50				   // Default to 50 if 0 or a negative number was specified.
+			: std::min<int>(500,   // Cap chunks at 500 rows.
+				*m_chunked));
+}
+
 } // namespace graphql::mapi
@@ -0,0 +1,404 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Types.h"
+
+namespace graphql::mapi {
+
+namespace {
+
+template <class T>
+void AppendKeyValue(std::vector<std::uint8_t>& key, const T& value)
+{
+	const auto bytes = reinterpret_cast<const std::uint8_t*>(&value);
+
+	key.insert(key.end(), bytes, bytes + sizeof(value));
+}
+
+void AppendKeyBytes(std::vector<std::uint8_t>& key, const void* data, size_t size)
+{
+	const auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+
+	// Prefix the length, so adjacent values can't run together.
+	AppendKeyValue(key, size);
+	key.insert(key.end(), bytes, bytes + size);
+}
+
+bool AppendPropKey(std::vector<std::uint8_t>& key, const SPropValue& prop)
+{
+	AppendKeyValue(key, prop.ulPropTag);
+
+	switch (PROP_TYPE(prop.ulPropTag))
+	{
+		case PT_I2:
+			AppendKeyValue(key, prop.Value.i);
+			return true;
+
+		case PT_LONG:
+			AppendKeyValue(key, prop.Value.l);
+			return true;
+
+		case PT_BOOLEAN:
+			AppendKeyValue(key, prop.Value.b);
+			return true;
+
+		case PT_R4:
+			AppendKeyValue(key, prop.Value.flt);
+			return true;
+
+		case PT_DOUBLE:
+		case PT_APPTIME:
+			AppendKeyValue(key, prop.Value.dbl);
+			return true;
+
+		case PT_CURRENCY:
+		case PT_I8:
+			AppendKeyValue(key, prop.Value.li);
+			return true;
+
+		case PT_SYSTIME:
+			AppendKeyValue(key, prop.Value.ft);
+			return true;
+
+		case PT_ERROR:
+			AppendKeyValue(key, prop.Value.err);
+			return true;
+
+		case PT_NULL:
+			return true;
+
+		case PT_UNICODE:
+			AppendKeyBytes(key, prop.Value.lpszW, wcslen(prop.Value.lpszW) * sizeof(wchar_t));
+			return true;
+
+		case PT_STRING8:
+			AppendKeyBytes(key, prop.Value.lpszA, strlen(prop.Value.lpszA));
+			return true;
+
+		case PT_BINARY:
+			AppendKeyBytes(key, prop.Value.bin.lpb, static_cast<size_t>(prop.Value.bin.cb));
+			return true;
+
+		case PT_CLSID:
+			AppendKeyValue(key, *prop.Value.lpguid);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool AppendRestrictionKey(std::vector<std::uint8_t>& key, const SRestriction& restriction);
+
+bool AppendRestrictionsKey(
+	std::vector<std::uint8_t>& key, ULONG count, const SRestriction* children)
+{
+	AppendKeyValue(key, count);
+
+	for (ULONG i = 0; i != count; i++)
+	{
+		if (!AppendRestrictionKey(key, children[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Append a flat copy of the restriction to the key, so the next restriction can be compared with
+// it. Returns false if it has a type of restriction or property value we don't compare.
+bool AppendRestrictionKey(std::vector<std::uint8_t>& key, const SRestriction& restriction)
+{
+	AppendKeyValue(key, restriction.rt);
+
+	switch (restriction.rt)
+	{
+		case RES_AND:
+			return AppendRestrictionsKey(key,
+				restriction.res.resAnd.cRes,
+				restriction.res.resAnd.lpRes);
+
+		case RES_OR:
+			return AppendRestrictionsKey(key,
+				restriction.res.resOr.cRes,
+				restriction.res.resOr.lpRes);
+
+		case RES_NOT:
+			return AppendRestrictionKey(key, *restriction.res.resNot.lpRes);
+
+		case RES_CONTENT:
+		{
+			const auto& resContent = restriction.res.resContent;
+
+			AppendKeyValue(key, resContent.ulFuzzyLevel);
+			AppendKeyValue(key, resContent.ulPropTag);
+			return AppendPropKey(key, *resContent.lpProp);
+		}
+
+		case RES_PROPERTY:
+		{
+			const auto& resProperty = restriction.res.resProperty;
+
+			AppendKeyValue(key, resProperty.relop);
+			AppendKeyValue(key, resProperty.ulPropTag);
+			return AppendPropKey(key, *resProperty.lpProp);
+		}
+
+		case RES_COMPAREPROPS:
+		{
+			const auto& resCompareProps = restriction.res.resCompareProps;
+
+			AppendKeyValue(key, resCompareProps.relop);
+			AppendKeyValue(key, resCompareProps.ulPropTag1);
+			AppendKeyValue(key, resCompareProps.ulPropTag2);
+			return true;
+		}
+
+		case RES_BITMASK:
+		{
+			const auto& resBitMask = restriction.res.resBitMask;
+
+			AppendKeyValue(key, resBitMask.relBMR);
+			AppendKeyValue(key, resBitMask.ulPropTag);
+			AppendKeyValue(key, resBitMask.ulMask);
+			return true;
+		}
+
+		case RES_SIZE:
+		{
+			const auto& resSize = restriction.res.resSize;
+
+			AppendKeyValue(key, resSize.relop);
+			AppendKeyValue(key, resSize.ulPropTag);
+			AppendKeyValue(key, resSize.cb);
+			return true;
+		}
+
+		case RES_EXIST:
+			AppendKeyValue(key, restriction.res.resExist.ulPropTag);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+} // namespace
+
+size_t GetRowBytes(ULONG columnCount, const SPropValue* columns) noexcept
+{
+	size_t result = sizeof(*columns) * static_cast<size_t>(columnCount);
+
+	for (ULONG i = 0; i != columnCount; i++)
+	{
+		const auto& prop = columns[i];
+
+		switch (PROP_TYPE(prop.ulPropTag))
+		{
+			case PT_UNICODE:
+				result += (wcslen(prop.Value.lpszW) + 1) * sizeof(*prop.Value.lpszW);
+				break;
+
+			case PT_STRING8:
+				result += strlen(prop.Value.lpszA) + 1;
+				break;
+
+			case PT_BINARY:
+				result += static_cast<size_t>(prop.Value.bin.cb);
+				break;
+
+			case PT_CLSID:
+				result += sizeof(*prop.Value.lpguid);
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	return result;
+}
+
+TableHandle::TableHandle(IMAPITable* pTable) noexcept
+	: m_table { pTable }
+{
+}
+
+IMAPITable* TableHandle::table() const noexcept
+{
+	return m_table;
+}
+
+void TableHandle::setColumns(const SPropTagArray& columns)
+{
+	const auto propTags = columns.aulPropTag;
+	const auto propCount = static_cast<size_t>(columns.cValues);
+
+	// Compare the tags in place, so reading the same columns again doesn't allocate.
+	if (m_columns
+		&& std::equal(m_columns->cbegin(), m_columns->cend(), propTags, propTags + propCount))
+	{
+		return;
+	}
+
+	// The columns may be a static TableSchema, but MAPI doesn't modify them.
+	m_columns.reset();
+	++m_version;
+	CORt(m_table->SetColumns(const_cast<LPSPropTagArray>(&columns), TBL_BATCH));
+	m_columns.emplace(propTags, propTags + propCount);
+}
+
+void TableHandle::sortTable(const SSortOrderSet* sorts)
+{
+	// The last sort order is kept flattened, an empty vector means the table is still in its
+	// native order. Compare the sort keys in place, so sorting the same way again doesn't allocate.
+	const auto sameSorts = [this, sorts]() noexcept {
+		if (!m_sorts)
+		{
+			return false;
+		}
+
+		const auto& sortKey = *m_sorts;
+
+		if (!sorts)
+		{
+			return sortKey.empty();
+		}
+
+		if (sortKey.size() != 2 + 2 * static_cast<size_t>(sorts->cSorts)
+			|| sortKey[0] != sorts->cCategories || sortKey[1] != sorts->cExpanded)
+		{
+			return false;
+		}
+
+		for (ULONG i = 0; i != sorts->cSorts; i++)
+		{
+			if (sortKey[2 + 2 * i] != sorts->aSort[i].ulPropTag
+				|| sortKey[3 + 2 * i] != sorts->aSort[i].ulOrder)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	if (sameSorts())
+	{
+		return;
+	}
+
+	SSortOrderSet unsorted {};
+
+	m_sorts.reset();
+	++m_version;
+	CORt(m_table->SortTable(const_cast<LPSSortOrderSet>(sorts ? sorts : &unsorted), TBL_BATCH));
+
+	std::vector<ULONG> sortKey;
+
+	if (sorts)
+	{
+		sortKey.reserve(2 + 2 * static_cast<size_t>(sorts->cSorts));
+		sortKey.push_back(sorts->cCategories);
+		sortKey.push_back(sorts->cExpanded);
+
+		for (ULONG i = 0; i != sorts->cSorts; i++)
+		{
+			sortKey.push_back(sorts->aSort[i].ulPropTag);
+			sortKey.push_back(sorts->aSort[i].ulOrder);
+		}
+	}
+
+	m_sorts = std::move(sortKey);
+}
+
+void TableHandle::restrictTable(LPSRestriction restriction)
+{
+	// Restrictions are rebuilt for every read, so flatten this one into a key and compare it with
+	// the last one, an empty key means the table isn't restricted. The key buffers are swapped and
+	// reused, so they stop allocating once they are big enough.
+	m_nextRestriction.clear();
+
+	const bool comparable = !restriction || AppendRestrictionKey(m_nextRestriction, *restriction);
+
+	if (comparable && m_restrictionKnown && m_restriction == m_nextRestriction)
+	{
+		return;
+	}
+
+	m_restrictionKnown = false;
+	++m_version;
+	CORt(m_table->Restrict(restriction, TBL_BATCH));
+
+	if (comparable)
+	{
+		m_restriction.swap(m_nextRestriction);
+		m_restrictionKnown = true;
+	}
+}
+
+size_t TableHandle::version() const noexcept
+{
+	return m_version;
+}
+
+void TableHandle::parkPage(ParkedPage&& page, size_t budget)
+{
+	page.bytes = sizeof(page);
+
+	for (const auto& row : page.rows)
+	{
+		page.bytes += sizeof(row) + GetRowBytes(row.columnCount, row.columns.get());
+	}
+
+	if (page.bytes > budget)
+	{
+		return;
+	}
+
+	// Replace any page at the same position, then make room by evicting the oldest pages.
+	takePage(*page.directives, page.position);
+
+	while (!m_pages.empty() && m_pageBytes + page.bytes > budget)
+	{
+		m_pageBytes -= m_pages.front().bytes;
+		m_pages.erase(m_pages.begin());
+	}
+
+	m_pageBytes += page.bytes;
+	m_pages.push_back(std::move(page));
+}
+
+std::optional<ParkedPage> TableHandle::takePage(
+	const service::Directives& directives, const PagePosition& position)
+{
+	const auto itr = std::find_if(m_pages.begin(), m_pages.end(), [&](const ParkedPage& page) {
+		return page.position == position && *page.directives == directives;
+	});
+
+	if (itr == m_pages.end())
+	{
+		return std::nullopt;
+	}
+
+	auto result = std::make_optional(std::move(*itr));
+
+	m_pageBytes -= result->bytes;
+	m_pages.erase(itr);
+
+	return result;
+}
+
+void TableHandle::discardPages() noexcept
+{
+	m_pages.clear();
+	m_pageBytes = 0;
+}
+
+size_t TableHandle::pageBytes() const noexcept
+{
+	return m_pageBytes;
+}
+
+} // namespace graphql::mapi
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "Types.h"
+
+namespace graphql::mapi {
+
+// How a row in a cached window changed after a table notification. Updated rows stay at the same
+// index, any row which moves is Removed from its old index and Added at its new index.
+enum class RowChange
+{
+	Added,
+	Updated,
+	Removed,
+};
+
+// Returns keys.size() if the row isn't in the window.
+inline size_t FindTableRow(const InstanceKeyColumn& keys, const SPropValue& key)
+{
+	if (key.ulPropTag != PR_INSTANCE_KEY)
+	{
+		return keys.size();
+	}
+
+	return keys.find(reinterpret_cast<const std::uint8_t*>(key.Value.bin.lpb),
+		static_cast<size_t>(key.Value.bin.cb));
+}
+
+// Insert the row from a TABLE_ROW_ADDED or TABLE_ROW_MODIFIED notification after its prior row, if
+// it belongs in the window. Returns false if there's no way to tell where it belongs.
+template <class T, class MakeRow, class Changed>
+bool InsertTableRow(const TABLE_NOTIFICATION& notification, TableWindow& window,
+	std::vector<std::shared_ptr<T>>& rows, InstanceKeyColumn& keys, MakeRow& makeRow,
+	Changed& changed)
+{
+	size_t index = 0;
+
+	if (notification.propPrior.ulPropTag != PR_NULL)
+	{
+		const auto prior = FindTableRow(keys, notification.propPrior);
+
+		if (prior == rows.size())
+		{
+			// If the prior row isn't in the window, it should be after the end of a full window.
+			return window.truncated;
+		}
+
+		index = prior + 1;
+	}
+
+	if (index == rows.size() && window.truncated)
+	{
+		// The new row is right after the end of a full window.
+		return true;
+	}
+
+	std::shared_ptr<T> row = makeRow(notification.row);
+
+	keys.insert(index, row->instanceKey());
+	rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(index), row);
+	changed(RowChange::Added, index, row);
+
+	if (rows.size() > *window.limit)
+	{
+		// The last row slides out of a full window.
+		auto last = std::move(rows.back());
+
+		rows.pop_back();
+		keys.pop_back();
+		window.truncated = true;
+		changed(RowChange::Removed, rows.size(), last);
+	}
+
+	return true;
+}
+
+// Apply a single table notification to a window of rows which was read from the beginning of the
+// table, with the instance keys of the rows in the same order. makeRow builds a new row object from
+// the SRow in a notification, and changed is called with the index of each row which is added,
+// updated, or removed from the window. Returns false if the window needs to be read again, e.g.
+// after TABLE_RELOAD, or when a row which was after the end of a full window would move into it.
+template <class T, class MakeRow, class Changed>
+bool ApplyTableNotification(const NOTIFICATION& notification, TableWindow& window,
+	std::vector<std::shared_ptr<T>>& rows, InstanceKeyColumn& keys, MakeRow&& makeRow,
+	Changed&& changed)
+{
+	if (notification.ulEventType != fnevTableModified || !window.limit)
+	{
+		return false;
+	}
+
+	const auto& tab = notification.info.tab;
+
+	switch (tab.ulTableEvent)
+	{
+		case TABLE_ROW_ADDED:
+			return InsertTableRow(tab, window, rows, keys, makeRow, changed);
+
+		case TABLE_ROW_MODIFIED:
+		{
+			const auto index = FindTableRow(keys, tab.propIndex);
+
+			if (index == rows.size())
+			{
+				// The row may have moved into the window.
+				return InsertTableRow(tab, window, rows, keys, makeRow, changed);
+			}
+
+			const auto prior = (tab.propPrior.ulPropTag == PR_NULL)
+				? std::make_optional<size_t>()
+				: std::make_optional(FindTableRow(keys, tab.propPrior));
+
+			if ((!prior && index == 0) || (prior && *prior + 1 == index))
+			{
+				// The instance key and the position stay the same, so only the row is replaced.
+				rows[index] = makeRow(tab.row);
+				changed(RowChange::Updated, index, rows[index]);
+				return true;
+			}
+
+			// The row moved, so take it out and insert it after the prior row.
+			auto removed = std::move(rows[index]);
+
+			rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(index));
+			keys.erase(index);
+			changed(RowChange::Removed, index, removed);
+
+			const size_t remaining = rows.size();
+
+			if (!InsertTableRow(tab, window, rows, keys, makeRow, changed))
+			{
+				return false;
+			}
+
+			// If it moved past the end of a full window, we don't know which row takes its place.
+			return !window.truncated || rows.size() != remaining;
+		}
+
+		case TABLE_ROW_DELETED:
+		{
+			const auto index = FindTableRow(keys, tab.propIndex);
+
+			if (index == rows.size())
+			{
+				// The window starts at the beginning of the table, so the row was after it.
+				return true;
+			}
+
+			if (window.truncated)
+			{
+				// The next row after a full window would take its place.
+				return false;
+			}
+
+			auto removed = std::move(rows[index]);
+
+			rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(index));
+			keys.erase(index);
+			changed(RowChange::Removed, index, removed);
+			return true;
+		}
+
+		case TABLE_SETCOL_DONE:
+		case TABLE_SORT_DONE:
+		case TABLE_RESTRICT_DONE:
+			// These follow our own calls on the table, which don't change the rows.
+			return true;
+
+		default:
+			// TABLE_CHANGED, TABLE_ERROR and TABLE_RELOAD all need a full reload.
+			return false;
+	}
+}
+
+} // namespace graphql::mapi
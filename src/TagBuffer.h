@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace graphql::mapi {
+
+// SPropTagArray or SSortOrderSet built at runtime, e.g. to merge @columns with the default columns.
+// Both of them are made up of ULONG values, so they can share the same layout. The values are kept
+// inline up to a fixed capacity, which covers the default columns and sort orders with room for
+// several @columns and @orderBy properties, so building them doesn't allocate. Only longer lists
+// fall back to the heap.
+class TagBuffer
+{
+public:
+	static constexpr size_t InlineCapacity = 64;
+
+	TagBuffer() noexcept = default;
+
+	explicit TagBuffer(size_t count)
+	{
+		resize(count);
+	}
+
+	ULONG* data() noexcept
+	{
+		return m_heap.empty() ? m_inline.data() : m_heap.data();
+	}
+
+	const ULONG* data() const noexcept
+	{
+		return m_heap.empty() ? m_inline.data() : m_heap.data();
+	}
+
+	ULONG* begin() noexcept
+	{
+		return data();
+	}
+
+	ULONG* end() noexcept
+	{
+		return data() + m_size;
+	}
+
+	ULONG& operator[](size_t index) noexcept
+	{
+		return data()[index];
+	}
+
+	ULONG& back() noexcept
+	{
+		return data()[m_size - 1];
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	size_t capacity() const noexcept
+	{
+		return m_heap.empty() ? InlineCapacity : m_heap.size();
+	}
+
+	void reserve(size_t count)
+	{
+		if (count <= capacity())
+		{
+			return;
+		}
+
+		// The heap storage is always filled up to its capacity, m_size tracks how much is used.
+		std::vector<ULONG> heap(std::max(count, 2 * capacity()));
+
+		std::copy(data(), data() + m_size, heap.begin());
+		m_heap = std::move(heap);
+	}
+
+	void resize(size_t count)
+	{
+		reserve(count);
+
+		if (count > m_size)
+		{
+			std::fill(data() + m_size, data() + count, ULONG { 0 });
+		}
+
+		m_size = count;
+	}
+
+	void push_back(ULONG value)
+	{
+		reserve(m_size + 1);
+		data()[m_size++] = value;
+	}
+
+	void append(const ULONG* first, const ULONG* last)
+	{
+		const auto count = static_cast<size_t>(last - first);
+
+		reserve(m_size + count);
+		std::copy(first, last, data() + m_size);
+		m_size += count;
+	}
+
+	void assign(std::initializer_list<ULONG> values)
+	{
+		m_size = 0;
+		append(values.begin(), values.end());
+	}
+
+	void clear() noexcept
+	{
+		m_size = 0;
+	}
+
+private:
+	std::array<ULONG, InlineCapacity> m_inline {};
+	std::vector<ULONG> m_heap;
+	size_t m_size = 0;
+};
+
+} // namespace graphql::mapi
@@ -29,14 +29,30 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bitset>
+#include <filesystem>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <set>
+#include <span>
 #include <variant>
 
+#include "CanonicalEntryIdIndex.h"
 #include "CheckResult.h"
+#include "Cursor.h"
+#include "EntryIdIndex.h"
+#include "InstanceKeyColumn.h"
+#include "MissingIdCache.h"
+#include "ObjectCache.h"
+#include "ObjectWrapper.h"
+#include "TagBuffer.h"
 #include "Unicode.h"
+#include "include/RequestArena.h"
+#include "include/ServiceOptions.h"
 
 namespace graphql::mapi {
 
@@ -194,16 +210,49 @@ private:
 constexpr ULONG PR_CONVERSATION_ID = PROP_TAG(PT_BINARY,
 	0x3013); // https://docs.microsoft.com/en-us/openspecs/exchange_server_protocols/ms-oxprops/7fdd0560-5e41-4518-bfbb-0c5a6eb6be6c
 
+// Byte budgets for the folders and items which each Store caches between operations, and an
+// optional directory where each Store persists its named property mappings between processes. The
+// resolved columns of unchanged folders and items are only reused if fragmentBytes is not 0.
+struct CacheOptions
+{
+	size_t folderBytes = 0;
+	size_t itemBytes = 0;
+	std::filesystem::path namedPropDirectory;
+	size_t fragmentBytes = 0;
+	std::function<void(const CacheStats& stats)> cacheStats;
+};
+
+// How a cached window of rows was read with TableDirectives::enumerate. Notifications from the same
+// table can only be applied to the rows in place if the table still has the same view, and the
+// window starts at the beginning of the table, so every row before the window is known.
+struct TableWindow
+{
+	// TableHandle::version when the window was read.
+	size_t tableVersion = 0;
+
+	// Most rows the window can hold, or std::nullopt if it doesn't start at the beginning.
+	std::optional<size_t> limit;
+
+	// True if the window was full, so there may be more rows after it.
+	bool truncated = false;
+
+	// True if @select limited the columns, so the rows are not complete enough to cache.
+	bool projected = false;
+};
+
 // Forward declarations
 class Store;
 class Folder;
 class Item;
 class Property;
+class ItemEdge;
+class FolderEdge;
 
 class Query : public std::enable_shared_from_this<Query>
 {
 public:
-	explicit Query(const std::shared_ptr<Session>& session);
+	explicit Query(const std::shared_ptr<Session>& session, bool clearCaches,
+		const CacheOptions& cacheOptions);
 	~Query();
 
 	// Accessors used by other MAPIGraphQL classes
@@ -213,23 +262,40 @@ public:
 	// Clear cached folders and items in all stores.
 	void ClearCaches();
 
-	// Clear the folder and item caches at the end of the selection set.
+	// Clear cached folders and items in any store which can't keep them up to date with
+	// notifications, or in all stores if the service was created with clearCaches.
+	void ExpireCaches();
+
+	// Apply the notifications which each store queued since the last operation.
+	void ApplyNotifications();
+
+	// Pass the cache counters from every store to the cacheStats callback, if there is one.
+	void ReportCacheStats();
+
+	// Bring the folder and item caches up to date at the beginning of the selection set, and
+	// expire them at the end of the selection set.
+	void beginSelectionSet(const service::SelectionSetParams& params);
 	void endSelectionSet(const service::SelectionSetParams& params);
 
 	// Resolvers/Accessors which implement the GraphQL type
 	std::vector<std::shared_ptr<object::Store>> getStores(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
+	std::vector<std::shared_ptr<object::Item>> getItems(
+		service::FieldParams&& params, std::vector<ObjectId>&& folderIdsArg);
 
 private:
 	std::shared_ptr<Session> m_session;
+	const bool m_clearCaches;
+	const CacheOptions m_cacheOptions;
 
 	// These lazy load and cache results between calls to const methods.
 	void LoadStores(service::Directives&& fieldDirectives);
 
-	std::unique_ptr<std::map<response::IdType, size_t>> m_ids;
+	std::unique_ptr<EntryIdIndex<size_t>> m_ids;
 	std::unique_ptr<std::vector<std::shared_ptr<Store>>> m_stores;
 	CComPtr<AdviseSinkProxy<IMAPITable>> m_storeSink;
 	service::Directives m_storeDirectives;
+	std::vector<std::shared_ptr<object::Store>> m_storeObjects;
 };
 
 class Mutation
@@ -241,7 +307,9 @@ public:
 	// Accessors used by other MAPIGraphQL classes
 	bool CopyItems(MultipleItemsInput&& inputArg, ObjectId&& destinationArg, bool moveItems);
 
-	// Clear the folder and item caches at the end of the selection set.
+	// Apply any queued notifications at the beginning of the selection set, and clear the folder
+	// and item caches at the end of the selection set.
+	void beginSelectionSet(const service::SelectionSetParams& params);
 	void endSelectionSet(const service::SelectionSetParams& params);
 
 	// Resolvers/Accessors which implement the GraphQL type
@@ -307,8 +375,13 @@ private:
 		// We need to hold on to the table to perform reloads.
 		CComPtr<IMAPITable> table;
 
-		// Cache the window of rows to use for translating the table notifications.
+		// Cache the window of rows to use for translating the table notifications, with their
+		// instance keys in the same order.
 		std::vector<std::shared_ptr<Row>> rows;
+		InstanceKeyColumn keys;
+
+		// How the rows were read, to tell when a notification can't be applied in place.
+		TableWindow window;
 	};
 
 	// Track the registration of listeners for a given table and set of table directives.
@@ -333,15 +406,15 @@ private:
 
 	template <class T>
 	std::vector<std::shared_ptr<T>> LoadRows(const RegistrationKey& key,
-		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable) const;
+		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable, TableWindow& window) const;
 
 	// Specialized for Item and Folder
 	template <>
 	std::vector<std::shared_ptr<Item>> LoadRows<Item>(const RegistrationKey& key,
-		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable) const;
+		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable, TableWindow& window) const;
 	template <>
 	std::vector<std::shared_ptr<Folder>> LoadRows<Folder>(const RegistrationKey& key,
-		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable) const;
+		std::shared_ptr<Store>& store, CComPtr<IMAPITable>& spTable, TableWindow& window) const;
 
 	// Using std::multiset because there could be multiple subscriptions on the same
 	// ObjectId and table directives. In that case, they should all take a reference on
@@ -351,22 +424,275 @@ private:
 	mutable std::multiset<Registration<Folder>> m_rootFolderSinks;
 };
 
+// Estimate how much memory a row holds, including the variable length property values.
+size_t GetRowBytes(ULONG columnCount, const SPropValue* columns) noexcept;
+
+// Rows which @readAhead read past the end of the current window or page. A window is found by its
+// @offset, and a connection page by the cursor of the last row on the previous page.
+using PagePosition = std::variant<LONG, response::IdType>;
+
+struct ParkedRow
+{
+	ULONG columnCount = 0;
+	mapi_ptr<SPropValue> columns;
+	response::IdType cursor;
+};
+
+struct ParkedPage
+{
+	std::shared_ptr<const service::Directives> directives;
+	PagePosition position;
+	std::vector<ParkedRow> rows;
+	bool hasNextPage = false;
+	size_t bytes = 0;
+};
+
+// Default columns, sort order and @select field map for one kind of table. The tag arrays are laid
+// out like SizedSPropTagArray and SizedSSortOrderSet, so a constexpr TableSchema has static storage
+// which can be passed straight to MAPI without copying it into a MAPIAllocateBuffer allocation.
+template <class DefaultColumn, size_t SortCount, size_t FieldCount>
+class TableSchema
+{
+public:
+	static constexpr size_t ColumnCount = static_cast<size_t>(DefaultColumn::Count);
+
+	using FieldColumns = std::array<std::pair<std::string_view, DefaultColumn>, FieldCount>;
+
+	constexpr TableSchema(const std::array<ULONG, ColumnCount>& columns,
+		const std::array<SSortOrder, SortCount>& sorts, const FieldColumns& fields) noexcept
+		: m_columns {}
+		, m_sorts {}
+		, m_fields { fields }
+	{
+		m_columns.cValues = static_cast<ULONG>(ColumnCount);
+
+		for (size_t i = 0; i < ColumnCount; ++i)
+		{
+			m_columns.aulPropTag[i] = columns[i];
+		}
+
+		m_sorts.cSorts = static_cast<ULONG>(SortCount);
+
+		for (size_t i = 0; i < SortCount; ++i)
+		{
+			m_sorts.aSort[i] = sorts[i];
+		}
+	}
+
+	constexpr ULONG propType(DefaultColumn column) const noexcept
+	{
+		return PROP_TYPE(m_columns.aulPropTag[static_cast<size_t>(column)]);
+	}
+
+	constexpr const FieldColumns& fields() const noexcept
+	{
+		return m_fields;
+	}
+
+	const SPropTagArray& columns() const noexcept
+	{
+		return *reinterpret_cast<const SPropTagArray*>(&m_columns);
+	}
+
+	const SSortOrderSet& sorts() const noexcept
+	{
+		return *reinterpret_cast<const SSortOrderSet*>(&m_sorts);
+	}
+
+private:
+	SizedSPropTagArray(ColumnCount, m_columns);
+	SizedSSortOrderSet(SortCount, m_sorts);
+	FieldColumns m_fields;
+};
+
+// Open IMAPITable which remembers the columns, sort order and restriction last applied to it, so
+// reading from the same table again only calls SetColumns, SortTable or Restrict if they changed.
+class TableHandle
+{
+public:
+	explicit TableHandle(IMAPITable* pTable) noexcept;
+
+	IMAPITable* table() const noexcept;
+
+	void setColumns(const SPropTagArray& columns);
+	void sortTable(const SSortOrderSet* sorts);
+	void restrictTable(LPSRestriction restriction);
+
+	// Incremented every time the columns, sort order or restriction change, so rows which were read
+	// from the table can tell if table notifications still describe the same view.
+	size_t version() const noexcept;
+
+	// Keep a page which was read ahead, evicting the oldest pages to stay within the budget. Take
+	// it back out with the same directives and position, or discard all of them if the table
+	// changes.
+	void parkPage(ParkedPage&& page, size_t budget);
+	std::optional<ParkedPage> takePage(
+		const service::Directives& directives, const PagePosition& position);
+	void discardPages() noexcept;
+	size_t pageBytes() const noexcept;
+
+private:
+	const CComPtr<IMAPITable> m_table;
+	std::vector<ParkedPage> m_pages;
+	size_t m_pageBytes = 0;
+
+	// These are reset before each call to MAPI, so a failure forces the next call to try again.
+	std::optional<std::vector<ULONG>> m_columns;
+	std::optional<std::vector<ULONG>> m_sorts { std::vector<ULONG> {} };
+
+	// Flattened restriction keys, m_restrictionKnown is cleared the same way.
+	std::vector<std::uint8_t> m_restriction;
+	std::vector<std::uint8_t> m_nextRestriction;
+	bool m_restrictionKnown = true;
+	size_t m_version = 0;
+};
+
 class TableDirectives
 {
 public:
+	using RowCallback = std::function<void(SRow& row)>;
+	using CursorCallback = std::function<void(SRow& row, response::IdType&& cursor)>;
+	using MergeCallback = std::function<void(size_t source, SRow& row)>;
+
+	// Columns of each category heading row read by groups.
+	enum class HeadingColumn : size_t
+	{
+		InstanceKey,
+		ContentCount,
+		ContentUnread,
+		Category,
+		Count
+	};
+
 	explicit TableDirectives(
 		const std::shared_ptr<Store>& store, const service::Directives& fieldDirectives) noexcept;
 
-	rowset_ptr read(IMAPITable* pTable, mapi_ptr<SPropTagArray>&& defaultColumns,
-		mapi_ptr<SSortOrderSet>&& defaultOrder = {}) const;
+	rowset_ptr read(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder = nullptr) const;
+
+	// Hand each row to the callback. With @chunked, this keeps calling QueryRows on the same
+	// positioned table, so only one chunk of the SRowSet is held in memory at a time. The callback
+	// may take ownership of SRow::lpProps by setting it to nullptr.
+	void enumerate(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder, const RowCallback& callback) const;
+
+	// Read one page of a connection, starting after the row in a cursor from a previous page. The
+	// instance key and sort columns are appended to build each cursor, and trimmed from
+	// SRow::cValues again before the callback. The table is also sorted by the instance key last, so
+	// the page can start strictly after the cursor row even if it was removed. Returns true if there
+	// are more rows after the page.
+	bool paginate(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder, std::optional<response::IdType>&& after,
+		const CursorCallback& callback) const;
+
+	// Read the rows from the beginning of the table which could end up in the @offset and @take
+	// window after merging it with other tables. The sort columns are appended to each row, so
+	// they can be compared with the rows from the other tables in merge.
+	rowset_ptr readHead(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder) const;
+
+	// Merge the rows from readHead on several tables with a k-way merge on the sort columns, and
+	// hand each row in the @offset and @take window to the callback with the index of its source.
+	// The sort columns are trimmed from SRow::cValues again before the callback.
+	void merge(std::vector<rowset_ptr>& sources, const SSortOrderSet* defaultOrder,
+		const MergeCallback& callback) const;
+
+	// Read the category headings in the @offset and @take window, with the table sorted by the
+	// @groupBy property and then by @orderBy or the default order. Every category stays collapsed,
+	// so this only reads the heading rows, and MAPI counts the items in each category.
+	void groups(
+		TableHandle& table, const SSortOrderSet* defaultOrder, const RowCallback& callback) const;
+
+	// Expand a single category heading from groups, and hand each of the item rows in the @offset
+	// and @take window from the item directives to the callback. The category is collapsed again
+	// before any of the rows are handed to the callback.
+	void expand(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder, const response::IdType& instanceKey,
+		const TableDirectives& itemDirectives, const RowCallback& callback) const;
+
+	// Count the rows which match the @where restriction, without reading any of them. This replaces
+	// any restriction from a previous call to paginate.
+	ULONG count(TableHandle& table) const;
+
+	// True if @select limited the default columns, so the rows are not complete enough to cache.
+	bool projected() const noexcept;
+
+	// True if @chunked streams the rows to the callback, so they should not be kept in a cached
+	// window either, or the memory would still grow with the size of the table.
+	bool streamed() const noexcept;
+
+	// The @groupBy, @orderBy and @where directives, which select the categorized view that groups
+	// and expand apply to the table. Empty without @groupBy.
+	const service::Directives& viewKey() const noexcept;
+
+	// Describe the window which enumerate reads from the table, so notifications can be applied to
+	// it later. Call this after enumerate with the number of rows it handed to the callback.
+	TableWindow window(const TableHandle& table, size_t rowCount) const;
+
+	// Copy the default columns to the buffer, replacing any which only back fields missing from
+	// @select with PR_NULL. The column positions stay the same, so the rows can still be decoded by
+	// DefaultColumn index. Without @select, this returns the static schema columns as-is.
+	template <class DefaultColumn, size_t SortCount, size_t FieldCount>
+	const SPropTagArray& select(const TableSchema<DefaultColumn, SortCount, FieldCount>& schema,
+		TagBuffer& buffer) const
+	{
+		const auto& defaultColumns = schema.columns();
+
+		if (!m_select)
+		{
+			return defaultColumns;
+		}
+
+		buffer.assign({ defaultColumns.cValues });
+		buffer.append(defaultColumns.aulPropTag, defaultColumns.aulPropTag + defaultColumns.cValues);
+
+		// Columns which are not mapped to any field are always read.
+		std::bitset<TableSchema<DefaultColumn, SortCount, FieldCount>::ColumnCount> needed;
+
+		needed.set();
+
+		for (const auto& [field, column] : schema.fields())
+		{
+			needed[static_cast<size_t>(column)] = false;
+		}
+
+		for (const auto& [field, column] : schema.fields())
+		{
+			if (std::find(m_select->cbegin(), m_select->cend(), field) != m_select->cend())
+			{
+				needed[static_cast<size_t>(column)] = true;
+			}
+		}
+
+		for (size_t i = 0; i < needed.size(); ++i)
+		{
+			if (!needed[i])
+			{
+				buffer[1 + i] = PR_NULL;
+			}
+		}
+
+		return *reinterpret_cast<const SPropTagArray*>(buffer.data());
+	}
 
 private:
-	mapi_ptr<SPropTagArray> columns(mapi_ptr<SPropTagArray>&& defaultColumns) const;
-	mapi_ptr<SSortOrderSet> orderBy(mapi_ptr<SSortOrderSet>&& defaultOrder) const;
+	void position(TableHandle& table, const SPropTagArray& defaultColumns,
+		const SSortOrderSet* defaultOrder) const;
+	const SPropTagArray& columns(const SPropTagArray& defaultColumns, TagBuffer& buffer) const;
+	const SSortOrderSet* orderBy(const SSortOrderSet* defaultOrder, TagBuffer& buffer) const;
+	const SSortOrderSet* groupBy(const SSortOrderSet* defaultOrder, TagBuffer& buffer) const;
+	mapi_ptr<SRestriction> where() const;
+	static mapi_ptr<SRestriction> resumeAfter(
+		const convert::cursor::Boundary& boundary, const SSortOrderSet* sorts);
 	mapi_ptr<SRestriction> seek() const;
 	BOOKMARK seekBookmark() const;
 	LONG offset() const;
 	LONG take() const;
+	size_t chunked() const;
+	size_t readAhead() const;
+	size_t readAheadBudget() const;
+	void parkPage(TableHandle& table, PagePosition&& position, std::vector<ParkedRow>&& rows,
+		bool hasNextPage) const;
 
 	const std::shared_ptr<Store> m_store;
 	const std::optional<std::vector<Column>> m_columns;
@@ -374,6 +700,14 @@ private:
 	const std::optional<std::optional<response::IdType>> m_seek;
 	const std::optional<int> m_offset;
 	const std::optional<int> m_take;
+	const std::optional<std::vector<std::string>> m_select;
+	const std::optional<int> m_chunked;
+	const std::optional<Restriction> m_where;
+	const std::optional<int> m_readAhead;
+	const std::optional<std::optional<int>> m_readAheadBudget;
+	const std::optional<Order> m_groupBy;
+	const std::shared_ptr<const service::Directives> m_pageKey;
+	const service::Directives m_viewKey;
 };
 
 struct CompareMAPINAMEID
@@ -384,11 +718,80 @@ struct CompareMAPINAMEID
 
 using NameIdToPropId = std::map<mapi_ptr<MAPINAMEID>, ULONG, CompareMAPINAMEID>;
 
+// File which persists the named property mappings resolved in a store, so the next process can skip
+// GetIDsFromNames and GetNamesFromIDs for the same names. The file is mapped when the Store is
+// created, and only parsed the first time the Store looks up a named property.
+class NamedPropCache
+{
+public:
+	explicit NamedPropCache(const std::filesystem::path& directory, const response::IdType& storeId);
+	~NamedPropCache();
+
+	// Parse the mappings from the file, then release it so it can be replaced. The signature
+	// identifies the store's named property mappings, e.g. PR_MAPPING_SIGNATURE, and it's saved
+	// with the file. Returns an empty map if the file is missing, belongs to another store or
+	// signature, or can't be parsed.
+	NameIdToPropId load(const response::IdType& signature);
+
+	// Only the first call to load reads the file.
+	bool loaded() const noexcept;
+
+	// Serialize the mappings with the signature from load and replace the file in the background.
+	// This doesn't wait for an earlier write, if several saves happen while the file is being
+	// written, only the last of them is written next.
+	void save(const NameIdToPropId& nameIdToPropIds);
+
+private:
+	void close() noexcept;
+
+	const std::filesystem::path m_path;
+	const response::IdType m_storeId;
+	std::optional<response::IdType> m_signature;
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+	const std::uint8_t* m_view = nullptr;
+	size_t m_size = 0;
+
+	// The writer thread takes the next buffer to write from m_pendingBuffer until it's empty, and
+	// clears m_writing under the same lock before it exits.
+	std::mutex m_pendingMutex;
+	std::optional<std::vector<std::uint8_t>> m_pendingBuffer;
+	bool m_writing = false;
+	std::future<void> m_writer;
+};
+
+// The resolved columns of a folder or item row, which can be reused for the same row until the
+// object changes. The key combines the entry ID, a change stamp, the column tags, and a hash of
+// the column values. The hash is what keeps a cached fragment fresh, since some values change
+// without a new change stamp. After a change, the row has a new key and the old fragment is
+// evicted once it's the least recently used.
+class ColumnFragment
+{
+public:
+	explicit ColumnFragment(response::IdType&& key, size_t bytes,
+		std::vector<std::shared_ptr<object::Property>>&& columns) noexcept;
+
+	// The change stamp is PR_CHANGE_KEY if the row has it, otherwise PR_LAST_MODIFICATION_TIME. It
+	// may be in any of the columns, but only the tags and values after offset are part of the key.
+	// Returns std::nullopt if the row has neither of them.
+	static std::optional<response::IdType> MakeKey(const response::IdType& id, size_t columnCount,
+		const SPropValue* columns, size_t offset);
+
+	const response::IdType& id() const noexcept;
+	size_t bytes() const noexcept;
+	const std::vector<std::shared_ptr<object::Property>>& columns() const noexcept;
+
+private:
+	const response::IdType m_key;
+	const size_t m_bytes;
+	const std::vector<std::shared_ptr<object::Property>> m_columns;
+};
+
 class Store : public std::enable_shared_from_this<Store>
 {
 public:
-	explicit Store(
-		const CComPtr<IMAPISession>& session, size_t columnCount, mapi_ptr<SPropValue>&& columns);
+	explicit Store(const CComPtr<IMAPISession>& session, const CacheOptions& cacheOptions,
+		size_t columnCount, mapi_ptr<SPropValue>&& columns);
 	~Store();
 
 	// Accessors used by other MAPIGraphQL classes
@@ -399,21 +802,11 @@ public:
 		Count
 	};
 
-	static constexpr std::array<ULONG, static_cast<size_t>(DefaultColumn::Count)> GetStoreColumns()
-	{
-		constexpr std::array storeProps {
-			PR_ENTRYID,
-			PR_DISPLAY_NAME_W,
-		};
+	using Schema = TableSchema<DefaultColumn, 1, 0>;
 
-		return storeProps;
-	};
-
-	static constexpr std::array<SSortOrder, 1> GetStoreSorts()
-	{
-		return { SSortOrder { PR_DISPLAY_NAME_W, TABLE_SORT_ASCEND } };
-	}
+	static const Schema& GetStoreSchema() noexcept;
 
+	std::shared_ptr<object::Store> object();
 	const CComPtr<IMsgStore>& store();
 	const response::IdType& id() const;
 	const response::IdType& rootId() const;
@@ -421,43 +814,92 @@ public:
 	std::shared_ptr<Folder> lookupRootFolder(const response::IdType& id);
 	const std::map<SpecialFolder, response::IdType>& specialFolders();
 	std::shared_ptr<Folder> lookupSpecialFolder(SpecialFolder id);
-	std::vector<std::pair<ULONG, LPMAPINAMEID>> lookupPropIdInputs(
-		std::vector<PropIdInput>&& namedProps);
-	std::vector<std::pair<ULONG, LPMAPINAMEID>> lookupPropIds(const std::vector<ULONG>& propIds);
-
-	// Utility methods which help with converting between input types and MAPI types
-	std::vector<std::shared_ptr<object::Property>> GetColumns(
-		size_t columnCount, const LPSPropValue columns);
-	std::vector<std::shared_ptr<object::Property>> GetProperties(
-		IMAPIProp* pObject, std::optional<std::vector<Column>>&& idsArg);
+	std::optional<SpecialFolder> classifySpecialFolder(const response::IdType& folderId);
+
+	// Look up folders under the IPM subtree in a snapshot of the whole hierarchy, which is read from
+	// a single CONVENIENT_DEPTH hierarchy table the first time it's needed. lookupHierarchyChild
+	// only returns the folder if it's a child of parentFolder, or a root folder if that's nullptr.
+	// lookupHierarchyChildren returns the children of a folder in the default PR_DISPLAY_NAME_W
+	// order, or std::nullopt if the folder isn't in the snapshot.
+	std::shared_ptr<Folder> lookupHierarchyChild(
+		const std::shared_ptr<Folder>& parentFolder, const response::IdType& id);
+	std::optional<std::vector<std::shared_ptr<Folder>>> lookupHierarchyChildren(
+		const Folder& parentFolder);
+
+	// The results and any temporary lists in these lookups are allocated from the arena.
+	std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> lookupPropIdInputs(
+		std::span<const PropIdInput> namedProps,
+		std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+	std::pmr::vector<std::pair<ULONG, LPMAPINAMEID>> lookupPropIds(std::span<const ULONG> propIds,
+		std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+	// Utility methods which help with converting between input types and MAPI types, their
+	// temporary containers are allocated from arena.
+	std::vector<std::shared_ptr<object::Property>> GetColumns(size_t columnCount,
+		const LPSPropValue columns,
+		std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+	// Like GetColumns for the columns after offset, but if the fragment cache is enabled, this
+	// reuses the result for the same entry ID, change stamp, and column tags.
+	std::vector<std::shared_ptr<object::Property>> GetColumnFragment(const response::IdType& id,
+		size_t columnCount, const LPSPropValue columns, size_t offset,
+		std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+	std::vector<std::shared_ptr<object::Property>> GetProperties(IMAPIProp* pObject,
+		std::optional<std::vector<Column>>&& idsArg,
+		std::pmr::memory_resource* arena = std::pmr::get_default_resource());
 	void ConvertPropertyInputs(void* pAllocMore, LPSPropValue propBegin, LPSPropValue propEnd,
 		std::vector<PropertyInput>&& input);
 
-	// Open and cache folders and items
+	// Open and cache folders and items, these return nullptr if the entry ID is known to be missing
 	std::shared_ptr<Folder> OpenFolder(const response::IdType& folderId);
 	std::shared_ptr<Item> OpenItem(const response::IdType& itemId);
 	void CacheFolder(const std::shared_ptr<Folder>& folder);
 	void CacheItem(const std::shared_ptr<Item>& item);
 	void ClearCaches();
 
+	// Clear the caches at the end of an operation, unless store notifications keep them up to date.
+	void ExpireCaches();
+
+	// Notifications arrive on a MAPI thread, but the caches and cached windows they update are only
+	// safe to change between resolvers. The sinks queue a copy of each batch with the callback to
+	// handle it, and ApplyNotifications runs the callbacks in order at the start of an operation.
+	using NotificationCallback =
+		std::function<void(Store& store, size_t count, LPNOTIFICATION notifications)>;
+
+	void QueueNotifications(
+		size_t count, LPNOTIFICATION notifications, NotificationCallback&& callback);
+	void ApplyNotifications();
+
+	// Remember to measure a cached folder or item again after it grows. Resolvers on several
+	// threads may call these, so the caches only measure them again between operations.
+	void UpdateCachedFolder(const Folder& folder);
+	void UpdateCachedItem(const Item& item);
+
+	// Add the hit, miss, and eviction counters from each of the caches to the totals.
+	void AddCacheStats(CacheStats& stats);
+
 	// Resolvers/Accessors which implement the GraphQL type
 	const response::IdType& getId() const;
 	const std::string& getName() const;
-	std::vector<std::shared_ptr<object::Property>> getColumns();
+	std::vector<std::shared_ptr<object::Property>> getColumns(service::FieldParams&& params);
 	std::vector<std::shared_ptr<object::Folder>> getRootFolders(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
+	std::shared_ptr<object::FolderConnection> getRootFoldersConnection(
+		service::FieldParams&& params, std::optional<response::IdType>&& afterArg);
 	std::vector<std::shared_ptr<object::Folder>> getSpecialFolders(
 		std::vector<SpecialFolder>&& idsArg);
-	std::vector<std::shared_ptr<object::Property>> getFolderProperties(
+	std::vector<std::shared_ptr<object::Property>> getFolderProperties(service::FieldParams&& params,
 		response::IdType&& folderIdArg, std::optional<std::vector<Column>>&& idsArg);
-	std::vector<std::shared_ptr<object::Property>> getItemProperties(
+	std::vector<std::shared_ptr<object::Property>> getItemProperties(service::FieldParams&& params,
 		response::IdType&& itemIdArg, std::optional<std::vector<Column>>&& idsArg);
 
 private:
-	// Used during construction
+	// Used during construction, each of these checks the column type in the schema at compile time.
 	const SPropValue& GetColumnProp(DefaultColumn column) const;
-	response::IdType GetIdColumn(DefaultColumn column) const;
-	std::string GetStringColumn(DefaultColumn column) const;
+	template <DefaultColumn Column>
+	response::IdType GetIdColumn() const;
+	template <DefaultColumn Column>
+	std::string GetStringColumn() const;
 
 	// These are all initialized at construction.
 	const CComPtr<IMAPISession> m_session;
@@ -466,18 +908,49 @@ private:
 	const response::IdType m_id;
 	const std::string m_name;
 
+	// A folder in the hierarchy snapshot, with the index of its parent folder and its children in
+	// the same snapshot. Root folders have no parent index, their parent is the IPM subtree.
+	struct HierarchyNode
+	{
+		std::shared_ptr<Folder> folder;
+		std::optional<size_t> parent;
+		std::vector<size_t> children;
+	};
+
+	struct QueuedNotifications
+	{
+		NotificationCallback callback;
+		size_t count = 0;
+		mapi_ptr<NOTIFICATION> notifications;
+	};
+
 	// These lazy load and cache results between calls to const methods.
 	void OpenStore();
+	void AdviseCaches();
+	void InvalidateCaches(size_t count, LPNOTIFICATION notifications);
 	void LoadSpecialFolders();
+	TableHandle& hierarchyTable();
+	void LoadHierarchy();
+	void ApplyHierarchyNotifications(size_t count, LPNOTIFICATION pNotifications);
+	TableHandle& rootFolderTable();
 	void LoadRootFolders(service::Directives&& fieldDirectives);
-	mapi_ptr<SPropTagArray> GetFolderProperties() const;
-	mapi_ptr<SPropTagArray> GetItemProperties() const;
+	bool LoadRootFoldersPage(const TableDirectives& directives,
+		std::optional<response::IdType>&& after, std::vector<std::shared_ptr<FolderEdge>>& edges);
 
 	// Utility methods to populate our cached special folder IDs from multiple properties on the
 	// store and folders.
 	static void FillInStoreProps(LPSPropValue storeIds, std::map<SpecialFolder, SBinary>& idMap);
 	static void FillInFolderProps(LPSPropValue folderIds, std::map<SpecialFolder, SBinary>& idMap);
 
+	// Merge the mappings from the named property cache file the first time we need them, and save
+	// them again after resolving any new names.
+	void LoadNamedPropCache();
+	void SaveNamedPropCache();
+
+	// Measure the folders and items which grew since the last operation, and evict others until
+	// the caches fit in their budgets again.
+	void MeasureCachedObjects();
+
 	CComPtr<IMsgStore> m_store;
 	response::IdType m_rootId;
 	CComPtr<IMAPIFolder> m_ipmSubtree;
@@ -486,14 +959,34 @@ private:
 	mapi_ptr<SPropValue> m_inboxProps;
 	ULONG m_cbInboxId = 0;
 	mapi_ptr<ENTRYID> m_eidInboxId;
+	std::unique_ptr<std::vector<HierarchyNode>> m_hierarchy;
+	std::unique_ptr<EntryIdIndex<size_t>> m_hierarchyIds;
+	std::vector<size_t> m_hierarchyRoots;
+	std::unique_ptr<TableHandle> m_hierarchyTable;
+	CComPtr<AdviseSinkProxy<IMAPITable>> m_hierarchySink;
 	std::unique_ptr<std::vector<std::shared_ptr<Folder>>> m_rootFolders;
-	std::unique_ptr<std::map<response::IdType, size_t>> m_rootFolderIds;
+	std::unique_ptr<EntryIdIndex<size_t>> m_rootFolderIds;
+	std::unique_ptr<TableHandle> m_rootFolderTable;
 	CComPtr<AdviseSinkProxy<IMAPITable>> m_rootFolderSink;
 	service::Directives m_rootFolderDirectives;
+	std::vector<std::shared_ptr<object::Folder>> m_rootFolderObjects;
 	std::unique_ptr<std::map<SpecialFolder, response::IdType>> m_specialFolders;
+	std::unique_ptr<CanonicalEntryIdIndex<SpecialFolder>> m_specialFolderIds;
 	NameIdToPropId m_nameIdToPropIds;
-	std::map<response::IdType, std::shared_ptr<Folder>> m_folderCache;
-	std::map<response::IdType, std::shared_ptr<Item>> m_itemCache;
+	std::unique_ptr<NamedPropCache> m_namedPropCache;
+	// Resolvers on several threads share the caches, so every access holds m_cacheMutex.
+	std::mutex m_cacheMutex;
+	ObjectCache<Folder> m_folderCache;
+	ObjectCache<Item> m_itemCache;
+	ObjectCache<ColumnFragment> m_fragmentCache;
+	std::vector<std::weak_ptr<const Folder>> m_resizedFolders;
+	std::vector<std::weak_ptr<const Item>> m_resizedItems;
+	MissingIdCache m_missingIds;
+	CComPtr<AdviseSinkProxy<IMsgStore>> m_cacheSink;
+	std::mutex m_notificationMutex;
+	std::vector<QueuedNotifications> m_notifications;
+	bool m_notificationsOverflowed = false;
+	WrapperCache<object::Store> m_object;
 };
 
 class Folder : public std::enable_shared_from_this<Folder>
@@ -515,31 +1008,20 @@ public:
 		Count
 	};
 
-	static constexpr std::array<ULONG, static_cast<size_t>(DefaultColumn::Count)> GetFolderColumns()
-	{
-		constexpr std::array folderProps {
-			PR_INSTANCE_KEY,
-			PR_ENTRYID,
-			PR_PARENT_ENTRYID,
-			PR_DISPLAY_NAME_W,
-			PR_CONTENT_COUNT,
-			PR_CONTENT_UNREAD,
-		};
-
-		return folderProps;
-	};
+	using Schema = TableSchema<DefaultColumn, 1, 3>;
 
-	static constexpr std::array<SSortOrder, 1> GetFolderSorts()
-	{
-		return { SSortOrder { PR_DISPLAY_NAME_W, TABLE_SORT_ASCEND } };
-	}
+	static const Schema& GetFolderSchema() noexcept;
 
 	const response::IdType& instanceKey() const;
 	const response::IdType& id() const;
+	const response::IdType& parentId() const;
 	const std::string& name() const;
 	int count() const;
 	int unread() const;
+	size_t bytes() const noexcept;
+	std::shared_ptr<object::Folder> object();
 	const CComPtr<IMAPIFolder>& folder();
+	TableHandle& itemTable();
 	const std::vector<std::shared_ptr<Folder>>& subFolders();
 	std::shared_ptr<Folder> parentFolder() const;
 	std::shared_ptr<Folder> lookupSubFolder(const response::IdType& id);
@@ -554,20 +1036,31 @@ public:
 	int getCount() const;
 	int getUnread() const;
 	std::optional<SpecialFolder> getSpecialFolder() const;
-	std::vector<std::shared_ptr<object::Property>> getColumns() const;
+	std::vector<std::shared_ptr<object::Property>> getColumns(service::FieldParams&& params) const;
 	std::vector<std::shared_ptr<object::Folder>> getSubFolders(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
+	std::shared_ptr<object::FolderConnection> getSubFoldersConnection(
+		service::FieldParams&& params, std::optional<response::IdType>&& afterArg);
 	std::vector<std::shared_ptr<object::Conversation>> getConversations(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
 	std::vector<std::shared_ptr<object::Item>> getItems(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
+	std::shared_ptr<object::ItemConnection> getItemsConnection(
+		service::FieldParams&& params, std::optional<response::IdType>&& afterArg);
+	std::vector<std::shared_ptr<object::ItemGroup>> getItemGroups(
+		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg);
 
 private:
-	// Used during construction
+	// Used during construction or on first access, each of these checks the column type in the
+	// schema at compile time.
 	const SPropValue& GetColumnProp(DefaultColumn column) const;
-	response::IdType GetIdColumn(DefaultColumn column) const;
-	std::string GetStringColumn(DefaultColumn column) const;
-	int GetIntColumn(DefaultColumn column) const;
+	template <DefaultColumn Column>
+	response::IdType GetIdColumn() const;
+	template <DefaultColumn Column>
+	const std::optional<std::string>& GetStringColumn(
+		std::once_flag& once, std::optional<std::string>& decoded) const;
+	template <DefaultColumn Column>
+	int GetIntColumn() const;
 
 	// These are all initialized at construction.
 	const std::weak_ptr<Store> m_store;
@@ -576,25 +1069,74 @@ private:
 	const response::IdType m_instanceKey;
 	const response::IdType m_id;
 	const response::IdType m_parentId;
-	const std::string m_name;
 	const int m_count;
 	const int m_unread;
-	const std::optional<SpecialFolder> m_specialFolder;
+
+	// The name is only converted to UTF-8 from the column the first time it's accessed, which may
+	// happen on several resolver threads at once.
+	mutable std::once_flag m_nameOnce;
+	mutable std::optional<std::string> m_name;
+	mutable std::atomic<size_t> m_decodedBytes { 0 };
+
+	// The folder grows as it loads windows, parks pages, or decodes the name, so each of those asks
+	// the store to measure it again if it's in the store's folder cache.
+	size_t columnBytes() const noexcept;
+	void UpdateCachedBytes() const;
 
 	// These lazy load and cache results between calls to const methods.
 	void OpenFolder();
+	TableHandle& subFolderTable();
 	void LoadSubFolders(service::Directives&& fieldDirectives);
 	void LoadItems(service::Directives&& fieldDirectives);
+	bool LoadSubFoldersPage(const TableDirectives& directives,
+		std::optional<response::IdType>&& after, std::vector<std::shared_ptr<FolderEdge>>& edges);
+	bool LoadItemsPage(const TableDirectives& directives, std::optional<response::IdType>&& after,
+		std::vector<std::shared_ptr<ItemEdge>>& edges);
+	std::shared_ptr<TableHandle> groupTable(const TableDirectives& directives);
+	std::vector<std::shared_ptr<Item>> LoadGroupItems(TableHandle& table,
+		const TableDirectives& directives, const response::IdType& instanceKey,
+		const service::Directives& fieldDirectives);
+
+	// Apply fnevTableModified notifications to the cached subFolders or items in place, or reset
+	// them so they're read again the next time they're needed.
+	void ApplySubFolderNotifications(size_t count, LPNOTIFICATION pNotifications);
+	void ApplyItemNotifications(size_t count, LPNOTIFICATION pNotifications);
+	template <class T>
+	static bool ApplyTableNotifications(const std::shared_ptr<Store>& store, TableWindow& window,
+		std::vector<std::shared_ptr<T>>& rows, InstanceKeyColumn& keys, size_t count,
+		LPNOTIFICATION pNotifications, void (Store::*cacheRow)(const std::shared_ptr<T>&));
+	template <class T>
+	static std::unique_ptr<EntryIdIndex<size_t>> IndexRows(
+		const std::vector<std::shared_ptr<T>>& rows);
+
+	// With @chunked, wrap each row as it's read instead of keeping it in the cached window or the
+	// store caches, so the rows are released along with the result. With ids, the result has the
+	// same order as the IDs, and nullptr for any IDs which were not found.
+	template <class T>
+	static auto StreamRows(const std::shared_ptr<Store>& store, TableHandle& table,
+		const typename T::Schema& schema, const TableDirectives& directives,
+		const std::optional<std::vector<response::IdType>>& ids)
+		-> std::vector<decltype(std::declval<T&>().object())>;
 
 	CComPtr<IMAPIFolder> m_folder;
-	std::unique_ptr<std::map<response::IdType, size_t>> m_subFolderIds;
+	std::unique_ptr<EntryIdIndex<size_t>> m_subFolderIds;
 	std::unique_ptr<std::vector<std::shared_ptr<Folder>>> m_subFolders;
+	std::unique_ptr<TableHandle> m_subFolderTable;
 	CComPtr<AdviseSinkProxy<IMAPITable>> m_subFolderSink;
 	service::Directives m_subFolderDirectives;
-	std::unique_ptr<std::map<response::IdType, size_t>> m_itemIds;
+	TableWindow m_subFolderWindow;
+	InstanceKeyColumn m_subFolderKeys;
+	std::vector<std::shared_ptr<object::Folder>> m_subFolderObjects;
+	std::unique_ptr<EntryIdIndex<size_t>> m_itemIds;
 	std::unique_ptr<std::vector<std::shared_ptr<Item>>> m_items;
+	std::unique_ptr<TableHandle> m_itemTable;
 	CComPtr<AdviseSinkProxy<IMAPITable>> m_itemSink;
 	service::Directives m_itemDirectives;
+	TableWindow m_itemWindow;
+	InstanceKeyColumn m_itemKeys;
+	std::vector<std::shared_ptr<object::Item>> m_itemObjects;
+	std::vector<std::pair<service::Directives, std::shared_ptr<TableHandle>>> m_groupTables;
+	WrapperCache<object::Folder> m_object;
 };
 
 class Item : public std::enable_shared_from_this<Item>
@@ -620,27 +1162,9 @@ public:
 		Count
 	};
 
-	static constexpr std::array<ULONG, static_cast<size_t>(DefaultColumn::Count)> GetItemColumns()
-	{
-		return {
-			PR_INSTANCE_KEY,
-			PR_ENTRYID,
-			PR_PARENT_ENTRYID,
-			PR_SUBJECT_W,
-			PR_SENDER_NAME_W,
-			PR_DISPLAY_TO_W,
-			PR_DISPLAY_CC_W,
-			PR_MESSAGE_FLAGS,
-			PR_MESSAGE_DELIVERY_TIME,
-			PR_LAST_MODIFICATION_TIME,
-			PR_BODY_W,
-		};
-	};
+	using Schema = TableSchema<DefaultColumn, 1, 8>;
 
-	static constexpr std::array<SSortOrder, 1> GetItemSorts()
-	{
-		return { SSortOrder { PR_MESSAGE_DELIVERY_TIME, TABLE_SORT_DESCEND } };
-	}
+	static const Schema& GetItemSchema() noexcept;
 
 	const response::IdType& instanceKey() const;
 	const response::IdType& id() const;
@@ -652,6 +1176,8 @@ public:
 	const FILETIME& received() const;
 	const FILETIME& modified() const;
 	const std::optional<std::string>& preview() const;
+	size_t bytes() const noexcept;
+	std::shared_ptr<object::Item> object();
 	const CComPtr<IMessage>& message();
 
 	// Resolvers/Accessors which implement the GraphQL type
@@ -667,17 +1193,23 @@ public:
 	std::optional<response::Value> getReceived() const;
 	std::optional<response::Value> getModified() const;
 	std::optional<std::string> getPreview() const;
-	std::vector<std::shared_ptr<object::Property>> getColumns() const;
+	std::vector<std::shared_ptr<object::Property>> getColumns(service::FieldParams&& params) const;
 	std::vector<std::shared_ptr<object::Attachment>> getAttachments(
 		service::FieldParams&& params, std::optional<std::vector<response::IdType>>&& idsArg) const;
 
 private:
-	// Used during construction
+	// Used during construction or on first access, each of these checks the column type in the
+	// schema at compile time.
 	const SPropValue& GetColumnProp(DefaultColumn column) const;
-	response::IdType GetIdColumn(DefaultColumn column) const;
-	std::string GetStringColumn(DefaultColumn column) const;
-	bool GetReadColumn(DefaultColumn column) const;
-	FILETIME GetTimeColumn(DefaultColumn column) const;
+	template <DefaultColumn Column>
+	response::IdType GetIdColumn() const;
+	template <DefaultColumn Column>
+	const std::optional<std::string>& GetStringColumn(
+		std::once_flag& once, std::optional<std::string>& decoded) const;
+	template <DefaultColumn Column>
+	bool GetReadColumn() const;
+	template <DefaultColumn Column>
+	FILETIME GetTimeColumn() const;
 
 	// These are all initialized at construction.
 	const std::weak_ptr<Store> m_store;
@@ -686,19 +1218,33 @@ private:
 	const response::IdType m_instanceKey;
 	const response::IdType m_id;
 	const response::IdType m_parentId;
-	const std::string m_subject;
-	const std::optional<std::string> m_sender;
-	const std::optional<std::string> m_to;
-	const std::optional<std::string> m_cc;
 	const bool m_read;
 	const FILETIME m_received;
 	const FILETIME m_modified;
-	const std::optional<std::string> m_preview;
+
+	// The string columns are only converted to UTF-8 the first time each of them is accessed, so
+	// the columns which are never selected are never decoded. Several resolver threads may access
+	// them at once, so each of them is guarded by its own std::once_flag.
+	mutable std::once_flag m_subjectOnce;
+	mutable std::optional<std::string> m_subject;
+	mutable std::once_flag m_senderOnce;
+	mutable std::optional<std::string> m_sender;
+	mutable std::once_flag m_toOnce;
+	mutable std::optional<std::string> m_to;
+	mutable std::once_flag m_ccOnce;
+	mutable std::optional<std::string> m_cc;
+	mutable std::once_flag m_previewOnce;
+	mutable std::optional<std::string> m_preview;
+
+	// Total capacity of the decoded strings, which bytes() can read while another thread is still
+	// decoding a different column.
+	mutable std::atomic<size_t> m_decodedBytes { 0 };
 
 	// These lazy load and cache results between calls to const methods.
 	void OpenItem();
 
 	CComPtr<IMessage> m_message;
+	WrapperCache<object::Item> m_object;
 };
 
 class Property
@@ -706,15 +1252,24 @@ class Property
 public:
 	using id_variant = std::variant<ULONG, MAPINAMEID>;
 
-	explicit Property(const id_variant& id, mapi_ptr<SPropValue>&& value);
+	explicit Property(const id_variant& id, std::shared_ptr<const SPropValue>&& value);
 
 	// Resolvers/Accessors which implement the GraphQL type
 	std::shared_ptr<object::PropId> getId() const;
 	std::shared_ptr<object::PropValue> getValue() const;
 
 private:
+	static std::shared_ptr<object::PropValue> MakeValue(const SPropValue& value);
+
 	const std::shared_ptr<object::PropId> m_id;
-	const mapi_ptr<SPropValue> m_value;
+
+	// This points into a buffer which is shared by all of the properties from the same object.
+	const std::shared_ptr<const SPropValue> m_value;
+
+	// Cached fragments resolve the same Property many times, so the value wrapper is only built
+	// the first time it's resolved.
+	mutable std::once_flag m_valueOnce;
+	mutable std::shared_ptr<object::PropValue> m_propValue;
 };
 
 class IntId
@@ -988,4 +1543,130 @@ private:
 	std::vector<std::shared_ptr<object::FolderChange>> m_rootFolders;
 };
 
+class PageInfo
+{
+public:
+	explicit PageInfo(bool hasNextPage, std::optional<response::IdType>&& endCursor);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	bool getHasNextPage() const;
+	const std::optional<response::IdType>& getEndCursor() const;
+
+private:
+	const bool m_hasNextPage;
+	const std::optional<response::IdType> m_endCursor;
+};
+
+class ItemEdge
+{
+public:
+	explicit ItemEdge(const std::shared_ptr<Item>& node, response::IdType&& cursor);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	const response::IdType& getCursor() const;
+	std::shared_ptr<object::Item> getNode() const;
+
+private:
+	const std::shared_ptr<Item> m_node;
+	const response::IdType m_cursor;
+};
+
+class ItemConnection
+{
+public:
+	using CountLoader = std::function<int()>;
+	using PageLoader = std::function<bool(std::vector<std::shared_ptr<ItemEdge>>& edges)>;
+
+	explicit ItemConnection(CountLoader&& loadCount, PageLoader&& loadPage);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	std::vector<std::shared_ptr<object::ItemEdge>> getEdges();
+	std::shared_ptr<object::PageInfo> getPageInfo();
+	int getTotalCount();
+
+private:
+	// These are all initialized at construction.
+	const CountLoader m_loadCount;
+	const PageLoader m_loadPage;
+
+	// These lazy load and cache results between calls to the resolvers, so selecting only the
+	// totalCount never reads any rows.
+	void LoadPage();
+
+	std::optional<int> m_totalCount;
+	std::unique_ptr<std::vector<std::shared_ptr<ItemEdge>>> m_edges;
+	std::shared_ptr<PageInfo> m_pageInfo;
+};
+
+class FolderEdge
+{
+public:
+	explicit FolderEdge(const std::shared_ptr<Folder>& node, response::IdType&& cursor);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	const response::IdType& getCursor() const;
+	std::shared_ptr<object::Folder> getNode() const;
+
+private:
+	const std::shared_ptr<Folder> m_node;
+	const response::IdType m_cursor;
+};
+
+class FolderConnection
+{
+public:
+	using CountLoader = std::function<int()>;
+	using PageLoader = std::function<bool(std::vector<std::shared_ptr<FolderEdge>>& edges)>;
+
+	explicit FolderConnection(CountLoader&& loadCount, PageLoader&& loadPage);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	std::vector<std::shared_ptr<object::FolderEdge>> getEdges();
+	std::shared_ptr<object::PageInfo> getPageInfo();
+	int getTotalCount();
+
+private:
+	// These are all initialized at construction.
+	const CountLoader m_loadCount;
+	const PageLoader m_loadPage;
+
+	// These lazy load and cache results between calls to the resolvers, so selecting only the
+	// totalCount never reads any rows.
+	void LoadPage();
+
+	std::optional<int> m_totalCount;
+	std::unique_ptr<std::vector<std::shared_ptr<FolderEdge>>> m_edges;
+	std::shared_ptr<PageInfo> m_pageInfo;
+};
+
+class ItemGroup
+{
+public:
+	using ItemsLoader = std::function<std::vector<std::shared_ptr<Item>>(
+		const service::Directives& fieldDirectives)>;
+
+	explicit ItemGroup(response::IdType&& id, std::shared_ptr<object::Property>&& value, int count,
+		int unread, ItemsLoader&& loadItems);
+
+	// Resolvers/Accessors which implement the GraphQL type
+	const response::IdType& getId() const;
+	std::shared_ptr<object::Property> getValue() const;
+	int getCount() const;
+	int getUnread() const;
+	std::vector<std::shared_ptr<object::Item>> getItems(service::FieldParams&& params);
+
+private:
+	// These are all initialized at construction.
+	const response::IdType m_id;
+	const std::shared_ptr<object::Property> m_value;
+	const int m_count;
+	const int m_unread;
+	const ItemsLoader m_loadItems;
+
+	// These lazy load and cache results between calls to the resolvers, so the category is only
+	// expanded if the items are selected.
+	std::unique_ptr<std::vector<std::shared_ptr<Item>>> m_items;
+	service::Directives m_itemDirectives;
+};
+
 } // namespace graphql::mapi
\ No newline at end of file
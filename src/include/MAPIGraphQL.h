@@ -13,8 +13,16 @@
 
 #include "graphqlservice/GraphQLService.h"
 
+#include "RequestArena.h"
+#include "ServiceOptions.h"
+
 namespace graphql::mapi {
 
+// Resolve each operation with a new RequestArena as the state to allocate the transient containers
+// in the resolvers from a per-operation arena.
+GQLMAPI_IMPORT std::shared_ptr<service::Request> GetService(const ServiceOptions& options) noexcept;
+
+// Same as GetService with the default ServiceOptions for everything except useDefaultProfile.
 GQLMAPI_IMPORT std::shared_ptr<service::Request> GetService(bool useDefaultProfile) noexcept;
 
 } // namespace graphql::mapi
\ No newline at end of file
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "graphqlservice/GraphQLService.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace graphql::mapi {
+
+// Pass a RequestArena as the RequestState when resolving an operation, and the resolvers allocate
+// their transient containers from it instead of the heap. Nothing is freed until the operation
+// releases the state, then the whole arena is released at once. Resolvers may run on several
+// threads with std::launch::async, so the allocations are serialized.
+class RequestArena final
+	: public service::RequestState
+	, public std::pmr::memory_resource
+{
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		std::lock_guard lock { m_mutex };
+
+		return m_arena.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void*, std::size_t, std::size_t) noexcept override
+	{
+		// Everything is released with the arena.
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	std::mutex m_mutex;
+	std::pmr::monotonic_buffer_resource m_arena;
+};
+
+// Memory for containers which only live while a resolver runs. This is the RequestArena if the
+// operation was resolved with one as its state, otherwise it's the default memory resource.
+inline std::pmr::memory_resource* GetRequestArena(
+	const service::SelectionSetParams& params) noexcept
+{
+	const auto arena = dynamic_cast<RequestArena*>(params.state.get());
+
+	return arena ? static_cast<std::pmr::memory_resource*>(arena)
+				 : std::pmr::get_default_resource();
+}
+
+} // namespace graphql::mapi
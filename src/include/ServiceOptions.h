@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace graphql::mapi {
+
+// How often the store caches found an object, missed it, or evicted one to stay within the budget.
+struct CacheCounters
+{
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+
+	CacheCounters& operator+=(const CacheCounters& rhs) noexcept
+	{
+		hits += rhs.hits;
+		misses += rhs.misses;
+		evictions += rhs.evictions;
+		return *this;
+	}
+};
+
+// Totals of the cache counters in every store which the service has loaded.
+struct CacheStats
+{
+	CacheCounters folders;
+	CacheCounters items;
+	CacheCounters fragments;
+};
+
+// Options for GetService. Each store keeps the folders and items it opened between operations, up
+// to the folderCacheBytes and itemCacheBytes budgets. With clearCaches, they are cleared at the end
+// of every operation instead. If there is a namedPropCacheDirectory, each store also saves its
+// named property mappings in a file there, so the next process can reuse them. A non-zero
+// fragmentCacheBytes lets each store reuse the resolved columns of folders and items which have not
+// changed since a previous operation, e.g. for clients which poll the same page of items. If there
+// is a cacheStats callback, it's called with the CacheStats at the end of every query or mutation.
+struct ServiceOptions
+{
+	bool useDefaultProfile = false;
+	bool clearCaches = false;
+	size_t folderCacheBytes = 4 * 1024 * 1024;
+	size_t itemCacheBytes = 16 * 1024 * 1024;
+	std::wstring namedPropCacheDirectory;
+	size_t fragmentCacheBytes = 0;
+	std::function<void(const CacheStats& stats)> cacheStats;
+};
+
+} // namespace graphql::mapi
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "CanonicalEntryIdIndex.h"
+
+using namespace graphql;
+
+using TestIndex = mapi::CanonicalEntryIdIndex<int>;
+
+static response::IdType makeEntryId(std::uint8_t flags, std::uint8_t provider, std::uint8_t suffix)
+{
+	// 4 flag bytes, a 16 byte provider UID, and a short unique suffix.
+	response::IdType result(24, provider);
+
+	std::fill(result.begin(), result.begin() + 4, flags);
+	result.back() = suffix;
+
+	return result;
+}
+
+TEST(CanonicalEntryIdIndex, MatchSameBytes)
+{
+	TestIndex index;
+	size_t comparisons = 0;
+
+	index.insert(makeEntryId(0, 1, 1), 1);
+
+	// The bytes match, so it should not need to ask the store provider.
+	const auto value = index.find(makeEntryId(0, 1, 1), [&](const auto&, const auto&) {
+		++comparisons;
+		return false;
+	});
+
+	ASSERT_TRUE(value.has_value()) << "should match the canonical entry ID";
+	EXPECT_EQ(1, *value) << "should return the value for the entry";
+	EXPECT_EQ(size_t { 0 }, comparisons) << "should not call CompareEntryIDs";
+}
+
+TEST(CanonicalEntryIdIndex, MismatchFallsBackToCompare)
+{
+	TestIndex index;
+	const auto entryId = makeEntryId(0, 1, 1);
+	const auto aliasId = makeEntryId(0, 1, 2);
+	size_t comparisons = 0;
+
+	index.insert(entryId, 1);
+
+	// The same object may have another long-term entry ID from the same provider, which only the
+	// store provider can recognize.
+	const auto value = index.find(aliasId, [&](const auto& lhs, const auto& rhs) {
+		++comparisons;
+		return lhs == aliasId && rhs == entryId;
+	});
+
+	ASSERT_TRUE(value.has_value()) << "should trust CompareEntryIDs after a mismatch";
+	EXPECT_EQ(1, *value) << "should return the value for the entry";
+	EXPECT_EQ(size_t { 1 }, comparisons) << "should compare with each entry";
+}
+
+TEST(CanonicalEntryIdIndex, ShortTermFallsBackToCompare)
+{
+	TestIndex index;
+	const auto entryId = makeEntryId(0, 1, 1);
+	const auto shortTermId = makeEntryId(0xff, 1, 1);
+	size_t comparisons = 0;
+
+	index.insert(entryId, 1);
+
+	const auto value = index.find(shortTermId, [&](const auto&, const auto&) {
+		++comparisons;
+		return true;
+	});
+
+	EXPECT_FALSE(TestIndex::canonicalize(shortTermId).has_value())
+		<< "should not canonicalize a short-term entry ID";
+	ASSERT_TRUE(value.has_value()) << "should ask CompareEntryIDs";
+	EXPECT_EQ(size_t { 1 }, comparisons) << "should compare with each entry";
+}
+
+TEST(CanonicalEntryIdIndex, NoMatch)
+{
+	TestIndex index;
+	size_t comparisons = 0;
+
+	index.insert(makeEntryId(0, 1, 1), 1);
+	index.insert(makeEntryId(0, 1, 2), 2);
+
+	const auto value = index.find(makeEntryId(0, 1, 3), [&](const auto&, const auto&) {
+		++comparisons;
+		return false;
+	});
+
+	EXPECT_FALSE(value.has_value()) << "should not match another entry ID";
+	EXPECT_EQ(size_t { 2 }, comparisons) << "should compare with every entry";
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "Cursor.h"
+
+#include <mapitags.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string_view>
+
+using namespace convert::cursor;
+
+constexpr std::array<BYTE, 4> c_instanceKey { 0x01, 0x02, 0x03, 0x04 };
+constexpr std::wstring_view c_name { L"Inbox" };
+
+SBinary getInstanceKey() noexcept
+{
+	return SBinary { static_cast<ULONG>(c_instanceKey.size()),
+		const_cast<LPBYTE>(c_instanceKey.data()) };
+}
+
+std::array<SPropValue, 2> getSortValues() noexcept
+{
+	std::array<SPropValue, 2> result {};
+
+	result[0].ulPropTag = PR_MESSAGE_DELIVERY_TIME;
+	result[0].Value.ft = FILETIME { 0x89abcdef, 0x01234567 };
+	result[1].ulPropTag = PR_DISPLAY_NAME_W;
+	result[1].Value.lpszW = const_cast<LPWSTR>(c_name.data());
+
+	return result;
+}
+
+TEST(ConvertCursor, RoundTrip)
+{
+	const auto sortValues = getSortValues();
+	const auto actual = from_cursor(
+		to_cursor(getInstanceKey(), sortValues.data(), sortValues.data() + sortValues.size()));
+
+	ASSERT_EQ(c_instanceKey.size(), actual.instanceKey.size()) << "instance key size should match";
+	EXPECT_TRUE(
+		std::equal(c_instanceKey.cbegin(), c_instanceKey.cend(), actual.instanceKey.cbegin()))
+		<< "instance key should match";
+	ASSERT_EQ(sortValues.size(), actual.sortValues.size()) << "should decode every sort value";
+	EXPECT_EQ(PR_MESSAGE_DELIVERY_TIME, actual.sortValues[0].ulPropTag) << "tag should match";
+	EXPECT_EQ(sortValues[0].Value.ft.dwLowDateTime, actual.sortValues[0].Value.ft.dwLowDateTime)
+		<< "time should match";
+	EXPECT_EQ(sortValues[0].Value.ft.dwHighDateTime, actual.sortValues[0].Value.ft.dwHighDateTime)
+		<< "time should match";
+	EXPECT_EQ(PR_DISPLAY_NAME_W, actual.sortValues[1].ulPropTag) << "tag should match";
+	EXPECT_EQ(c_name, std::wstring_view { actual.sortValues[1].Value.lpszW })
+		<< "string should match";
+}
+
+TEST(ConvertCursor, MissingSortValue)
+{
+	auto sortValues = getSortValues();
+
+	sortValues[1].ulPropTag = PROP_TAG(PT_ERROR, PROP_ID(PR_DISPLAY_NAME_W));
+	sortValues[1].Value.err = MAPI_E_NOT_FOUND;
+
+	const auto actual = from_cursor(
+		to_cursor(getInstanceKey(), sortValues.data(), sortValues.data() + sortValues.size()));
+
+	EXPECT_EQ(c_instanceKey.size(), actual.instanceKey.size()) << "should keep the instance key";
+	ASSERT_EQ(sortValues.size(), actual.sortValues.size()) << "should keep every sort value";
+	EXPECT_EQ(PR_MESSAGE_DELIVERY_TIME, actual.sortValues[0].ulPropTag) << "tag should match";
+	EXPECT_EQ(sortValues[1].ulPropTag, actual.sortValues[1].ulPropTag)
+		<< "should keep the missing value";
+}
+
+TEST(ConvertCursor, UnsupportedSortValue)
+{
+	auto sortValues = getSortValues();
+
+	sortValues[1].ulPropTag = PROP_TAG(PT_MV_UNICODE, PROP_ID(PR_DISPLAY_NAME_W));
+
+	const auto actual = from_cursor(
+		to_cursor(getInstanceKey(), sortValues.data(), sortValues.data() + sortValues.size()));
+
+	EXPECT_EQ(c_instanceKey.size(), actual.instanceKey.size()) << "should keep the instance key";
+	EXPECT_TRUE(actual.sortValues.empty()) << "should drop all of the sort values";
+}
+
+TEST(ConvertCursor, TruncatedCursor)
+{
+	const auto sortValues = getSortValues();
+	auto cursor =
+		to_cursor(getInstanceKey(), sortValues.data(), sortValues.data() + sortValues.size());
+
+	cursor.pop_back();
+
+	EXPECT_THROW(from_cursor(cursor), std::invalid_argument) << "should reject a truncated cursor";
+}
+
+TEST(ConvertCursor, UnknownVersion)
+{
+	const auto sortValues = getSortValues();
+	auto cursor =
+		to_cursor(getInstanceKey(), sortValues.data(), sortValues.data() + sortValues.size());
+
+	++cursor.front();
+
+	EXPECT_THROW(from_cursor(cursor), std::invalid_argument) << "should reject another version";
+}
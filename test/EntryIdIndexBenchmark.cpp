@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "EntryIdIndex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+
+using namespace graphql;
+
+namespace {
+
+// Entry IDs in the same store are 46 bytes long and start with the same 22 bytes of flags and
+// provider UID, so a std::map compares most of the prefix at every step of each lookup.
+std::vector<response::IdType> getEntryIds(size_t count)
+{
+	std::mt19937_64 random { count };
+	std::vector<response::IdType> result(count);
+
+	for (auto& id : result)
+	{
+		id = response::IdType(46, 0x5a);
+
+		for (size_t i = 22; i < id.size(); ++i)
+		{
+			id.data()[i] = static_cast<std::uint8_t>(random());
+		}
+	}
+
+	return result;
+}
+
+template <class Fill, class Lookup>
+void measure(const char* name, size_t count, Fill&& fill, Lookup&& lookup)
+{
+	using namespace std::chrono;
+
+	const auto start = steady_clock::now();
+
+	fill();
+
+	const auto filled = steady_clock::now();
+	const size_t found = lookup();
+	const auto finished = steady_clock::now();
+
+	std::printf("%-12s %8zu entries: insert %8.1f ns, find %8.1f ns (%zu found)\n",
+		name,
+		count,
+		duration<double, std::nano>(filled - start).count() / count,
+		duration<double, std::nano>(finished - filled).count() / count,
+		found);
+}
+
+} // namespace
+
+int main()
+{
+	for (size_t count = 1000; count <= 1000000; count *= 10)
+	{
+		const auto ids = getEntryIds(count);
+		std::map<response::IdType, size_t> map;
+		mapi::EntryIdIndex<size_t> index;
+
+		measure(
+			"std::map",
+			count,
+			[&]() {
+				for (size_t i = 0; i < ids.size(); ++i)
+				{
+					map.insert(std::make_pair(ids[i], i));
+				}
+			},
+			[&]() {
+				size_t found = 0;
+
+				for (const auto& id : ids)
+				{
+					found += map.find(id) == map.cend() ? 0 : 1;
+				}
+
+				return found;
+			});
+
+		measure(
+			"EntryIdIndex",
+			count,
+			[&]() {
+				for (size_t i = 0; i < ids.size(); ++i)
+				{
+					index.insert(ids[i], i);
+				}
+			},
+			[&]() {
+				size_t found = 0;
+
+				for (const auto& id : ids)
+				{
+					found += index.find(id) ? 1 : 0;
+				}
+
+				return found;
+			});
+	}
+
+	return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "EntryIdIndex.h"
+
+using namespace graphql;
+
+using TestIndex = mapi::EntryIdIndex<size_t>;
+
+response::IdType getEntryId(size_t value)
+{
+	// Entry IDs from the same store share a long prefix, followed by a short unique suffix.
+	response::IdType result(44, 0xab);
+
+	for (size_t i = 0; i < sizeof(value); ++i)
+	{
+		result.data()[result.size() - 1 - i] = static_cast<std::uint8_t>(value >> (8 * i));
+	}
+
+	return result;
+}
+
+TEST(EntryIdIndex, InsertAndFind)
+{
+	TestIndex index;
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_TRUE(index.insert(getEntryId(i), i)) << "should insert a new ID";
+	}
+
+	EXPECT_EQ(size_t { 1000 }, index.size()) << "should grow to hold every ID";
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		const auto value = index.find(getEntryId(i));
+
+		ASSERT_NE(nullptr, value) << "should find every ID";
+		EXPECT_EQ(i, *value) << "should find the matching value";
+	}
+
+	EXPECT_EQ(nullptr, index.find(getEntryId(1000))) << "should not find another ID";
+}
+
+TEST(EntryIdIndex, KeepFirstValue)
+{
+	TestIndex index;
+
+	EXPECT_TRUE(index.insert(getEntryId(1), 1)) << "should insert a new ID";
+	EXPECT_FALSE(index.insert(getEntryId(1), 2)) << "should not insert the same ID twice";
+	ASSERT_NE(nullptr, index.find(getEntryId(1))) << "should find the ID";
+	EXPECT_EQ(size_t { 1 }, *index.find(getEntryId(1))) << "should keep the first value";
+}
+
+TEST(EntryIdIndex, EraseKeepsProbeSequence)
+{
+	TestIndex index;
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		index.insert(getEntryId(i), i);
+	}
+
+	for (size_t i = 0; i < 1000; i += 2)
+	{
+		ASSERT_TRUE(index.erase(getEntryId(i))) << "should erase an ID in the index";
+	}
+
+	EXPECT_FALSE(index.erase(getEntryId(0))) << "should not erase the same ID twice";
+	EXPECT_EQ(size_t { 500 }, index.size()) << "should only hold the odd IDs";
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		const auto value = index.find(getEntryId(i));
+
+		if (i % 2 == 0)
+		{
+			EXPECT_EQ(nullptr, value) << "should not find an erased ID";
+		}
+		else
+		{
+			ASSERT_NE(nullptr, value) << "should still find the IDs after an erased ID";
+			EXPECT_EQ(i, *value) << "should find the matching value";
+		}
+	}
+}
+
+TEST(EntryIdIndex, CountIdBytes)
+{
+	TestIndex index;
+
+	EXPECT_EQ(size_t { 0 }, index.bytes()) << "should start empty";
+
+	index.insert(getEntryId(1), 1);
+
+	const size_t oneId = index.bytes();
+
+	EXPECT_GE(oneId, getEntryId(1).size()) << "should count the copy of the ID";
+
+	index.insert(getEntryId(2), 2);
+
+	EXPECT_EQ(oneId + getEntryId(2).size(), index.bytes()) << "should count each ID";
+
+	index.erase(getEntryId(1));
+
+	EXPECT_EQ(oneId, index.bytes()) << "should release the erased ID";
+
+	index.clear();
+
+	EXPECT_EQ(oneId - getEntryId(1).size(), index.bytes())
+		<< "should release the IDs and only keep the empty slots";
+}
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "InstanceKeyColumn.h"
+
+using namespace graphql;
+
+TEST(InstanceKeyColumn, InsertAndFind)
+{
+	mapi::InstanceKeyColumn keys;
+
+	keys.push_back(response::IdType { 1, 1 });
+	keys.push_back(response::IdType { 3, 3 });
+	keys.insert(1, response::IdType { 2, 2 });
+
+	EXPECT_EQ(size_t { 3 }, keys.size()) << "should hold every key";
+	EXPECT_EQ(size_t { 0 }, keys.find(response::IdType { 1, 1 })) << "should find the first key";
+	EXPECT_EQ(size_t { 1 }, keys.find(response::IdType { 2, 2 })) << "should find the inserted key";
+	EXPECT_EQ(size_t { 2 }, keys.find(response::IdType { 3, 3 })) << "should shift the last key";
+	EXPECT_EQ(size_t { 3 }, keys.find(response::IdType { 4, 4 })) << "should return size on a miss";
+	EXPECT_EQ(size_t { 3 }, keys.find(response::IdType { 1 })) << "should compare the key size";
+}
+
+TEST(InstanceKeyColumn, EraseAndCompact)
+{
+	mapi::InstanceKeyColumn keys;
+
+	for (std::uint8_t i = 0; i < 100; ++i)
+	{
+		keys.push_back(response::IdType { i, i, i, i });
+	}
+
+	// Erasing most of the keys compacts the buffer, which moves the offsets of the remaining keys.
+	for (std::uint8_t i = 0; i < 90; ++i)
+	{
+		keys.erase(0);
+	}
+
+	keys.pop_back();
+
+	ASSERT_EQ(size_t { 9 }, keys.size()) << "should erase the keys";
+	EXPECT_EQ(size_t { 9 }, keys.find(response::IdType { 0, 0, 0, 0 })) << "should not find it";
+	EXPECT_EQ(size_t { 9 }, keys.find(response::IdType { 99, 99, 99, 99 })) << "should not find it";
+
+	for (std::uint8_t i = 90; i < 99; ++i)
+	{
+		EXPECT_EQ(size_t { i - 90u }, keys.find(response::IdType { i, i, i, i }))
+			<< "should still find the remaining keys";
+	}
+}
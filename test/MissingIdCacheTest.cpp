@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "MissingIdCache.h"
+
+using namespace graphql;
+using namespace std::literals;
+
+using Clock = mapi::MissingIdCache::Clock;
+
+TEST(MissingIdCache, ExpireAfterLifetime)
+{
+	mapi::MissingIdCache cache { 30s, 10 };
+	const Clock::time_point start {};
+	const response::IdType id { 1 };
+
+	cache.insert(id, start);
+
+	EXPECT_TRUE(cache.contains(id, start + 29s)) << "should still be missing";
+	EXPECT_FALSE(cache.contains(response::IdType { 2 }, start)) << "should not know another ID";
+	EXPECT_FALSE(cache.contains(id, start + 30s)) << "should expire after the lifetime";
+	EXPECT_EQ(size_t { 0 }, cache.size()) << "should drop the expired ID";
+}
+
+TEST(MissingIdCache, DropOldestOverLimit)
+{
+	mapi::MissingIdCache cache { 30s, 2 };
+	const Clock::time_point start {};
+
+	cache.insert(response::IdType { 1 }, start);
+	cache.insert(response::IdType { 2 }, start);
+	cache.insert(response::IdType { 3 }, start);
+
+	EXPECT_EQ(size_t { 2 }, cache.size()) << "should stay within the limit";
+	EXPECT_FALSE(cache.contains(response::IdType { 1 }, start)) << "should drop the oldest ID";
+	EXPECT_TRUE(cache.contains(response::IdType { 3 }, start)) << "should keep the newest ID";
+}
+
+TEST(MissingIdCache, RefreshMovesToBack)
+{
+	mapi::MissingIdCache cache { 30s, 2 };
+	const Clock::time_point start {};
+
+	cache.insert(response::IdType { 1 }, start);
+	cache.insert(response::IdType { 2 }, start);
+	cache.insert(response::IdType { 1 }, start + 1s);
+	cache.insert(response::IdType { 3 }, start + 2s);
+
+	EXPECT_EQ(size_t { 2 }, cache.size()) << "should stay within the limit";
+	EXPECT_TRUE(cache.contains(response::IdType { 1 }, start + 2s))
+		<< "should keep the refreshed ID";
+	EXPECT_FALSE(cache.contains(response::IdType { 2 }, start + 2s))
+		<< "should drop the least recently refreshed ID";
+	EXPECT_TRUE(cache.contains(response::IdType { 1 }, start + 30s))
+		<< "should extend the lifetime from the refresh";
+}
+
+TEST(MissingIdCache, EraseAndReinsertWithinLimit)
+{
+	mapi::MissingIdCache cache { 30s, 2 };
+	const Clock::time_point start {};
+
+	for (int i = 0; i < 10; ++i)
+	{
+		cache.insert(response::IdType { 1 }, start);
+		cache.erase(response::IdType { 1 });
+	}
+
+	cache.insert(response::IdType { 2 }, start);
+	cache.insert(response::IdType { 3 }, start);
+
+	EXPECT_EQ(size_t { 2 }, cache.size()) << "should not keep erased IDs in the order";
+	EXPECT_TRUE(cache.contains(response::IdType { 2 }, start))
+		<< "should not drop a live ID for an erased one";
+	EXPECT_TRUE(cache.contains(response::IdType { 3 }, start)) << "should keep the newest ID";
+}
+
+TEST(MissingIdCache, EraseFoundId)
+{
+	mapi::MissingIdCache cache { 30s, 10 };
+	const Clock::time_point start {};
+	const response::IdType id { 1 };
+
+	cache.insert(id, start);
+	cache.erase(id);
+
+	EXPECT_FALSE(cache.contains(id, start)) << "should forget an ID which exists again";
+}
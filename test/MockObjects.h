@@ -10,6 +10,10 @@
 
 #include "MAPISchema.h"
 
+#include "ItemObject.h"
+
+#include "ObjectWrapper.h"
+
 namespace Mock {
 
 using namespace graphql;
@@ -157,6 +161,20 @@ public:
 		(FieldParams && params, std::optional<std::vector<response::IdType>>&& idsArg), (const));
 };
 
+// Holds an implementation object and its cached object::Item wrapper, like mapi::Item.
+class WrappedItem
+{
+public:
+	std::shared_ptr<object::Item> object()
+	{
+		return m_object.get(m_item);
+	}
+
+private:
+	const std::shared_ptr<MockItem> m_item = std::make_shared<MockItem>();
+	mapi::WrapperCache<object::Item> m_object;
+};
+
 class MockFileAttachment
 {
 public:
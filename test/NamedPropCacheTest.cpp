@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "Types.h"
+
+#include <fstream>
+
+using namespace graphql;
+
+// {00062008-0000-0000-C000-000000000046}
+constexpr GUID c_testPropset = { 0x00062008,
+	0x0000,
+	0x0000,
+	{ 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46 } };
+
+class NamedPropCacheTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// MAPIAllocateBuffer needs the MAPI subsystem.
+		if (FAILED(::MAPIInitialize(nullptr)))
+		{
+			GTEST_SKIP() << "MAPI is not installed";
+		}
+
+		m_initialized = true;
+		m_directory = std::filesystem::temp_directory_path()
+			/ ("gqlmapiTest-" + std::to_string(::GetCurrentProcessId()));
+		std::filesystem::remove_all(m_directory);
+	}
+
+	void TearDown() override
+	{
+		if (m_initialized)
+		{
+			std::error_code ec;
+
+			std::filesystem::remove_all(m_directory, ec);
+			::MAPIUninitialize();
+		}
+	}
+
+protected:
+	static mapi::mapi_ptr<MAPINAMEID> makeNamedId(LONG id)
+	{
+		mapi::mapi_ptr<MAPINAMEID> namedId;
+
+		CORt(::MAPIAllocateBuffer(sizeof(*namedId) + sizeof(*namedId->lpguid),
+			reinterpret_cast<void**>(&mapi::out_ptr { namedId })));
+
+		namedId->lpguid = reinterpret_cast<LPGUID>(namedId.get() + 1);
+		*namedId->lpguid = c_testPropset;
+		namedId->ulKind = MNID_ID;
+		namedId->Kind.lID = id;
+
+		return namedId;
+	}
+
+	static mapi::mapi_ptr<MAPINAMEID> makeNamedId(std::wstring_view name)
+	{
+		mapi::mapi_ptr<MAPINAMEID> namedId;
+
+		CORt(::MAPIAllocateBuffer(sizeof(*namedId) + sizeof(*namedId->lpguid),
+			reinterpret_cast<void**>(&mapi::out_ptr { namedId })));
+
+		namedId->lpguid = reinterpret_cast<LPGUID>(namedId.get() + 1);
+		*namedId->lpguid = c_testPropset;
+		namedId->ulKind = MNID_STRING;
+		CORt(::MAPIAllocateMore(static_cast<ULONG>((name.size() + 1) * sizeof(wchar_t)),
+			namedId.get(),
+			reinterpret_cast<void**>(&namedId->Kind.lpwstrName)));
+		std::copy(name.cbegin(), name.cend(), namedId->Kind.lpwstrName);
+		namedId->Kind.lpwstrName[name.size()] = L'\0';
+
+		return namedId;
+	}
+
+	mapi::NameIdToPropId makeMappings() const
+	{
+		mapi::NameIdToPropId result;
+
+		result.insert(std::make_pair(makeNamedId(0x8501), PROP_TAG(PT_UNSPECIFIED, 0x8001)));
+		result.insert(
+			std::make_pair(makeNamedId(L"x-test-header"), PROP_TAG(PT_UNSPECIFIED, 0x8002)));
+
+		return result;
+	}
+
+	// Write the mappings and wait for the background writer to replace the file.
+	void saveMappings(const response::IdType& signature) const
+	{
+		mapi::NamedPropCache cache { m_directory, m_storeId };
+
+		cache.load(signature);
+		cache.save(makeMappings());
+	}
+
+	std::filesystem::path cacheFile() const
+	{
+		std::vector<std::filesystem::path> files;
+
+		for (const auto& entry : std::filesystem::directory_iterator { m_directory })
+		{
+			files.push_back(entry.path());
+		}
+
+		// The temporary file should have been renamed.
+		EXPECT_EQ(size_t { 1 }, files.size()) << "should only leave the cache file";
+
+		return files.empty() ? std::filesystem::path {} : files.front();
+	}
+
+	const response::IdType m_storeId { 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04 };
+	const response::IdType m_signature { 0x10, 0x20, 0x30, 0x40 };
+	std::filesystem::path m_directory;
+	bool m_initialized = false;
+};
+
+TEST_F(NamedPropCacheTest, RoundTrip)
+{
+	saveMappings(m_signature);
+
+	mapi::NamedPropCache cache { m_directory, m_storeId };
+	const auto expected = makeMappings();
+	const auto actual = cache.load(m_signature);
+
+	ASSERT_EQ(expected.size(), actual.size()) << "should load every mapping";
+
+	for (const auto& [namedId, propId] : expected)
+	{
+		const auto itr = actual.find(namedId);
+
+		ASSERT_TRUE(itr != actual.cend()) << "should load the same named property";
+		EXPECT_EQ(propId, itr->second) << "should load the same property ID";
+	}
+
+	EXPECT_TRUE(cache.loaded()) << "should only read the file once";
+	EXPECT_TRUE(cache.load(m_signature).empty()) << "should release the file after loading it";
+}
+
+TEST_F(NamedPropCacheTest, SignatureMismatch)
+{
+	saveMappings(m_signature);
+
+	mapi::NamedPropCache cache { m_directory, m_storeId };
+
+	EXPECT_TRUE(cache.load(response::IdType { 0x50, 0x60, 0x70, 0x80 }).empty())
+		<< "should ignore a file from a store with other named property mappings";
+}
+
+TEST_F(NamedPropCacheTest, TruncatedFile)
+{
+	saveMappings(m_signature);
+
+	const auto path = cacheFile();
+
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+
+	mapi::NamedPropCache cache { m_directory, m_storeId };
+
+	EXPECT_TRUE(cache.load(m_signature).empty()) << "should ignore a truncated file";
+}
+
+TEST_F(NamedPropCacheTest, TrailingBytes)
+{
+	saveMappings(m_signature);
+
+	{
+		std::ofstream file { cacheFile(), std::ios::binary | std::ios::app };
+
+		file << "garbage";
+	}
+
+	mapi::NamedPropCache cache { m_directory, m_storeId };
+
+	EXPECT_TRUE(cache.load(m_signature).empty()) << "should ignore a file with trailing bytes";
+}
+
+TEST_F(NamedPropCacheTest, CorruptHeader)
+{
+	saveMappings(m_signature);
+
+	{
+		std::fstream file { cacheFile(), std::ios::binary | std::ios::in | std::ios::out };
+
+		// Overwrite the magic number at the beginning of the file.
+		file.seekp(0);
+		file << "XXXX";
+	}
+
+	mapi::NamedPropCache cache { m_directory, m_storeId };
+
+	EXPECT_TRUE(cache.load(m_signature).empty()) << "should ignore a file with a bad header";
+}
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "ObjectCache.h"
+
+using namespace graphql;
+
+class FakeObject
+{
+public:
+	explicit FakeObject(std::uint8_t id, size_t bytes)
+		: m_id { id }
+		, m_bytes { bytes }
+	{
+	}
+
+	const response::IdType& id() const noexcept
+	{
+		return m_id;
+	}
+
+	size_t bytes() const noexcept
+	{
+		return m_bytes;
+	}
+
+	void resize(size_t bytes) noexcept
+	{
+		m_bytes = bytes;
+	}
+
+private:
+	const response::IdType m_id;
+	size_t m_bytes;
+};
+
+using FakeCache = mapi::ObjectCache<FakeObject>;
+
+TEST(ObjectCache, HitAndMiss)
+{
+	FakeCache cache { 100 };
+	const auto object = std::make_shared<FakeObject>(1, 10);
+
+	cache.insert(object);
+
+	EXPECT_EQ(object, cache.find(object->id())) << "should find the cached object";
+	EXPECT_EQ(nullptr, cache.find(response::IdType { 2 })) << "should miss another ID";
+	EXPECT_EQ(size_t { 1 }, cache.counters().hits) << "should count the hit";
+	EXPECT_EQ(size_t { 1 }, cache.counters().misses) << "should count the miss";
+	EXPECT_EQ(size_t { 10 }, cache.bytes()) << "should account for the object";
+}
+
+TEST(ObjectCache, EvictLeastRecentlyUsed)
+{
+	FakeCache cache { 30 };
+	const auto first = std::make_shared<FakeObject>(1, 10);
+	const auto second = std::make_shared<FakeObject>(2, 10);
+	const auto third = std::make_shared<FakeObject>(3, 10);
+	const auto fourth = std::make_shared<FakeObject>(4, 10);
+
+	cache.insert(first);
+	cache.insert(second);
+	cache.insert(third);
+	ASSERT_EQ(first, cache.find(first->id())) << "should still fit in the budget";
+
+	cache.insert(fourth);
+
+	EXPECT_EQ(size_t { 1 }, cache.counters().evictions) << "should evict one object";
+	EXPECT_EQ(nullptr, cache.find(second->id())) << "should evict the least recently used";
+	EXPECT_EQ(first, cache.find(first->id())) << "should keep the object we just found";
+	EXPECT_EQ(size_t { 30 }, cache.bytes()) << "should stay within the budget";
+}
+
+TEST(ObjectCache, ReplaceAndErase)
+{
+	FakeCache cache { 100 };
+	const auto original = std::make_shared<FakeObject>(1, 10);
+	const auto replacement = std::make_shared<FakeObject>(1, 20);
+
+	cache.insert(original);
+	cache.insert(replacement);
+
+	EXPECT_EQ(size_t { 1 }, cache.size()) << "should replace the object with the same ID";
+	EXPECT_EQ(size_t { 20 }, cache.bytes()) << "should only account for the replacement";
+
+	cache.erase(replacement->id());
+
+	EXPECT_EQ(size_t { 0 }, cache.size()) << "should erase the object";
+	EXPECT_EQ(size_t { 0 }, cache.bytes()) << "should release the bytes";
+}
+
+TEST(ObjectCache, EraseByCachedId)
+{
+	FakeCache cache { 100 };
+	auto object = std::make_shared<FakeObject>(1, 10);
+	const auto& id = object->id();
+
+	cache.insert(object);
+
+	// The cache holds the only reference to the object now, so erasing it by its own id must not
+	// read the id after releasing the object.
+	object.reset();
+	cache.erase(id);
+
+	EXPECT_EQ(size_t { 0 }, cache.size()) << "should erase the object";
+	EXPECT_EQ(nullptr, cache.find(response::IdType { 1 })) << "should remove it from the index";
+}
+
+TEST(ObjectCache, SkipLargerThanBudget)
+{
+	FakeCache cache { 10 };
+
+	cache.insert(std::make_shared<FakeObject>(1, 20));
+
+	EXPECT_EQ(size_t { 0 }, cache.size()) << "should not cache an object larger than the budget";
+	EXPECT_EQ(size_t { 0 }, cache.counters().evictions) << "should not evict anything";
+}
+
+TEST(ObjectCache, UpdateAfterGrowing)
+{
+	FakeCache cache { 30 };
+	const auto first = std::make_shared<FakeObject>(1, 10);
+	const auto second = std::make_shared<FakeObject>(2, 10);
+	const auto notCached = std::make_shared<FakeObject>(2, 10);
+
+	cache.insert(first);
+	cache.insert(second);
+
+	// An object with the same ID which isn't the cached object shouldn't change the accounting.
+	notCached->resize(100);
+	cache.update(*notCached);
+
+	EXPECT_EQ(size_t { 20 }, cache.bytes()) << "should ignore objects which aren't cached";
+
+	first->resize(25);
+	cache.update(*first);
+
+	EXPECT_EQ(size_t { 25 }, cache.bytes()) << "should measure the object again";
+	EXPECT_EQ(size_t { 1 }, cache.counters().evictions) << "should evict to fit in the budget";
+	EXPECT_EQ(nullptr, cache.find(second->id())) << "should evict the other object";
+
+	first->resize(50);
+	cache.update(*first);
+
+	EXPECT_EQ(first, cache.find(first->id())) << "should not evict the updated object";
+	EXPECT_EQ(size_t { 50 }, cache.bytes()) << "should account for the whole object";
+
+	first->resize(5);
+	cache.update(*first);
+
+	EXPECT_EQ(size_t { 5 }, cache.bytes()) << "should release the bytes when it shrinks";
+}
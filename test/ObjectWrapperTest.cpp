@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "MockObjects.h"
+
+#include <thread>
+
+using namespace graphql;
+
+using namespace Mock;
+
+TEST(ObjectWrapper, ReuseWrapper)
+{
+	WrappedItem row;
+	auto first = row.object();
+
+	EXPECT_EQ(first, row.object()) << "should reuse the wrapper while it's held";
+
+	std::weak_ptr<object::Item> weakFirst { first };
+
+	first.reset();
+
+	EXPECT_TRUE(weakFirst.expired()) << "should not keep the wrapper alive";
+	EXPECT_NE(nullptr, row.object()) << "should wrap it again";
+}
+
+TEST(ObjectWrapper, ShareWrapperAcrossThreads)
+{
+	constexpr size_t c_threadCount = 8;
+	WrappedItem row;
+	std::vector<std::shared_ptr<object::Item>> wrappers(c_threadCount);
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < c_threadCount; ++i)
+	{
+		threads.emplace_back([&row, &wrappers, i]() {
+			wrappers[i] = row.object();
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const auto& wrapper : wrappers)
+	{
+		EXPECT_EQ(wrappers.front(), wrapper) << "should share one wrapper between threads";
+	}
+}
@@ -21,6 +21,8 @@
 #include "StringValueObject.h"
 #include "SubscriptionObject.h"
 
+#include "include/RequestArena.h"
+
 using namespace graphql;
 using namespace graphql::service;
 using namespace graphql::mapi;
@@ -57,6 +59,66 @@ TEST(MAPISchemaTest, QueryStoreName)
 		<< "should get the mock store name";
 }
 
+TEST(MAPISchemaTest, QueryWithRequestArena)
+{
+	auto mockQuery = std::make_shared<MockQuery>();
+	auto mockStore = std::make_shared<MockStore>();
+	std::string mockName { "mockName" };
+	EXPECT_CALL(*mockStore, getName).Times(1).WillOnce(Return(ByMove(mockName)));
+	std::vector<std::shared_ptr<object::Store>> stores { std::make_shared<object::Store>(
+		mockStore) };
+	std::pmr::memory_resource* resolverArena = nullptr;
+	EXPECT_CALL(*mockQuery, getStores)
+		.Times(1)
+		.WillOnce([&](service::FieldParams&& params,
+					  std::optional<std::vector<response::IdType>>&&) {
+			resolverArena = GetRequestArena(params);
+			return stores;
+		});
+	auto mockService = std::make_shared<Operations>(std::make_shared<object::Query>(mockQuery),
+		std::shared_ptr<object::Mutation> {},
+		std::shared_ptr<object::Subscription> {});
+	auto arena = std::make_shared<RequestArena>();
+
+	auto ast = R"gql({
+		stores {
+			name
+		}
+	})gql"_graphql;
+	auto result = response::toJSON(
+		mockService->resolve({ ast, {}, response::Value {}, std::launch::async, arena }).get());
+
+	EXPECT_EQ(R"js({"data":{"stores":[{"name":"mockName"}]}})js", result)
+		<< "should get the mock store name";
+	EXPECT_EQ(static_cast<std::pmr::memory_resource*>(arena.get()), resolverArena)
+		<< "should allocate from the RequestArena in the resolvers";
+}
+
+TEST(MAPISchemaTest, ReportCacheStats)
+{
+	std::vector<CacheStats> reported;
+	CacheOptions cacheOptions;
+	cacheOptions.cacheStats = [&reported](const CacheStats& stats) {
+		reported.push_back(stats);
+	};
+	// The Query only logs on to MAPI when it loads the stores, which __typename doesn't need.
+	auto query = std::make_shared<Query>(std::shared_ptr<Session> {}, false, cacheOptions);
+	auto service = std::make_shared<Operations>(std::make_shared<object::Query>(query),
+		std::shared_ptr<object::Mutation> {},
+		std::shared_ptr<object::Subscription> {});
+
+	auto ast = R"gql({
+		__typename
+	})gql"_graphql;
+	auto result = response::toJSON(
+		service->resolve({ ast, {}, response::Value {}, std::launch::async }).get());
+
+	EXPECT_EQ(R"js({"data":{"__typename":"Query"}})js", result) << "should resolve __typename";
+	ASSERT_EQ(size_t { 1 }, reported.size()) << "should report once at the end of the operation";
+	EXPECT_EQ(size_t { 0 }, reported.front().folders.hits) << "should not have loaded any stores";
+	EXPECT_EQ(size_t { 0 }, reported.front().items.misses) << "should not have loaded any stores";
+}
+
 TEST(MAPISchemaTest, QueryStoreEmail)
 {
 	constexpr int propertyId = 3;
@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "TableNotifications.h"
+
+using namespace graphql;
+
+// Each row only has an instance key and a value, which is enough to tell the rows apart.
+struct TestRow
+{
+	const response::IdType& instanceKey() const noexcept
+	{
+		return key;
+	}
+
+	response::IdType key;
+	LONG value = 0;
+};
+
+using TestRows = std::vector<std::shared_ptr<TestRow>>;
+
+struct Change
+{
+	mapi::RowChange change;
+	size_t index;
+	LONG value;
+
+	bool operator==(const Change& rhs) const noexcept
+	{
+		return change == rhs.change && index == rhs.index && value == rhs.value;
+	}
+};
+
+class TableNotificationsTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// A full window with rows 1, 2 and 3, which may have more rows after it.
+		for (LONG value = 1; value <= 3; ++value)
+		{
+			auto row = std::make_shared<TestRow>(TestRow { makeKey(value), value });
+
+			m_keys.push_back(row->key);
+			m_rows.push_back(std::move(row));
+		}
+
+		m_window.limit = 3;
+		m_window.truncated = true;
+	}
+
+protected:
+	static response::IdType makeKey(LONG value)
+	{
+		return response::IdType(4, static_cast<std::uint8_t>(value));
+	}
+
+	// Fill in a TABLE_NOTIFICATION which points to the key buffers in this fixture.
+	NOTIFICATION makeNotification(ULONG tableEvent, LONG value, std::optional<LONG> prior)
+	{
+		m_indexKey = makeKey(value);
+		m_priorKey = prior ? makeKey(*prior) : response::IdType {};
+
+		NOTIFICATION notification {};
+		auto& tab = notification.info.tab;
+
+		notification.ulEventType = fnevTableModified;
+		tab.ulTableEvent = tableEvent;
+		setKey(tab.propIndex, m_indexKey);
+
+		if (prior)
+		{
+			setKey(tab.propPrior, m_priorKey);
+		}
+		else
+		{
+			tab.propPrior.ulPropTag = PR_NULL;
+		}
+
+		m_columns[0] = tab.propIndex;
+		m_columns[1].ulPropTag = PR_CONTENT_COUNT;
+		m_columns[1].Value.l = value * 10;
+		tab.row.cValues = static_cast<ULONG>(std::size(m_columns));
+		tab.row.lpProps = m_columns;
+
+		return notification;
+	}
+
+	bool apply(const NOTIFICATION& notification)
+	{
+		return mapi::ApplyTableNotification(notification,
+			m_window,
+			m_rows,
+			m_keys,
+			[](const SRow& row) {
+				const auto& key = row.lpProps[0].Value.bin;
+				response::IdType instanceKey { key.lpb, key.lpb + key.cb };
+
+				return std::make_shared<TestRow>(
+					TestRow { std::move(instanceKey), row.lpProps[1].Value.l });
+			},
+			[this](mapi::RowChange change, size_t index, const std::shared_ptr<TestRow>& row) {
+				m_changes.push_back({ change, index, row->value });
+			});
+	}
+
+	// The values of the rows in the window, which should match the instance keys.
+	std::vector<LONG> values() const
+	{
+		std::vector<LONG> result;
+
+		for (size_t i = 0; i < m_rows.size(); ++i)
+		{
+			EXPECT_EQ(i, m_keys.find(m_rows[i]->key)) << "should keep the keys in the same order";
+			result.push_back(m_rows[i]->value);
+		}
+
+		return result;
+	}
+
+	mapi::TableWindow m_window;
+	TestRows m_rows;
+	mapi::InstanceKeyColumn m_keys;
+	std::vector<Change> m_changes;
+
+private:
+	static void setKey(SPropValue& prop, response::IdType& key)
+	{
+		prop.ulPropTag = PR_INSTANCE_KEY;
+		prop.Value.bin.cb = static_cast<ULONG>(key.size());
+		prop.Value.bin.lpb = reinterpret_cast<LPBYTE>(key.data());
+	}
+
+	response::IdType m_indexKey;
+	response::IdType m_priorKey;
+	SPropValue m_columns[2] {};
+};
+
+TEST_F(TableNotificationsTest, InsertAfterPrior)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_ADDED, 4, 1))) << "should apply in place";
+
+	const std::vector<Change> expected {
+		{ mapi::RowChange::Added, 1, 40 },
+		{ mapi::RowChange::Removed, 3, 3 },
+	};
+
+	EXPECT_EQ((std::vector<LONG> { 1, 40, 2 }), values()) << "should insert after the prior row";
+	EXPECT_EQ(expected, m_changes) << "should slide the last row out of the full window";
+	EXPECT_TRUE(m_window.truncated) << "should still be full";
+}
+
+TEST_F(TableNotificationsTest, InsertAtBeginning)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_ADDED, 4, std::nullopt)))
+		<< "should apply in place";
+
+	EXPECT_EQ((std::vector<LONG> { 40, 1, 2 }), values()) << "should insert the first row";
+}
+
+TEST_F(TableNotificationsTest, InsertAfterWindow)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_ADDED, 4, 3))) << "should apply in place";
+
+	EXPECT_EQ((std::vector<LONG> { 1, 2, 3 }), values()) << "should ignore rows after the window";
+	EXPECT_TRUE(m_changes.empty()) << "should not report any changes";
+}
+
+TEST_F(TableNotificationsTest, ModifyInPlace)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_MODIFIED, 2, 1))) << "should apply in place";
+
+	const std::vector<Change> expected {
+		{ mapi::RowChange::Updated, 1, 20 },
+	};
+
+	EXPECT_EQ((std::vector<LONG> { 1, 20, 3 }), values()) << "should replace the row";
+	EXPECT_EQ(expected, m_changes) << "should report an update";
+}
+
+TEST_F(TableNotificationsTest, ModifyAndMove)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_MODIFIED, 1, 2))) << "should apply in place";
+
+	const std::vector<Change> expected {
+		{ mapi::RowChange::Removed, 0, 1 },
+		{ mapi::RowChange::Added, 1, 10 },
+	};
+
+	EXPECT_EQ((std::vector<LONG> { 2, 10, 3 }), values()) << "should move the row";
+	EXPECT_EQ(expected, m_changes) << "should report a remove and an add";
+}
+
+TEST_F(TableNotificationsTest, ModifyOutOfFullWindow)
+{
+	EXPECT_FALSE(apply(makeNotification(TABLE_ROW_MODIFIED, 1, 5)))
+		<< "should reload if a row we haven't read would take its place";
+}
+
+TEST_F(TableNotificationsTest, Delete)
+{
+	m_window.truncated = false;
+
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_DELETED, 2, std::nullopt)))
+		<< "should apply in place";
+
+	const std::vector<Change> expected {
+		{ mapi::RowChange::Removed, 1, 2 },
+	};
+
+	EXPECT_EQ((std::vector<LONG> { 1, 3 }), values()) << "should remove the row";
+	EXPECT_EQ(expected, m_changes) << "should report the removed row";
+}
+
+TEST_F(TableNotificationsTest, DeleteFromFullWindow)
+{
+	EXPECT_FALSE(apply(makeNotification(TABLE_ROW_DELETED, 2, std::nullopt)))
+		<< "should reload if a row we haven't read would take its place";
+}
+
+TEST_F(TableNotificationsTest, DeleteAfterWindow)
+{
+	ASSERT_TRUE(apply(makeNotification(TABLE_ROW_DELETED, 5, std::nullopt)))
+		<< "should apply in place";
+
+	EXPECT_EQ((std::vector<LONG> { 1, 2, 3 }), values()) << "should keep every row";
+	EXPECT_TRUE(m_changes.empty()) << "should not report any changes";
+}
+
+TEST_F(TableNotificationsTest, Reload)
+{
+	EXPECT_FALSE(apply(makeNotification(TABLE_RELOAD, 1, std::nullopt)))
+		<< "should reload after TABLE_RELOAD";
+
+	m_window.limit.reset();
+
+	EXPECT_FALSE(apply(makeNotification(TABLE_ROW_ADDED, 4, 1)))
+		<< "should reload a window which doesn't start at the beginning";
+}
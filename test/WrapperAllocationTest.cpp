@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+
+#include "MockObjects.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace graphql;
+
+using namespace Mock;
+
+// Count every allocation in this test executable, so the tests can measure the difference between
+// two points. This replaces the global operator new, so it needs its own test executable.
+std::atomic_size_t g_allocations { 0 };
+
+void* operator new(std::size_t size)
+{
+	++g_allocations;
+
+	if (auto result = std::malloc(size == 0 ? 1 : size))
+	{
+		return result;
+	}
+
+	throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+TEST(WrapperAllocation, WrapCachedWindow)
+{
+	constexpr size_t c_rowCount = 50;
+	std::vector<std::shared_ptr<WrappedItem>> rows(c_rowCount);
+	std::vector<std::shared_ptr<object::Item>> held;
+
+	for (auto& row : rows)
+	{
+		row = std::make_shared<WrappedItem>();
+	}
+
+	const auto first = mapi::WrapRows(rows, held);
+	const size_t before = g_allocations;
+	const auto second = mapi::WrapRows(rows, held);
+	const size_t allocations = g_allocations - before;
+
+	EXPECT_EQ(first, second) << "should return the same wrappers";
+	EXPECT_EQ(size_t { 1 }, allocations) << "should only allocate the result vector";
+}